@@ -0,0 +1,466 @@
+/**
+ * Command-line tool computing the convex hull of a set of points.
+ * The points are read from files or from the standard input, as CSV,
+ * whitespace separated text or raw little-endian binary. The convex
+ * hull is written to the standard output (or to a file) and the
+ * duration of each phase is reported on the standard error.
+ * Run "hull_cli --help" for the list of options.
+ */
+
+#include "../hull/algorithms.hpp"
+#include "../hull/mapped_points.hpp"
+#include "../hull/pipeline.hpp"
+#include "../hull/text_parser.hpp"
+#include "../hull/wkt.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    /**
+     * Supported input formats.
+     */
+    enum class input_format { csv, text, binary };
+    
+    /**
+     * Supported output formats.
+     */
+    enum class output_format { csv, text, binary, wkt };
+    
+    /**
+     * The command-line options.
+     */
+    struct options {
+        std::string policy{"graham_scan"};
+        std::string type{"double"};
+        input_format input{input_format::csv};
+        output_format output{output_format::csv};
+        std::size_t threads{};
+        std::string output_file{};
+        std::vector<std::string> files{};
+        bool quiet{};
+        bool pipeline{};
+    };
+    
+    const char* const usage =
+        "Usage: hull_cli [options] [file...]\n"
+        "Compute the convex hull of the points read from the files (or from the\n"
+        "standard input if there is no file or if the file is \"-\").\n"
+        "\n"
+        "Options:\n"
+        "  -p, --policy NAME     graham_scan (default), monotone_chain, jarvis_march, chan\n"
+        "  -t, --type TYPE       coordinate type: double (default), float, int32\n"
+        "  -i, --input FORMAT    csv (default), text, binary\n"
+        "  -f, --format FORMAT   output format: csv (default), text, binary, wkt\n"
+        "  -j, --threads N       number of threads used to parse text input (default: all)\n"
+        "  -o, --output FILE     write the convex hull to FILE instead of the standard output\n"
+        "  -P, --pipeline        overlap reading and computing (a single input file only)\n"
+        "  -q, --quiet           do not report the duration of each phase\n"
+        "  -h, --help            print this help\n";
+    
+    /**
+     * Measure the duration of the phases and report them on the
+     * standard error.
+     */
+    class phase_timer {
+    public:
+        explicit phase_timer(bool quiet) : quiet_{quiet} {}
+        
+        /**
+         * Report the duration since the previous call (or since construction).
+         * @param phase - the name of the phase that just finished.
+         * @param details - extra information about the phase.
+         */
+        void lap(const std::string& phase, const std::string& details) {
+            const auto now = clock::now();
+            report(phase, now - last_, details);
+            last_ = now;
+        }
+        
+        /**
+         * Report the duration since construction.
+         */
+        void total() const {
+            report("total", clock::now() - start_, "");
+        }
+    
+    private:
+        using clock = std::chrono::steady_clock;
+        
+        void report(const std::string& phase, clock::duration duration, const std::string& details) const {
+            if (!quiet_) {
+                std::cerr << std::left << std::setw(6) << phase << " "
+                          << std::right << std::fixed << std::setprecision(3) << std::setw(12)
+                          << std::chrono::duration<double, std::milli>(duration).count()
+                          << " ms  " << details << "\n";
+            }
+        }
+        
+        bool quiet_;
+        clock::time_point start_{clock::now()};
+        clock::time_point last_{start_};
+    };
+    
+    /**
+     * Parse the command-line arguments.
+     * @throw std::invalid_argument - if an argument is invalid.
+     */
+    options parse_options(int argc, char** argv) {
+        options opts;
+        
+        for (int i{1}; i < argc; i++) {
+            const std::string arg = argv[i];
+            
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            
+            if (arg == "-h" || arg == "--help") {
+                std::cout << usage;
+                std::exit(EXIT_SUCCESS);
+            }
+            else if (arg == "-p" || arg == "--policy") {
+                opts.policy = value();
+            }
+            else if (arg == "-t" || arg == "--type") {
+                opts.type = value();
+            }
+            else if (arg == "-i" || arg == "--input") {
+                const auto format = value();
+                if (format == "csv") opts.input = input_format::csv;
+                else if (format == "text") opts.input = input_format::text;
+                else if (format == "binary") opts.input = input_format::binary;
+                else throw std::invalid_argument("unknown input format: " + format);
+            }
+            else if (arg == "-f" || arg == "--format") {
+                const auto format = value();
+                if (format == "csv") opts.output = output_format::csv;
+                else if (format == "text") opts.output = output_format::text;
+                else if (format == "binary") opts.output = output_format::binary;
+                else if (format == "wkt") opts.output = output_format::wkt;
+                else throw std::invalid_argument("unknown output format: " + format);
+            }
+            else if (arg == "-j" || arg == "--threads") {
+                opts.threads = static_cast<std::size_t>(std::stoul(value()));
+            }
+            else if (arg == "-o" || arg == "--output") {
+                opts.output_file = value();
+            }
+            else if (arg == "-P" || arg == "--pipeline") {
+                opts.pipeline = true;
+            }
+            else if (arg == "-q" || arg == "--quiet") {
+                opts.quiet = true;
+            }
+            else if (arg.size() > 1 && arg[0] == '-') {
+                throw std::invalid_argument("unknown option: " + arg);
+            }
+            else {
+                opts.files.push_back(arg);
+            }
+        }
+        
+        const auto policies = {"graham_scan", "monotone_chain", "jarvis_march", "chan"};
+        if (std::find(std::begin(policies), std::end(policies), opts.policy) == std::end(policies)) {
+            throw std::invalid_argument("unknown policy: " + opts.policy);
+        }
+        
+        const auto types = {"double", "float", "int32"};
+        if (std::find(std::begin(types), std::end(types), opts.type) == std::end(types)) {
+            throw std::invalid_argument("unknown coordinate type: " + opts.type);
+        }
+        
+        if (opts.files.empty()) {
+            opts.files.push_back("-");
+        }
+        
+        if (opts.pipeline && (opts.files.size() != 1 || opts.files.front() == "-")) {
+            throw std::invalid_argument("--pipeline needs a single input file");
+        }
+        
+        return opts;
+    }
+    
+    /**
+     * Read a whole stream into memory.
+     */
+    std::string read_all(std::istream& in) {
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    }
+    
+    /**
+     * Read a whole file (or the standard input for "-") into memory.
+     * @throw std::runtime_error - if the file cannot be read.
+     */
+    std::string read_file(const std::string& path) {
+        if (path == "-") {
+            return read_all(std::cin);
+        }
+        
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        return read_all(in);
+    }
+    
+    /**
+     * Parse a text file (or the standard input for "-"). Regular files
+     * are mapped and parsed in place. The malformed lines are reported
+     * on the standard error.
+     * @return - the number of malformed lines.
+     */
+    template <typename TPoint>
+    std::size_t parse_text(const std::string& path, const options& opts, std::vector<TPoint>& points) {
+        hull::io::parse_options parse_options;
+        parse_options.threads = opts.threads;
+        
+        hull::io::parse_report report;
+        if (path == "-") {
+            const auto content = read_all(std::cin);
+            report = hull::io::parse_points(content.data(), content.data() + content.size(), points, parse_options);
+        }
+        else {
+            const hull::io::mapped_file file(path);
+            file.advise(hull::io::access_pattern::sequential);
+            const auto first = reinterpret_cast<const char*>(file.data());
+            report = hull::io::parse_points(first, first + file.size(), points, parse_options);
+        }
+        
+        if (!opts.quiet) {
+            for (const auto& error: report.errors) {
+                std::cerr << (path == "-" ? "<stdin>" : path) << ":" << error.line << ": malformed line\n";
+            }
+        }
+        
+        return report.malformed;
+    }
+    
+    /**
+     * Decode a buffer of interleaved little-endian coordinates.
+     * @throw std::runtime_error - if the buffer size is not a multiple of the point size.
+     */
+    template <typename TPoint>
+    void parse_binary(const std::string& bytes, std::vector<TPoint>& points) {
+        using coordinate_type = std::decay_t<hull::coordinate_t<TPoint>>;
+        constexpr auto stride = 2 * sizeof(coordinate_type);
+        
+        if (bytes.size() % stride != 0) {
+            throw std::runtime_error("truncated binary input");
+        }
+        
+        const auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+        for (std::size_t offset{}; offset < bytes.size(); offset += stride) {
+            points.push_back(hull::make_point<TPoint>(
+                hull::io::details::load_little_endian<coordinate_type>(data + offset),
+                hull::io::details::load_little_endian<coordinate_type>(data + offset + sizeof(coordinate_type))));
+        }
+    }
+    
+    /**
+     * Compute the convex hull with the policy selected by name.
+     * @throw std::invalid_argument - if the policy is unknown.
+     */
+    template <typename TContainer1, typename TContainer2>
+    void compute(const std::string& policy, const TContainer1& points, TContainer2& convex_hull) {
+        if (policy == "graham_scan") {
+            hull::convex::compute(hull::choice::graham_scan, points, convex_hull);
+        }
+        else if (policy == "monotone_chain") {
+            hull::convex::compute(hull::choice::monotone_chain, points, convex_hull);
+        }
+        else if (policy == "jarvis_march") {
+            hull::convex::compute(hull::choice::jarvis_march, points, convex_hull);
+        }
+        else if (policy == "chan") {
+            hull::convex::compute(hull::choice::chan, points, convex_hull);
+        }
+        else {
+            throw std::invalid_argument("unknown policy: " + policy);
+        }
+    }
+    
+    /**
+     * Compute the convex hull of a file with the pipelined driver, the
+     * policy selected by name computing the partial hull of each chunk.
+     * @throw std::invalid_argument - if the policy is unknown.
+     */
+    template <typename T, typename TContainer>
+    hull::io::pipeline_stats compute_pipelined(const options& opts, TContainer& convex_hull) {
+        hull::io::pipeline_options pipeline_options;
+        pipeline_options.input = (opts.input == input_format::binary) ? hull::io::pipeline_input::binary
+                                                                       : hull::io::pipeline_input::text;
+        pipeline_options.parse_threads = opts.threads;
+        
+        hull::io::pipeline_stats stats;
+        const auto& file = opts.files.front();
+        auto out = std::back_inserter(convex_hull);
+        
+        if (opts.policy == "graham_scan") {
+            hull::io::pipelined_convex_hull<T>(file, out, hull::choice::graham_scan, pipeline_options, &stats);
+        }
+        else if (opts.policy == "monotone_chain") {
+            hull::io::pipelined_convex_hull<T>(file, out, hull::choice::monotone_chain, pipeline_options, &stats);
+        }
+        else if (opts.policy == "jarvis_march") {
+            hull::io::pipelined_convex_hull<T>(file, out, hull::choice::jarvis_march, pipeline_options, &stats);
+        }
+        else if (opts.policy == "chan") {
+            hull::io::pipelined_convex_hull<T>(file, out, hull::choice::chan, pipeline_options, &stats);
+        }
+        else {
+            throw std::invalid_argument("unknown policy: " + opts.policy);
+        }
+        
+        return stats;
+    }
+    
+    /**
+     * Write the convex hull in the requested format.
+     */
+    template <typename TPoint>
+    void write(std::ostream& out, output_format format, const std::vector<TPoint>& points) {
+        using coordinate_type = std::decay_t<hull::coordinate_t<TPoint>>;
+        
+        if (format == output_format::binary) {
+            std::vector<unsigned char> bytes(2 * sizeof(coordinate_type) * points.size());
+            auto p = bytes.data();
+            for (const auto& point: points) {
+                hull::io::details::store_little_endian<coordinate_type>(hull::x(point), p);
+                hull::io::details::store_little_endian<coordinate_type>(hull::y(point), p + sizeof(coordinate_type));
+                p += 2 * sizeof(coordinate_type);
+            }
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            return ;
+        }
+        
+        out << std::setprecision(std::numeric_limits<coordinate_type>::max_digits10);
+        
+        if (format == output_format::wkt) {
+            hull::io::write_wkt(out, std::begin(points), std::end(points));
+            return ;
+        }
+        
+        const auto separator = (format == output_format::csv) ? "," : " ";
+        for (const auto& point: points) {
+            out << hull::x(point) << separator << hull::y(point) << "\n";
+        }
+    }
+    
+    /**
+     * Run the whole command for a given coordinate type.
+     */
+    template <typename T>
+    void run(const options& opts) {
+        using point_type = std::array<T, 2>;
+        
+        phase_timer timer(opts.quiet);
+        std::vector<point_type> convex_hull;
+        
+        const auto single_binary_file = (opts.input == input_format::binary &&
+                                         opts.files.size() == 1 && opts.files.front() != "-");
+        
+        if (opts.pipeline) {
+            // Reading, parsing and computing overlap: a single phase.
+            const auto stats = compute_pipelined<T>(opts, convex_hull);
+            std::ostringstream details;
+            details << stats.points << " points in " << stats.chunks << " chunks, "
+                    << convex_hull.size() << " on the hull (busy ms:";
+            const auto stages = {"read", "parse", "prefilter", "hull", "merge"};
+            auto busy = std::begin(stats.busy);
+            for (const auto stage: stages) {
+                details << " " << stage << " " << std::fixed << std::setprecision(1) << 1000. * *busy++;
+            }
+            details << ")";
+            timer.lap("pipe", details.str());
+        }
+        else if (single_binary_file) {
+            // The file is mapped: Jarvis March reads it in place, the
+            // other policies copy it into their own working set.
+            hull::io::mapped_points<T> points(opts.files.front());
+            timer.lap("read", std::to_string(points.size()) + " points (mapped)");
+            
+            compute(opts.policy, points, convex_hull);
+            timer.lap("hull", std::to_string(convex_hull.size()) + " points (" + opts.policy + ")");
+        }
+        else {
+            std::vector<point_type> points;
+            std::size_t malformed{};
+            for (const auto& file: opts.files) {
+                if (opts.input == input_format::binary) {
+                    parse_binary(read_file(file), points);
+                }
+                else {
+                    malformed += parse_text(file, opts, points);
+                }
+            }
+            timer.lap("read", std::to_string(points.size()) + " points, " + std::to_string(malformed) + " malformed lines");
+            
+            compute(opts.policy, points, convex_hull);
+            timer.lap("hull", std::to_string(convex_hull.size()) + " points (" + opts.policy + ")");
+        }
+        
+        if (opts.output_file.empty()) {
+            write(std::cout, opts.output, convex_hull);
+            std::cout.flush();
+        }
+        else {
+            std::ofstream out(opts.output_file, std::ios::binary);
+            if (!out) {
+                throw std::runtime_error("cannot open " + opts.output_file);
+            }
+            write(out, opts.output, convex_hull);
+        }
+        timer.lap("write", opts.output_file.empty() ? "stdout" : opts.output_file);
+        
+        timer.total();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+    
+    try {
+        const auto opts = parse_options(argc, argv);
+        
+        if (opts.type == "double") {
+            run<double>(opts);
+        }
+        else if (opts.type == "float") {
+            run<float>(opts);
+        }
+        else if (opts.type == "int32") {
+            run<std::int32_t>(opts);
+        }
+        else {
+            throw std::invalid_argument("unknown coordinate type: " + opts.type);
+        }
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "hull_cli: " << e.what() << "\n" << usage;
+        return 2;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "hull_cli: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * Long-running convex hull server (see hull/service.hpp for the protocol).
+ * The server listens on a Unix domain socket until it receives SIGINT or
+ * SIGTERM, then reports its counters on the standard error.
+ * Run "hull_daemon --help" for the list of options.
+ */
+
+#include "../hull/service.hpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    const char* const usage =
+        "Usage: hull_daemon [options]\n"
+        "Serve convex hull requests on a Unix domain socket.\n"
+        "\n"
+        "Options:\n"
+        "  -s, --socket PATH     path of the socket (default: /tmp/hull.sock)\n"
+        "  -j, --threads N       number of worker threads (default: all)\n"
+        "  -m, --max-points N    maximum number of points of a request (default: 16777216)\n"
+        "  -h, --help            print this help\n";
+    
+    hull::service::server* running_server{};
+    
+    extern "C" void on_signal(int) {
+        if (running_server != nullptr) {
+            running_server->stop();
+        }
+    }
+    
+    /**
+     * Parse the command-line arguments.
+     * @throw std::invalid_argument - if an argument is invalid.
+     */
+    hull::service::server_options parse_options(int argc, char** argv) {
+        hull::service::server_options options;
+        options.path = "/tmp/hull.sock";
+        
+        for (int i{1}; i < argc; i++) {
+            const std::string arg = argv[i];
+            
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            
+            if (arg == "-h" || arg == "--help") {
+                std::cout << usage;
+                std::exit(EXIT_SUCCESS);
+            }
+            else if (arg == "-s" || arg == "--socket") {
+                options.path = value();
+            }
+            else if (arg == "-j" || arg == "--threads") {
+                options.threads = static_cast<std::size_t>(std::stoul(value()));
+            }
+            else if (arg == "-m" || arg == "--max-points") {
+                options.max_points = static_cast<std::size_t>(std::stoul(value()));
+            }
+            else {
+                throw std::invalid_argument("unknown option: " + arg);
+            }
+        }
+        
+        return options;
+    }
+    
+    /**
+     * Report the counters of each policy on the standard error.
+     */
+    void report(const hull::service::server_stats& stats) {
+        const char* const names[] = {"graham_scan", "monotone_chain", "jarvis_march", "chan"};
+        
+        std::cerr << stats.connections << " connections, " << stats.batches << " batches, "
+                  << stats.batched_requests << " requests\n";
+        for (std::size_t i{}; i < hull::service::policy_count; i++) {
+            const auto& counters = stats.policies[i];
+            std::cerr << std::left << std::setw(15) << names[i] << std::right
+                      << std::setw(10) << counters.requests << " requests "
+                      << std::setw(12) << counters.points_in << " points in "
+                      << std::setw(10) << counters.points_out << " points out  latency mean "
+                      << std::fixed << std::setprecision(1) << counters.mean_latency_ns() / 1000. << " us, max "
+                      << static_cast<double>(counters.max_latency_ns) / 1000. << " us\n";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        const auto options = parse_options(argc, argv);
+        
+        hull::service::server server(options);
+        running_server = &server;
+        std::signal(SIGINT, on_signal);
+        std::signal(SIGTERM, on_signal);
+        
+        std::cerr << "hull_daemon: listening on " << server.path() << "\n";
+        server.run();
+        
+        running_server = nullptr;
+        report(server.stats());
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "hull_daemon: " << e.what() << "\n" << usage;
+        return 2;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "hull_daemon: " << e.what() << "\n";
+        return 1;
+    }
+}
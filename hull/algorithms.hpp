@@ -22,8 +22,11 @@
 #include "chan_algorithm.hpp"
 #include "graham_scan.hpp"
 #include "jarvis_march.hpp"
+#include "melkman.hpp"
 #include "monotone_chain.hpp"
 
+#include <vector>
+
 namespace hull {
     /**
      * Policy-based approach to call one of the previous functions.
@@ -61,6 +64,25 @@ namespace hull {
         void compute(const TContainer1& c1, TContainer2& c2) {
             compute<hull::graham_scan_t>(c1, c2);
         }
+        
+        /**
+         * Container-based convex hull computation which also returns the
+         * area, the perimeter and the centroid of the convex hull, accumulated
+         * while the hull is built (see metrics.hpp).
+         * @param policy - the algorithm.
+         * @param c1 - the input container.
+         * @param c2 - the destination container.
+         * @return - the metrics of the convex hull.
+         */
+        template <typename Policy, typename TContainer1, typename TContainer2>
+        hull_metrics compute_with_metrics(Policy policy, const TContainer1& c1, TContainer2& c2) {
+            std::vector<typename TContainer2::value_type> points(std::begin(c1), std::end(c1));
+            c2.resize(2 * points.size());
+            
+            const auto result = compute_convex_hull_with_metrics(policy, std::begin(points), std::end(points), std::begin(c2));
+            c2.erase(result.last, std::end(c2));
+            return result.metrics;
+        }
     }
 }
 
@@ -145,7 +145,7 @@ namespace hull {
      * </ul>
      */
     template <typename TPoint>
-    auto cross(const TPoint& p1, const TPoint& p2, const TPoint& p3)
+    constexpr auto cross(const TPoint& p1, const TPoint& p2, const TPoint& p3)
     {
         static_assert_is_point<TPoint>();
         return (x(p2) - x(p1)) * (y(p3) - y(p1)) - (y(p2) - y(p1)) * (x(p3) - x(p1));
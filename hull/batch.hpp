@@ -0,0 +1,235 @@
+/**
+ * Convex hulls of many small point sets in a single call.
+ * Computing one hull per call pays, for every set, a function call, an
+ * allocation of the destination container and cold caches. The batch
+ * functions below take all the sets at once in the CSR layout (one flat
+ * array of points and an array of offsets) and return all the hulls in
+ * the same layout:
+ *      points      p0 p1 p2 | p3 p4 p5 p6 p7 | ...
+ *      offsets     0 3 8 ...                     (number of sets + 1 values)
+ * The sets are split into contiguous chunks holding about the same number
+ * of points, one per thread. Each thread reuses its own scratch buffers
+ * for all its sets and writes its hulls contiguously. Once the sizes of
+ * all the hulls are known, the output offsets are a prefix sum and each
+ * thread copies its hulls at their final place.
+ * The engine depends on the size of each set:
+ *      tiny sets   the fixed-size kernels of small_hull.hpp (up to 16 points)
+ *      small sets  insertion sort, then the Monotone Chain scan
+ *      medium sets Monotone Chain
+ *      large sets  Akl-Toussaint heuristic, then Monotone Chain
+ * so that every hull is in the same order as monotone_chain.
+ * Example:
+ *      <code>
+ *      std::vector<std::size_t> offsets{0, 5, 12, 30};
+ *      hull::algorithms::batch_result<point> hulls;
+ *      hull::algorithms::batch_convex_hull(points, offsets, hulls);
+ *      // The hull of the set i is [hulls.offsets[i] ; hulls.offsets[i + 1]).
+ *      </code>
+ */
+
+#ifndef batch_h
+#define batch_h
+
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "prefilter.hpp"
+#include "small_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace hull::algorithms {
+    /**
+     * Options of the batch computation.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @param small_set - the sets up to this size (and larger than the sets handled by
+     *                    the kernels of small_hull.hpp) are sorted by insertion.
+     * @param large_set - the sets from this size are prefiltered with Akl-Toussaint.
+     */
+    struct batch_options {
+        std::size_t threads{};
+        std::size_t small_set{32};
+        std::size_t large_set{64};
+    };
+    
+    /**
+     * Convex hulls of a batch, in the CSR layout: the hull of the set i
+     * is [points[offsets[i]] ; points[offsets[i + 1]]).
+     * A result may be reused from one batch to the next without allocation.
+     */
+    template <typename TPoint>
+    struct batch_result {
+        std::vector<TPoint> points;
+        std::vector<std::size_t> offsets;
+    };
+}
+
+namespace hull::algorithms::details::batch {
+    /**
+     * Buffers of a thread, reused for all its sets.
+     */
+    template <typename TPoint>
+    struct scratch {
+        std::vector<TPoint> input;
+        std::vector<TPoint> output;
+        std::vector<TPoint> hulls;
+        std::vector<std::size_t> sizes;
+    };
+    
+    /**
+     * Compute the convex hull of one set into the scratch buffers, with
+     * the engine suited to its size.
+     * @param first - the random access iterator to the first point of the set.
+     * @param last - the random access iterator to the one-past last point of the set.
+     * @param s - the scratch buffers; the hull is appended to s.hulls.
+     * @param options - the size thresholds.
+     * @return - the number of points on the convex hull.
+     */
+    template <typename RandomIt, typename TPoint>
+    std::size_t compute_one(RandomIt first, RandomIt last, scratch<TPoint>& s, const batch_options& options) {
+        const auto n = static_cast<std::size_t>(std::distance(first, last));
+        if (n <= 1) {
+            s.hulls.insert(std::end(s.hulls), first, last);
+            return n;
+        }
+        
+        s.input.clear();
+        if (n >= options.large_set) {
+            algorithms::akl_toussaint(first, last, std::back_inserter(s.input));
+        }
+        else {
+            s.input.insert(std::end(s.input), first, last);
+        }
+        
+        const auto m = s.input.size();
+        s.output.resize(2 * m);
+        auto last2 = std::begin(s.output);
+        if (m <= small::max_size && m >= 2) {
+            last2 = small::small_hull(std::begin(s.input), std::end(s.input), std::begin(s.output));
+        }
+        else if (m <= options.small_set && m >= 2) {
+            monotone::insertion_sort(std::begin(s.input), std::end(s.input));
+            std::size_t k{};
+            monotone::lower_hull(std::begin(s.input), std::end(s.input), std::begin(s.output), k);
+            monotone::upper_hull(std::begin(s.input), std::end(s.input), std::begin(s.output), k);
+            last2 += static_cast<std::ptrdiff_t>(k - 1);
+        }
+        else {
+            last2 = monotone_chain(std::begin(s.input), std::end(s.input), std::begin(s.output));
+        }
+        
+        s.hulls.insert(std::end(s.hulls), std::begin(s.output), last2);
+        return static_cast<std::size_t>(std::distance(std::begin(s.output), last2));
+    }
+}
+
+namespace hull::algorithms {
+    /**
+     * Compute the convex hulls of many point sets given in the CSR layout.
+     * The points are only read. Each hull is in the same order as
+     * monotone_chain.
+     * Average time complexity: O(N * log(M) / T) where N is the total number
+     * of points, M the size of the largest set and T the number of threads.
+     * Average space complexity: O(N).
+     * @param first - the random access iterator to the first point of the flat array.
+     * @param offsets_first - the forward iterator to the first offset (S + 1 offsets for S sets,
+     *                        non-decreasing, relative to first).
+     * @param offsets_last - the forward iterator to the one-past last offset.
+     * @param result - the destination hulls, in the CSR layout.
+     * @param options - the number of threads and the engine thresholds.
+     * @throw std::invalid_argument - if the offsets are decreasing.
+     */
+    template <
+        typename RandomIt,
+        typename ForwardIt,
+        typename TPoint = typename std::iterator_traits<RandomIt>::value_type
+    >
+    void batch_convex_hull(RandomIt first, ForwardIt offsets_first, ForwardIt offsets_last,
+                           batch_result<TPoint>& result, const batch_options& options = {})
+    {
+        static_assert_is_random_access_iterator_to_point<RandomIt>();
+        
+        const std::vector<std::size_t> offsets(offsets_first, offsets_last);
+        result.points.clear();
+        result.offsets.assign(1, 0);
+        if (offsets.size() <= 1) {
+            return ;
+        }
+        if (!std::is_sorted(std::begin(offsets), std::end(offsets))) {
+            throw std::invalid_argument("the offsets of a batch must be non-decreasing");
+        }
+        
+        // Chunks of sets with about the same number of points.
+        const auto sets = offsets.size() - 1;
+        const auto total = offsets.back() - offsets.front();
+        const auto chunks = parallel::thread_count(options.threads, sets);
+        std::vector<std::size_t> bounds(chunks + 1, sets);
+        bounds[0] = 0;
+        for (std::size_t i{1}; i < chunks; i++) {
+            const auto target = offsets.front() + total * i / chunks;
+            const auto set = std::lower_bound(std::begin(offsets), std::end(offsets) - 1, target) - std::begin(offsets);
+            bounds[i] = std::max(bounds[i - 1], static_cast<std::size_t>(set));
+        }
+        
+        // Phase 1: each thread computes the hulls of its sets into its own buffers.
+        std::vector<details::batch::scratch<TPoint>> scratches(chunks);
+        parallel::for_each_chunk(chunks, chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto chunk = begin; chunk < end; chunk++) {
+                auto& s = scratches[chunk];
+                s.sizes.reserve(bounds[chunk + 1] - bounds[chunk]);
+                for (auto set = bounds[chunk]; set < bounds[chunk + 1]; set++) {
+                    const auto size = details::batch::compute_one(first + offsets[set], first + offsets[set + 1], s, options);
+                    s.sizes.push_back(size);
+                }
+            }
+        });
+        
+        // Phase 2: the output offsets are a prefix sum of the sizes of the hulls.
+        result.offsets.resize(sets + 1);
+        std::vector<std::size_t> starts(chunks + 1);
+        std::size_t set{};
+        for (std::size_t chunk{}; chunk < chunks; chunk++) {
+            starts[chunk] = result.offsets[set];
+            for (const auto size: scratches[chunk].sizes) {
+                result.offsets[set + 1] = result.offsets[set] + size;
+                set++;
+            }
+        }
+        starts[chunks] = result.offsets[sets];
+        
+        result.points.resize(result.offsets[sets]);
+        parallel::for_each_chunk(chunks, chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto chunk = begin; chunk < end; chunk++) {
+                std::copy(std::begin(scratches[chunk].hulls), std::end(scratches[chunk].hulls),
+                          std::begin(result.points) + starts[chunk]);
+            }
+        });
+    }
+    
+    /**
+     * Container-based version of batch_convex_hull.
+     * @param points - the flat array of points.
+     * @param offsets - the S + 1 offsets of the S sets.
+     * @param result - the destination hulls, in the CSR layout.
+     * @param options - the number of threads and the engine thresholds.
+     * @throw std::invalid_argument - if the offsets are decreasing or exceed the points.
+     */
+    template <typename TContainer, typename TOffsets, typename TPoint = typename TContainer::value_type>
+    void batch_convex_hull(const TContainer& points, const TOffsets& offsets,
+                           batch_result<TPoint>& result, const batch_options& options = {})
+    {
+        if (std::begin(offsets) != std::end(offsets) &&
+            static_cast<std::size_t>(*std::prev(std::end(offsets))) > points.size())
+        {
+            throw std::invalid_argument("the offsets of a batch exceed the points");
+        }
+        batch_convex_hull(std::begin(points), std::begin(offsets), std::end(offsets), result, options);
+    }
+}
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * Bit scanning of 64-bit words, shared by the algorithms which
+ * process 64 points or pixels at a time.
+ */
+
+#ifndef bit_utils_h
+#define bit_utils_h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hull::details {
+    /**
+     * @return - the number of trailing zero bits of a non-zero word.
+     */
+    inline std::size_t countr_zero(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+        std::size_t n{};
+        for (; (word & 1) == 0; word >>= 1) {
+            n++;
+        }
+        return n;
+#endif
+    }
+    
+    /**
+     * @return - the number of leading zero bits of a non-zero word.
+     */
+    inline std::size_t countl_zero(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_clzll(word));
+#else
+        std::size_t n{};
+        for (; (word >> 63) == 0; word <<= 1) {
+            n++;
+        }
+        return n;
+#endif
+    }
+}
+
+#endif
@@ -0,0 +1,440 @@
+/**
+ * Block-indexed columnar file format for large archived point sets.
+ * The points are stored in fixed-size blocks. Each block holds a column
+ * of x coordinates followed by a column of y coordinates. A footer index
+ * gives, for each block, its position, its number of points, its bounding
+ * box and its 4 extreme points (leftmost, rightmost, bottom-most, top-most).
+ *
+ * Layout (all the values are little-endian):
+ *      header:  "HULLCOL1" | u32 coordinate type | u32 0 | u64 block capacity | u64 0
+ *      blocks:  x[0..count) | y[0..count)                              (for each block)
+ *      index:   u64 offset | u64 count | min x | min y | max x | max y
+ *               | leftmost | rightmost | bottom-most | top-most        (for each block)
+ *      trailer: u64 index offset | u64 block count | "HULLIDX1"
+ *
+ * The reader computes the convex hull without reading most of the file:
+ * the extreme points of the blocks form a provisional hull, and every block
+ * whose bounding box lies strictly inside it cannot contribute a vertex, so
+ * its pages are never touched.
+ */
+
+#ifndef block_file_h
+#define block_file_h
+
+#include "mapped_points.hpp"
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "point_in_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace hull::io::details::columnar {
+    constexpr const char header_magic[8] = {'H', 'U', 'L', 'L', 'C', 'O', 'L', '1'};
+    constexpr const char trailer_magic[8] = {'H', 'U', 'L', 'L', 'I', 'D', 'X', '1'};
+    constexpr std::size_t header_size = 32;
+    constexpr std::size_t trailer_size = 24;
+    
+    /**
+     * On-disk tag of the coordinate type.
+     */
+    template <typename T>
+    constexpr std::uint32_t type_tag() {
+        return std::is_same<T, float>::value ? 1 : std::is_same<T, double>::value ? 2 : 3;
+    }
+    
+    /**
+     * Size of an index entry: 2 u64 and 12 coordinates.
+     */
+    template <typename T>
+    constexpr std::size_t index_entry_size() {
+        return 2 * sizeof(std::uint64_t) + 12 * sizeof(T);
+    }
+}
+
+namespace hull::io {
+    /**
+     * Index entry of a block.
+     * @param offset - the offset of the x column in the file.
+     * @param count - the number of points in the block.
+     * @param min_x, min_y, max_x, max_y - the bounding box of the block.
+     * @param extremes - the leftmost, rightmost, bottom-most and top-most points,
+     *                   as interleaved coordinates.
+     */
+    template <typename T>
+    struct block_info {
+        std::uint64_t offset{};
+        std::uint64_t count{};
+        T min_x{};
+        T min_y{};
+        T max_x{};
+        T max_y{};
+        std::array<T, 8> extremes{};
+    };
+    
+    /**
+     * Statistics about a scan of a block file.
+     * @param blocks - the number of blocks in the file.
+     * @param blocks_read - the number of blocks which were actually read.
+     * @param points_read - the number of points in these blocks.
+     */
+    struct block_scan_stats {
+        std::size_t blocks{};
+        std::size_t blocks_read{};
+        std::size_t points_read{};
+    };
+    
+    /**
+     * Streaming writer of block files. Points are buffered until a
+     * block is full, then the block is written with its index entry
+     * kept in memory. The index and the trailer are written by close().
+     */
+    template <typename T>
+    class block_file_writer {
+        static_assert(details::is_binary_coordinate_v<T>(), "unsupported on-disk coordinate type");
+    
+    public:
+        /**
+         * Create (or truncate) a block file.
+         * @param path - the path to the file.
+         * @param block_capacity - the number of points per block.
+         * @throw std::system_error - if the file cannot be created.
+         */
+        explicit block_file_writer(const std::string& path, std::size_t block_capacity = 1 << 16)
+            : file_{std::fopen(path.c_str(), "wb")}, capacity_{std::max<std::size_t>(1, block_capacity)}
+        {
+            if (file_ == nullptr) {
+                throw std::system_error(errno, std::generic_category(), "cannot create " + path);
+            }
+            
+            xs_.reserve(capacity_);
+            ys_.reserve(capacity_);
+            
+            unsigned char header[details::columnar::header_size]{};
+            std::memcpy(header, details::columnar::header_magic, 8);
+            details::store_little_endian<std::uint32_t>(details::columnar::type_tag<T>(), header + 8);
+            details::store_little_endian<std::uint64_t>(capacity_, header + 16);
+            write_bytes(header, sizeof(header));
+        }
+        
+        block_file_writer(const block_file_writer&) = delete;
+        block_file_writer& operator=(const block_file_writer&) = delete;
+        
+        /**
+         * Close the file if close() was not called. Errors are ignored.
+         */
+        ~block_file_writer() {
+            if (file_ != nullptr) {
+                try {
+                    close();
+                }
+                catch (...) {
+                }
+            }
+        }
+        
+        /**
+         * Append a point.
+         */
+        void write(T x, T y) {
+            xs_.push_back(x);
+            ys_.push_back(y);
+            if (xs_.size() == capacity_) {
+                flush_block();
+            }
+        }
+        
+        /**
+         * Append a range of points.
+         * @param first - the forward iterator to the first point.
+         * @param last - the forward iterator to the one-past last point.
+         */
+        template <typename ForwardIt>
+        void write(ForwardIt first, ForwardIt last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            std::for_each(first, last, [this](const auto& p) {
+                write(static_cast<T>(x(p)), static_cast<T>(y(p)));
+            });
+        }
+        
+        /**
+         * Write the last block, the index and the trailer, then close the file.
+         * @throw std::system_error - if the file cannot be written.
+         */
+        void close() {
+            if (!xs_.empty()) {
+                flush_block();
+            }
+            
+            const auto index_offset = offset_;
+            std::vector<unsigned char> entry(details::columnar::index_entry_size<T>());
+            for (const auto& block: index_) {
+                auto p = entry.data();
+                details::store_little_endian<std::uint64_t>(block.offset, p);
+                details::store_little_endian<std::uint64_t>(block.count, p + 8);
+                p += 16;
+                for (auto value: {block.min_x, block.min_y, block.max_x, block.max_y}) {
+                    details::store_little_endian<T>(value, p);
+                    p += sizeof(T);
+                }
+                for (auto value: block.extremes) {
+                    details::store_little_endian<T>(value, p);
+                    p += sizeof(T);
+                }
+                write_bytes(entry.data(), entry.size());
+            }
+            
+            unsigned char trailer[details::columnar::trailer_size]{};
+            details::store_little_endian<std::uint64_t>(index_offset, trailer);
+            details::store_little_endian<std::uint64_t>(index_.size(), trailer + 8);
+            std::memcpy(trailer + 16, details::columnar::trailer_magic, 8);
+            write_bytes(trailer, sizeof(trailer));
+            
+            const auto result = std::fclose(file_);
+            file_ = nullptr;
+            if (result != 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot close block file");
+            }
+        }
+    
+    private:
+        void write_bytes(const unsigned char* bytes, std::size_t size) {
+            if (std::fwrite(bytes, 1, size, file_) != size) {
+                throw std::system_error(errno, std::generic_category(), "cannot write block file");
+            }
+            offset_ += size;
+        }
+        
+        void write_column(const std::vector<T>& column) {
+            std::vector<unsigned char> bytes(column.size() * sizeof(T));
+            for (std::size_t i{}; i < column.size(); i++) {
+                details::store_little_endian<T>(column[i], bytes.data() + i * sizeof(T));
+            }
+            write_bytes(bytes.data(), bytes.size());
+        }
+        
+        void flush_block() {
+            block_info<T> block;
+            block.offset = offset_;
+            block.count = xs_.size();
+            
+            // Leftmost, rightmost, bottom-most and top-most points.
+            std::size_t extremes[4]{};
+            for (std::size_t i{1}; i < xs_.size(); i++) {
+                if (xs_[i] < xs_[extremes[0]]) extremes[0] = i;
+                if (xs_[i] > xs_[extremes[1]]) extremes[1] = i;
+                if (ys_[i] < ys_[extremes[2]]) extremes[2] = i;
+                if (ys_[i] > ys_[extremes[3]]) extremes[3] = i;
+            }
+            block.min_x = xs_[extremes[0]];
+            block.max_x = xs_[extremes[1]];
+            block.min_y = ys_[extremes[2]];
+            block.max_y = ys_[extremes[3]];
+            for (std::size_t i{}; i < 4; i++) {
+                block.extremes[2 * i] = xs_[extremes[i]];
+                block.extremes[2 * i + 1] = ys_[extremes[i]];
+            }
+            
+            write_column(xs_);
+            write_column(ys_);
+            index_.push_back(block);
+            
+            xs_.clear();
+            ys_.clear();
+        }
+        
+        std::FILE* file_;
+        std::size_t capacity_;
+        std::uint64_t offset_{};
+        std::vector<T> xs_;
+        std::vector<T> ys_;
+        std::vector<block_info<T>> index_;
+    };
+    
+    /**
+     * Read-only access to a memory-mapped block file.
+     */
+    template <typename T, typename TPoint = std::array<T, 2>>
+    class block_file {
+        static_assert(details::is_binary_coordinate_v<T>(), "unsupported on-disk coordinate type");
+    
+    public:
+        /**
+         * Map a block file and load its index. The blocks themselves
+         * are not read.
+         * @param path - the path to the file.
+         * @throw std::system_error - if the file cannot be mapped.
+         * @throw std::runtime_error - if the file is not a valid block file of T.
+         */
+        explicit block_file(const std::string& path) : file_{path} {
+            static_assert_is_point<TPoint>();
+            using namespace details::columnar;
+            using details::load_little_endian;
+            
+            const auto data = file_.data();
+            const auto size = file_.size();
+            if (size < header_size + trailer_size ||
+                std::memcmp(data, header_magic, 8) != 0 ||
+                std::memcmp(data + size - 8, trailer_magic, 8) != 0)
+            {
+                throw std::runtime_error("not a block file: " + path);
+            }
+            if (load_little_endian<std::uint32_t>(data + 8) != type_tag<T>()) {
+                throw std::runtime_error("unexpected coordinate type in " + path);
+            }
+            
+            const auto trailer = data + size - trailer_size;
+            const auto index_offset = load_little_endian<std::uint64_t>(trailer);
+            const auto block_count = load_little_endian<std::uint64_t>(trailer + 8);
+            if (index_offset + block_count * index_entry_size<T>() + trailer_size != size) {
+                throw std::runtime_error("corrupted block index in " + path);
+            }
+            
+            index_.resize(block_count);
+            for (std::size_t i{}; i < block_count; i++) {
+                auto p = data + index_offset + i * index_entry_size<T>();
+                auto& block = index_[i];
+                block.offset = load_little_endian<std::uint64_t>(p);
+                block.count = load_little_endian<std::uint64_t>(p + 8);
+                p += 16;
+                block.min_x = load_little_endian<T>(p);
+                block.min_y = load_little_endian<T>(p + sizeof(T));
+                block.max_x = load_little_endian<T>(p + 2 * sizeof(T));
+                block.max_y = load_little_endian<T>(p + 3 * sizeof(T));
+                p += 4 * sizeof(T);
+                for (auto& value: block.extremes) {
+                    value = load_little_endian<T>(p);
+                    p += sizeof(T);
+                }
+                
+                if (block.offset + 2 * block.count * sizeof(T) > index_offset) {
+                    throw std::runtime_error("corrupted block index in " + path);
+                }
+                size_ += block.count;
+            }
+        }
+        
+        /**
+         * @return - the total number of points.
+         */
+        std::size_t size() const noexcept {
+            return size_;
+        }
+        
+        /**
+         * @return - the index entries of the blocks.
+         */
+        const std::vector<block_info<T>>& blocks() const noexcept {
+            return index_;
+        }
+        
+        /**
+         * Append the points of a block to a container.
+         * @param i - the index of the block.
+         * @param points - the container the points are appended to.
+         */
+        template <typename TContainer>
+        void read_block(std::size_t i, TContainer& points) const {
+            const auto& block = index_[i];
+            const auto xs = file_.data() + block.offset;
+            const auto ys = xs + block.count * sizeof(T);
+            file_.advise(access_pattern::sequential, block.offset, 2 * block.count * sizeof(T));
+            
+            for (std::size_t j{}; j < block.count; j++) {
+                points.push_back(make_point<TPoint>(details::load_little_endian<T>(xs + j * sizeof(T)),
+                                                    details::load_little_endian<T>(ys + j * sizeof(T))));
+            }
+        }
+        
+        /**
+         * Compute the convex hull of the whole file, reading only the blocks
+         * which may contribute a vertex:
+         * 1. the extreme points of all the blocks (from the index) give a
+         *    provisional hull, which is a subset of the convex hull;
+         * 2. the blocks whose bounding box lies strictly inside the provisional
+         *    hull are skipped;
+         * 3. the points of the other blocks which lie strictly inside the
+         *    provisional hull are discarded, and the policy computes the convex
+         *    hull of the survivors and the provisional hull.
+         * @param policy - the convex hull algorithm run on the survivors.
+         * @param c2 - the destination container.
+         * @return - the statistics of the scan.
+         */
+        template <typename Policy, typename TContainer2>
+        block_scan_stats convex_hull(Policy policy, TContainer2& c2) const {
+            block_scan_stats stats;
+            stats.blocks = index_.size();
+            
+            const auto provisional = provisional_hull();
+            const auto first = std::begin(provisional);
+            const auto last = std::end(provisional);
+            
+            std::vector<TPoint> survivors(first, last);
+            std::vector<TPoint> block_points;
+            for (std::size_t i{}; i < index_.size(); i++) {
+                const auto& block = index_[i];
+                if (algorithms::is_box_strictly_inside(first, last,
+                                                       make_point<TPoint>(block.min_x, block.min_y),
+                                                       make_point<TPoint>(block.max_x, block.max_y)))
+                {
+                    continue;
+                }
+                
+                block_points.clear();
+                read_block(i, block_points);
+                stats.blocks_read++;
+                stats.points_read += block.count;
+                
+                std::copy_if(std::begin(block_points), std::end(block_points), std::back_inserter(survivors), [first, last](const auto& p) {
+                    return !algorithms::is_strictly_inside(first, last, p);
+                });
+            }
+            
+            c2.clear();
+            convex::compute(policy, survivors, c2);
+            return stats;
+        }
+        
+        /**
+         * Same as above, with Monotone Chain.
+         */
+        template <typename TContainer2>
+        block_scan_stats convex_hull(TContainer2& c2) const {
+            return convex_hull(choice::monotone_chain, c2);
+        }
+    
+    private:
+        /**
+         * @return - the convex hull (counter-clockwise) of the extreme points of all the blocks.
+         */
+        std::vector<TPoint> provisional_hull() const {
+            std::vector<TPoint> extremes;
+            extremes.reserve(4 * index_.size());
+            for (const auto& block: index_) {
+                for (std::size_t i{}; i < 4; i++) {
+                    extremes.push_back(make_point<TPoint>(block.extremes[2 * i], block.extremes[2 * i + 1]));
+                }
+            }
+            
+            std::vector<TPoint> provisional;
+            convex::compute(choice::monotone_chain, extremes, provisional);
+            return provisional;
+        }
+        
+        mapped_file file_;
+        std::vector<block_info<T>> index_;
+        std::size_t size_{};
+    };
+}
+
+#endif
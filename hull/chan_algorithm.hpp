@@ -9,6 +9,7 @@
 #include "angle.hpp"
 #include "graham_scan.hpp"
 #include "jarvis_march.hpp"
+#include "metrics.hpp"
 #include "point_concept.hpp"
 #include "static_assert.hpp"
 
@@ -18,6 +19,7 @@
 #include <limits>
 #include <experimental/optional>
 #include <utility>
+#include <vector>
 
 namespace hull::algorithms::details::chan {
     /**
@@ -105,6 +107,7 @@ namespace hull::algorithms::details::chan {
      * @param lasts - random access container of iterators to the lasts elements of the partitions.
      * @param r - the number of partitions.
      * @param m - the guessed number of points on the convex hull.
+     * @param observer - the observer of the points emitted on the convex hull (see metrics.hpp).
      * @return - an optional iterator to the last element forming the convex hull of the
      *           destination container of points. This is an optional iterator because Chan's
      *           algorithm does not converge on the solution for m < h. If the merge does not
@@ -115,7 +118,8 @@ namespace hull::algorithms::details::chan {
         typename OutputIt,
         typename Partition,
         typename TPoint = typename std::iterator_traits<RandomIt>::value_type,
-        typename Lasts = std::vector<RandomIt>
+        typename Lasts = std::vector<RandomIt>,
+        typename Observer = hull::details::metrics::none
     >
     std::experimental::optional<OutputIt> merge_partitions_with_jarvis_march(RandomIt first,
                                                                              RandomIt last,
@@ -124,7 +128,8 @@ namespace hull::algorithms::details::chan {
                                                                              Partition P,
                                                                              const Lasts& lasts,
                                                                              std::size_t r,
-                                                                             std::size_t m)
+                                                                             std::size_t m,
+                                                                             Observer&& observer = Observer{})
     {
         // For k = 1 to m do:
         //     For i = 1 to r do:
@@ -138,6 +143,7 @@ namespace hull::algorithms::details::chan {
         
         for (std::size_t k{}; k < m; k++) {
             *first2++ = point_on_hull;
+            observer.push(k, point_on_hull);
             
             for (std::size_t i{}; i < r; i++) {
                 q[i] = details::jarvis::next_point_on_hull(P(i), lasts[i], point_on_hull);
@@ -168,13 +174,15 @@ namespace hull::algorithms::details {
      * @param last - the random access iterator to the one-past last point of the container.
      * @param first2 - the random access iterator to the first point of the destination container.
      * @param m - the guessed number of points on the convex hull.
+     * @param observer - the observer of the points emitted on the convex hull (see metrics.hpp).
      * @return - an optional iterator to the last element forming the convex hull of the
      *           destination container of points. This is an optional iterator because Chan's
      *           algorithm does not converge on the solution for m < H. If the merge does not
      *           converge, the returned optional is false.
      */
-    template <typename RandomIt, typename OutputIt>
-    std::experimental::optional<OutputIt> chan_impl(RandomIt first, RandomIt last, OutputIt first2, std::size_t m) {
+    template <typename RandomIt, typename OutputIt, typename Observer = hull::details::metrics::none>
+    std::experimental::optional<OutputIt> chan_impl(RandomIt first, RandomIt last, OutputIt first2, std::size_t m,
+                                                    Observer&& observer = Observer{}) {
         if (first == last) {
             return {};
         }
@@ -184,7 +192,7 @@ namespace hull::algorithms::details {
         auto lasts = chan::compute_graham_scan_for_each_partition(P, last, r);
         auto point_on_hull = *chan::get_bottom_most(first, last);
         
-        return chan::merge_partitions_with_jarvis_march(first, last, first2, point_on_hull, P, lasts, r, m);
+        return chan::merge_partitions_with_jarvis_march(first, last, first2, point_on_hull, P, lasts, r, m, observer);
     }
 }
 
@@ -199,11 +207,12 @@ namespace hull::algorithms {
      * @param first - the random access iterator to the first point of the container.
      * @param last - the random access iterator to the one-past last point of the container.
      * @param first2 - the random access iterator to the first point of the destination container.
+     * @param observer - the observer of the points emitted on the convex hull (see metrics.hpp).
      * @return - the iterator to the last element forming the convex hull of the
      *           destination container of points.
      */
-    template <typename RandomIt, typename OutputIt>
-    OutputIt chan(RandomIt first, RandomIt last, OutputIt first2) {
+    template <typename RandomIt, typename OutputIt, typename Observer = hull::details::metrics::none>
+    OutputIt chan(RandomIt first, RandomIt last, OutputIt first2, Observer&& observer = Observer{}) {
         static_assert_is_random_access_iterator_to_point<RandomIt>();
         
         if (first == last) {
@@ -216,16 +225,18 @@ namespace hull::algorithms {
         //     If L != "try again" then return L.
         using point_type = typename std::iterator_traits<RandomIt>::value_type;
         const std::size_t n = std::distance(first, last);
-        std::vector<point_type> intermediary(n);
+        std::vector<point_type> intermediary;
         
         for (std::size_t t{1}; ; t++) {
             const std::size_t pow = 1 << (1 << t); // warning: may overflow
             const auto m = std::min(pow, n);
-            const auto last_intermediary = details::chan_impl(first, last, std::begin(intermediary), m);
+            
+            // The merge emits at most m points.
+            intermediary.resize(m);
+            const auto last_intermediary = details::chan_impl(first, last, std::begin(intermediary), m, observer);
             if (last_intermediary) {
                 return std::move(std::begin(intermediary), *last_intermediary, first2);
             }
-            intermediary.clear();
         }
     }
 }
@@ -262,6 +273,22 @@ namespace hull {
         return algorithms::chan(first, last, first2);
     }
     
+    /**
+     * Same as compute_convex_hull for Chan, which also returns the
+     * metrics of the convex hull, accumulated during the final merge.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull, and its metrics.
+     */
+    template <typename RandomIt, typename OutputIt>
+    hull_result<OutputIt> compute_convex_hull_with_metrics(chan_t policy, RandomIt first, RandomIt last, OutputIt first2) {
+        // The merge never pops a point: the hull is the last pushed stack.
+        details::metrics::accumulator<> metrics;
+        const auto last2 = algorithms::chan(first, last, first2, metrics);
+        return {last2, metrics.result(metrics.size())};
+    }
+    
     namespace convex {
         /**
          * Overload of container-based convex hull computation for Chan.
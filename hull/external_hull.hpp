@@ -0,0 +1,464 @@
+/**
+ * Out-of-core convex hull for flat binary point files larger than
+ * the available memory (see mapped_points.hpp for the file layout).
+ *
+ * The file is read sequentially, one chunk at a time. Only a candidate
+ * hull, which is the convex hull of all the points read so far, is kept
+ * between chunks. For each chunk:
+ * 1. the points strictly inside the candidate hull are discarded;
+ * 2. the Akl-Toussaint heuristic discards most of the remaining points;
+ * 3. the candidate hull is recomputed from itself and the survivors.
+ * The memory is O(C + H) where C is the size of a chunk and H the number
+ * of points on the convex hull.
+ *
+ * When the candidate hull itself no longer fits in the memory budget, the
+ * survivors of each chunk are sorted and spilled as a run, appended to a
+ * single temporary file. The runs are merged at the end, at most max_fan_in
+ * at a time (in several passes through a second temporary file if there
+ * are more runs), and the last merge feeds a streaming Monotone Chain.
+ */
+
+#ifndef external_hull_h
+#define external_hull_h
+
+#include "mapped_points.hpp"
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "point_in_hull.hpp"
+#include "prefilter.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hull::io {
+    /**
+     * Options of the out-of-core convex hull.
+     * @param memory_budget - the peak memory used for points, in bytes (the
+     *                        convex hull being built by the last merge aside).
+     * @param max_fan_in - the maximum number of runs merged at a time.
+     */
+    struct external_options {
+        std::size_t memory_budget{std::size_t{1} << 30};
+        std::size_t max_fan_in{64};
+    };
+    
+    /**
+     * Statistics of an out-of-core convex hull computation.
+     * @param points - the number of points in the file.
+     * @param chunks - the number of chunks read.
+     * @param survivors - the number of points which survived the filters.
+     * @param runs - the number of sorted runs spilled to disk (0 if everything fitted).
+     * @param merge_passes - the number of passes over the spilled points.
+     */
+    struct external_stats {
+        std::size_t points{};
+        std::size_t chunks{};
+        std::size_t survivors{};
+        std::size_t runs{};
+        std::size_t merge_passes{};
+    };
+}
+
+namespace hull::io::details::external {
+    /**
+     * Sequential reader of a file of interleaved little-endian coordinates.
+     */
+    template <typename T, typename TPoint>
+    class chunk_reader {
+    public:
+        explicit chunk_reader(const std::string& path) : fd_{::open(path.c_str(), O_RDONLY | O_CLOEXEC)} {
+            if (fd_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        }
+        
+        chunk_reader(const chunk_reader&) = delete;
+        chunk_reader& operator=(const chunk_reader&) = delete;
+        
+        ~chunk_reader() {
+            ::close(fd_);
+        }
+        
+        /**
+         * Read the next chunk of points.
+         * @param bytes - the buffer for the raw bytes; its size is the chunk size.
+         * @param points - the decoded points (cleared first).
+         * @return - false at the end of the file.
+         * @throw std::runtime_error - if the file ends with a partial point.
+         */
+        bool read(std::vector<unsigned char>& bytes, std::vector<TPoint>& points) {
+            constexpr auto stride = 2 * sizeof(T);
+            
+            auto size = pending_;
+            while (size < bytes.size()) {
+                const auto n = ::read(fd_, bytes.data() + size, bytes.size() - size);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "cannot read point file");
+                }
+                if (n == 0) {
+                    break;
+                }
+                size += static_cast<std::size_t>(n);
+            }
+            
+            const auto usable = size - size % stride;
+            if (usable == 0) {
+                if (size != 0) {
+                    throw std::runtime_error("truncated point file");
+                }
+                return false;
+            }
+            
+            points.clear();
+            for (std::size_t offset{}; offset < usable; offset += stride) {
+                points.push_back(make_point<TPoint>(load_little_endian<T>(bytes.data() + offset),
+                                                    load_little_endian<T>(bytes.data() + offset + sizeof(T))));
+            }
+            
+            // Keep the partial point for the next chunk.
+            pending_ = size - usable;
+            std::copy(bytes.data() + usable, bytes.data() + size, bytes.data());
+            return true;
+        }
+    
+    private:
+        int fd_;
+        std::size_t pending_{};
+    };
+    
+    /**
+     * Run of sorted points in a spill file: [begin ; end) in points.
+     */
+    struct run {
+        std::size_t begin{};
+        std::size_t end{};
+    };
+    
+    /**
+     * Anonymous temporary file holding sorted runs one after the other, in
+     * the host byte order: a single file descriptor for any number of runs.
+     */
+    template <typename T, typename TPoint>
+    class spill_file {
+    public:
+        spill_file() : file_{std::tmpfile(), &std::fclose} {
+            if (!file_) {
+                throw std::system_error(errno, std::generic_category(), "cannot create a temporary spill file");
+            }
+        }
+        
+        /**
+         * Append points at the end of the file, through a small fixed buffer.
+         * @return - the points written, which extend the previous ones.
+         */
+        template <typename ForwardIt>
+        run append(ForwardIt first, ForwardIt last) {
+            const run written{size_, size_ + static_cast<std::size_t>(std::distance(first, last))};
+            std::array<T, 2 * block_points> coordinates;
+            while (first != last) {
+                std::size_t n{};
+                for (; first != last && n < coordinates.size(); ++first) {
+                    coordinates[n++] = x(*first);
+                    coordinates[n++] = y(*first);
+                }
+                transfer(::pwrite, coordinates.data(), n, size_, "cannot write a temporary spill file");
+                size_ += n / 2;
+            }
+            return written;
+        }
+        
+        /**
+         * Read count points from the given point offset.
+         */
+        void read(std::size_t offset, T* coordinates, std::size_t count) const {
+            transfer(::pread, coordinates, 2 * count, offset, "cannot read a temporary spill file");
+        }
+        
+        /**
+         * Remove all the runs.
+         */
+        void clear() {
+            if (::ftruncate(::fileno(file_.get()), 0) != 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot truncate a temporary spill file");
+            }
+            size_ = 0;
+        }
+    
+    private:
+        static constexpr std::size_t block_points = 512;
+        
+        template <typename Transfer, typename Pointer>
+        void transfer(Transfer f, Pointer coordinates, std::size_t count, std::size_t offset, const char* message) const {
+            auto bytes = count * sizeof(T);
+            auto p = reinterpret_cast<std::conditional_t<std::is_const_v<std::remove_pointer_t<Pointer>>,
+                                                         const unsigned char*, unsigned char*>>(coordinates);
+            auto position = static_cast<off_t>(offset * 2 * sizeof(T));
+            while (bytes != 0) {
+                const auto n = f(::fileno(file_.get()), p, bytes, position);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    throw std::system_error(n < 0 ? errno : EIO, std::generic_category(), message);
+                }
+                p += n;
+                bytes -= static_cast<std::size_t>(n);
+                position += n;
+            }
+        }
+        
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file_;
+        std::size_t size_{};
+    };
+    
+    /**
+     * Sequential reader of a run, through a buffer.
+     */
+    template <typename T, typename TPoint>
+    class run_reader {
+    public:
+        run_reader(const spill_file<T, TPoint>& file, run r, std::size_t buffer_points) :
+            file_{&file}, run_{r}, buffer_(2 * std::max<std::size_t>(1, buffer_points)) {}
+        
+        /**
+         * Read the next point of the run.
+         * @return - false at the end of the run.
+         */
+        bool next(TPoint& p) {
+            if (position_ == size_) {
+                const auto count = std::min(buffer_.size() / 2, run_.end - run_.begin);
+                if (count == 0) {
+                    return false;
+                }
+                file_->read(run_.begin, buffer_.data(), count);
+                run_.begin += count;
+                position_ = 0;
+                size_ = 2 * count;
+            }
+            p = make_point<TPoint>(buffer_[position_], buffer_[position_ + 1]);
+            position_ += 2;
+            return true;
+        }
+    
+    private:
+        const spill_file<T, TPoint>* file_;
+        run run_;
+        std::vector<T> buffer_;
+        std::size_t position_{};
+        std::size_t size_{};
+    };
+    
+    /**
+     * Merge sorted runs of a spill file with a heap.
+     * @param sink - called with each point, in the order of lexicographic_less.
+     */
+    template <typename T, typename TPoint, typename Sink>
+    void merge(const spill_file<T, TPoint>& file, const std::vector<run>& runs, std::size_t buffer_points, Sink sink) {
+        std::vector<run_reader<T, TPoint>> readers;
+        readers.reserve(runs.size());
+        
+        using entry = std::pair<TPoint, std::size_t>;
+        auto greater = [](const entry& a, const entry& b) {
+            return algorithms::details::monotone::lexicographic_less{}(b.first, a.first);
+        };
+        std::priority_queue<entry, std::vector<entry>, decltype(greater)> heap(greater);
+        
+        for (std::size_t i{}; i < runs.size(); i++) {
+            readers.emplace_back(file, runs[i], buffer_points);
+            TPoint p;
+            if (readers[i].next(p)) {
+                heap.emplace(p, i);
+            }
+        }
+        
+        while (!heap.empty()) {
+            auto [p, i] = heap.top();
+            heap.pop();
+            sink(p);
+            if (readers[i].next(p)) {
+                heap.emplace(p, i);
+            }
+        }
+    }
+    
+    /**
+     * Merge the sorted runs and feed the streaming Monotone Chain. While there
+     * are more than max_fan_in runs, groups of max_fan_in runs are merged into
+     * single runs of a second spill file, which then takes the place of the first.
+     * The memory budget is shared between the buffers of the runs merged at a time
+     * and the buffer of the merged run.
+     * @return - the iterator to the one-past last point of the convex hull.
+     */
+    template <typename T, typename TPoint, typename OutputIt>
+    OutputIt merge_runs(spill_file<T, TPoint>& file, std::vector<run> runs, const external_options& options,
+                        external_stats& stats, OutputIt first2)
+    {
+        const auto fan_in = std::max<std::size_t>(2, options.max_fan_in);
+        const auto point_size = std::max(2 * sizeof(T), sizeof(TPoint)) + sizeof(std::pair<TPoint, std::size_t>);
+        const auto buffer_points = std::max<std::size_t>(64, options.memory_budget / ((fan_in + 1) * point_size));
+        
+        spill_file<T, TPoint> other;
+        std::vector<TPoint> output;
+        output.reserve(buffer_points);
+        while (runs.size() > fan_in) {
+            other.clear();
+            std::vector<run> merged;
+            for (std::size_t i{}; i < runs.size(); i += fan_in) {
+                const std::vector<run> group(std::begin(runs) + static_cast<std::ptrdiff_t>(i),
+                                             std::begin(runs) + static_cast<std::ptrdiff_t>(std::min(i + fan_in, runs.size())));
+                run r{other.append(std::begin(output), std::begin(output))};
+                merge(file, group, buffer_points, [&](const TPoint& p) {
+                    output.push_back(p);
+                    if (output.size() == buffer_points) {
+                        r.end = other.append(std::begin(output), std::end(output)).end;
+                        output.clear();
+                    }
+                });
+                r.end = other.append(std::begin(output), std::end(output)).end;
+                output.clear();
+                merged.push_back(r);
+            }
+            std::swap(file, other);
+            runs = std::move(merged);
+            stats.merge_passes++;
+        }
+        output.clear();
+        output.shrink_to_fit();
+        
+        algorithms::details::monotone::chain_builder<TPoint> chain;
+        merge(file, runs, buffer_points, [&chain](const TPoint& p) { chain.push(p); });
+        stats.merge_passes++;
+        return chain.copy(first2);
+    }
+}
+
+namespace hull::io {
+    /**
+     * Compute the convex hull of a flat binary file of points without
+     * loading the file in memory (see the description at the top of this file).
+     * The output is in the same order as monotone_chain.
+     * Average time complexity: O(N * log(H)) where N is the number of points
+     * and H the number of points on the convex hull, with a single sequential
+     * pass over the file.
+     * Average space complexity: O(C + H) where C is the chunk size, derived
+     * from the memory budget.
+     * @param path - the path to the file.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @param options - the memory budget.
+     * @param stats - if not null, filled with statistics about the computation.
+     * @return - the iterator to the one-past last point of the convex hull.
+     * @throw std::system_error - if the file cannot be read.
+     * @throw std::runtime_error - if the file ends with a partial point.
+     */
+    template <typename T, typename TPoint = std::array<T, 2>, typename OutputIt>
+    OutputIt external_convex_hull(const std::string& path, OutputIt first2,
+                                  const external_options& options = {}, external_stats* stats = nullptr)
+    {
+        static_assert(details::is_binary_coordinate_v<T>(), "unsupported on-disk coordinate type");
+        static_assert_is_point<TPoint>();
+        
+        // The budget is shared between the raw chunk and the decoded chunk (C
+        // points each), the survivors (C + M points, M being the size of the
+        // candidate hull) and the output buffer of the candidate hull (2 * (C + M)
+        // points): 5 * C + 3 * M points in all.
+        const auto point_size = std::max(2 * sizeof(T), sizeof(TPoint));
+        const auto chunk_points = std::max<std::size_t>(1024, options.memory_budget / (8 * point_size));
+        const auto max_candidate = std::max<std::size_t>(16, options.memory_budget / (8 * point_size));
+        
+        details::external::chunk_reader<T, TPoint> reader(path);
+        std::vector<unsigned char> bytes(chunk_points * 2 * sizeof(T));
+        std::vector<TPoint> chunk;
+        std::vector<TPoint> survivors;
+        std::vector<TPoint> candidate;
+        details::external::spill_file<T, TPoint> spill;
+        std::vector<details::external::run> runs;
+        
+        external_stats local_stats;
+        while (reader.read(bytes, chunk)) {
+            local_stats.points += chunk.size();
+            local_stats.chunks++;
+            
+            // Discard the points inside the candidate hull, then those
+            // inside the Akl-Toussaint octagon of the chunk.
+            const auto first = std::begin(candidate);
+            const auto last = std::end(candidate);
+            const auto outside = std::remove_if(std::begin(chunk), std::end(chunk), [first, last](const auto& p) {
+                return algorithms::is_strictly_inside(first, last, p);
+            });
+            
+            survivors.clear();
+            algorithms::akl_toussaint(std::begin(chunk), outside, std::back_inserter(survivors));
+            local_stats.survivors += survivors.size();
+            
+            if (runs.empty()) {
+                // Running hull pruning: the new candidate is the hull of
+                // the old one and the survivors.
+                survivors.insert(std::end(survivors), std::begin(candidate), std::end(candidate));
+                candidate.resize(2 * survivors.size());
+                const auto candidate_last = algorithms::monotone_chain(std::begin(survivors), std::end(survivors), std::begin(candidate));
+                candidate.erase(candidate_last, std::end(candidate));
+                
+                if (candidate.size() > max_candidate) {
+                    // The candidate hull no longer fits: spill it as the first
+                    // run and only keep its Akl-Toussaint octagon as a filter.
+                    auto octagon = algorithms::details::akl_toussaint::octagon(std::begin(candidate), std::end(candidate));
+                    algorithms::details::monotone::sort(std::begin(candidate), std::end(candidate));
+                    runs.push_back(spill.append(std::begin(candidate), std::end(candidate)));
+                    candidate = std::move(octagon);
+                }
+            }
+            else {
+                // External mode: the survivors are spilled as a sorted run.
+                algorithms::details::monotone::sort(std::begin(survivors), std::end(survivors));
+                runs.push_back(spill.append(std::begin(survivors), std::end(survivors)));
+            }
+        }
+        
+        local_stats.runs = runs.size();
+        if (runs.empty()) {
+            if (stats != nullptr) {
+                *stats = local_stats;
+            }
+            return std::copy(std::begin(candidate), std::end(candidate), first2);
+        }
+        
+        candidate.clear();
+        candidate.shrink_to_fit();
+        survivors.clear();
+        survivors.shrink_to_fit();
+        chunk.clear();
+        chunk.shrink_to_fit();
+        bytes.clear();
+        bytes.shrink_to_fit();
+        
+        first2 = details::external::merge_runs(spill, std::move(runs), options, local_stats, first2);
+        if (stats != nullptr) {
+            *stats = local_stats;
+        }
+        return first2;
+    }
+}
+
+#endif
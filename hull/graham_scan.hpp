@@ -7,6 +7,7 @@
 #define graham_scan_h
 
 #include "angle.hpp"
+#include "metrics.hpp"
 #include "point_concept.hpp"
 #include "static_assert.hpp"
 
@@ -55,14 +56,16 @@ namespace hull::algorithms::details::graham {
      * @param first - iterator to the first point of the container.
      * @param last - iterator to the one-past last point of the container.
      * @param points - accessor to the ith point (with points[0] == points[N]).
+     * @param observer - the observer of the pushes on the convex hull (see metrics.hpp).
      * @return - the number of points on the convex hull.
      */
-    template <typename RandomIt, typename Points>
-    std::size_t scan(RandomIt first, RandomIt last, Points points) {
+    template <typename RandomIt, typename Points, typename Observer = hull::details::metrics::none>
+    std::size_t scan(RandomIt first, RandomIt last, Points points, Observer&& observer = Observer{}) {
         const auto N = std::distance(first, last);
         
         // M will denote the number of points on the convex hull. Let M = 1.
         std::size_t M{1};
+        observer.push(0, *points(1));
         
         // for i = 2 to N:
         for (std::size_t i{2}; i <= N; i++) {
@@ -83,6 +86,7 @@ namespace hull::algorithms::details::graham {
             
             // Update M and swap points[i] to the correct place.
             M++;
+            observer.push(M - 1, *points(i));
             
             // swap points[M] with points[i]
             std::swap(*points(M), *points(i));
@@ -127,17 +131,20 @@ namespace hull::algorithms::details {
      * of points. This selection occurs in-place.
      * @param first - the random access iterator to the first point of the container.
      * @param last - the random access iterator to the one-past last point of the container.
+     * @param observer - the observer of the pushes on the convex hull (see metrics.hpp).
      * @return - the iterator to the last element forming the convex hull of the
      *           provided container of points.
      */
-    template <typename RandomIt>
-    RandomIt perform_graham_scan(RandomIt first, RandomIt last) {
+    template <typename RandomIt, typename Observer = hull::details::metrics::none>
+    RandomIt perform_graham_scan(RandomIt first, RandomIt last, Observer&& observer = Observer{}) {
         if (graham::is_too_small(first, last)) {
+            std::size_t k{};
+            std::for_each(first, last, [&k, &observer](const auto& p) { observer.push(k++, p); });
             return last;
         }
         
         auto points = graham::points(first, last);
-        const auto M = graham::scan(first, last, points);
+        const auto M = graham::scan(first, last, points, observer);
         
         return first + M;
     }
@@ -203,6 +210,26 @@ namespace hull {
         return std::copy(first, new_last, first2);
     }
     
+    /**
+     * Same as compute_convex_hull for Graham Scan, which also returns
+     * the metrics of the convex hull, accumulated during the scan.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull, and its metrics.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    hull_result<RandomIt2> compute_convex_hull_with_metrics(graham_scan_t policy, RandomIt1 first, RandomIt1 last, RandomIt2 first2) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        
+        // The stack is the beginning of the input (see graham::points).
+        details::metrics::accumulator metrics([first](std::size_t k) { return *(first + k); });
+        algorithms::details::sort_by_polar_angles(first, last);
+        auto new_last = algorithms::details::perform_graham_scan(first, last, metrics);
+        
+        return {std::copy(first, new_last, first2), metrics.result(static_cast<std::size_t>(std::distance(first, new_last)))};
+    }
+    
     namespace convex {
         /**
          * Overload of container-based convex hull computation for Graham Scan.
@@ -0,0 +1,197 @@
+/**
+ * Convex hull of each group of a keyed point set, in one pass:
+ *      SELECT key, CONVEX_HULL(point) GROUP BY key
+ * The keys arrive in any order: the rows do not need to be sorted or
+ * bucketed by key first.
+ * 1. the rows are split into contiguous chunks, one per thread. Each
+ *    thread keeps, for each key, a running hull followed by the pending
+ *    points. A point strictly inside the running hull is discarded at once
+ *    in O(log(H)). When the pending points outnumber the hull, they are
+ *    reduced with Monotone Chain. The memory is then proportional to the
+ *    sizes of the hulls, not to the number of rows;
+ * 2. the keys are hash-partitioned into one partition per thread, so that
+ *    each thread merges, without lock, the partial hulls of its own keys
+ *    coming from all the threads (see hull_merge.hpp).
+ * Example:
+ *      <code>
+ *      // keys[i] is the key of points[i].
+ *      auto hulls = hull::algorithms::group_convex_hull(std::begin(keys), std::end(keys), std::begin(points));
+ *      for (const auto& [key, convex_hull]: hulls) { ... }
+ *      </code>
+ */
+
+#ifndef group_by_h
+#define group_by_h
+
+#include "hull_merge.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "point_in_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+namespace hull::algorithms {
+    /**
+     * Options of the group-by computation.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @param min_pending - the minimum number of pending points of a key before
+     *                      they are reduced (they are also reduced whenever they
+     *                      outnumber the running hull).
+     */
+    struct group_options {
+        std::size_t threads{};
+        std::size_t min_pending{32};
+    };
+}
+
+namespace hull::algorithms::details::group_by {
+    /**
+     * Running state of a key in a thread: the first hull_size points
+     * are the running hull (in the same order as monotone_chain), the
+     * other ones are pending.
+     */
+    template <typename TPoint>
+    struct group {
+        std::vector<TPoint> points;
+        std::size_t hull_size{};
+    };
+    
+    /**
+     * Replace the running hull and the pending points of a group by
+     * their convex hull.
+     * @param g - the group.
+     * @param output - a scratch buffer.
+     */
+    template <typename TPoint>
+    void reduce(group<TPoint>& g, std::vector<TPoint>& output) {
+        output.resize(2 * g.points.size());
+        output.erase(monotone_chain(std::begin(g.points), std::end(g.points), std::begin(output)), std::end(output));
+        g.points.assign(std::begin(output), std::end(output));
+        g.hull_size = g.points.size();
+    }
+    
+    /**
+     * Add a point to a group, unless it is strictly inside the running hull.
+     * @param g - the group.
+     * @param p - the point.
+     * @param output - a scratch buffer.
+     * @param min_pending - the minimum number of pending points before a reduction.
+     */
+    template <typename TPoint>
+    void add(group<TPoint>& g, const TPoint& p, std::vector<TPoint>& output, std::size_t min_pending) {
+        const auto first = std::begin(g.points);
+        if (is_strictly_inside(first, first + static_cast<std::ptrdiff_t>(g.hull_size), p)) {
+            return ;
+        }
+        
+        g.points.push_back(p);
+        const auto pending = g.points.size() - g.hull_size;
+        if (pending >= std::max(min_pending, g.hull_size)) {
+            reduce(g, output);
+        }
+    }
+    
+    /**
+     * Partition of a key: the hash is mixed, since std::hash is
+     * the identity for the integers.
+     */
+    inline std::size_t partition_of(std::size_t hash, std::size_t partitions) {
+        const auto mixed = static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+        return static_cast<std::size_t>((mixed >> 32) % partitions);
+    }
+}
+
+namespace hull::algorithms {
+    /**
+     * Compute the convex hull of the points of each key.
+     * Each hull is in the same order as monotone_chain.
+     * Average time complexity: O(N * log(H) / T + K * H * log(T)) where N is
+     * the number of points, K the number of keys, H the size of a hull and
+     * T the number of threads.
+     * Average space complexity: O(T * K * H).
+     * @param first - the random access iterator to the key of the first point.
+     * @param last - the random access iterator to the key of the one-past last point.
+     * @param first2 - the random access iterator to the first point (the point of the key *first).
+     * @param options - the number of threads and the reduction threshold.
+     * @param hash - the hash function of the keys.
+     * @return - the convex hull of each key.
+     */
+    template <
+        typename RandomIt1,
+        typename RandomIt2,
+        typename TKey = typename std::iterator_traits<RandomIt1>::value_type,
+        typename TPoint = typename std::iterator_traits<RandomIt2>::value_type,
+        typename Hash = std::hash<TKey>
+    >
+    std::unordered_map<TKey, std::vector<TPoint>, Hash> group_convex_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2,
+                                                                          const group_options& options = {},
+                                                                          const Hash& hash = Hash{})
+    {
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        using groups = std::unordered_map<TKey, details::group_by::group<TPoint>, Hash>;
+        
+        const auto N = static_cast<std::size_t>(std::distance(first, last));
+        const auto threads = parallel::thread_count(options.threads, N);
+        
+        // Phase 1: running hulls of the chunk of each thread, already split
+        // into the partitions of phase 2.
+        std::vector<std::vector<groups>> partials(threads, std::vector<groups>(threads, groups(0, hash)));
+        parallel::for_each_chunk(N, threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            auto& partitions = partials[chunk];
+            std::vector<TPoint> output;
+            for (auto i = begin; i < end; i++) {
+                const auto& key = *(first + static_cast<std::ptrdiff_t>(i));
+                const auto partition = details::group_by::partition_of(hash(key), threads);
+                auto& g = partitions[partition][key];
+                details::group_by::add(g, static_cast<TPoint>(*(first2 + static_cast<std::ptrdiff_t>(i))), output, options.min_pending);
+            }
+            for (auto& partition: partitions) {
+                for (auto& [key, g]: partition) {
+                    if (g.points.size() > g.hull_size) {
+                        details::group_by::reduce(g, output);
+                    }
+                    g.points.shrink_to_fit();
+                }
+            }
+        });
+        
+        // Phase 2: each thread merges the partial hulls of the keys of its partition.
+        std::vector<std::unordered_map<TKey, std::vector<TPoint>, Hash>> merged(threads, std::unordered_map<TKey, std::vector<TPoint>, Hash>(0, hash));
+        parallel::for_each_chunk(threads, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto partition = begin; partition < end; partition++) {
+                auto& result = merged[partition];
+                for (auto& chunk: partials) {
+                    for (auto& [key, g]: chunk[partition]) {
+                        auto [it, inserted] = result.try_emplace(key);
+                        if (inserted) {
+                            it->second = std::move(g.points);
+                            continue;
+                        }
+                        std::vector<TPoint> convex_hull;
+                        merge_hulls(std::begin(it->second), std::end(it->second), std::begin(g.points), std::end(g.points),
+                                    std::back_inserter(convex_hull));
+                        it->second = std::move(convex_hull);
+                        std::vector<TPoint>().swap(g.points);
+                    }
+                    chunk[partition].clear();
+                }
+            }
+        });
+        
+        auto hulls = std::move(merged.front());
+        for (std::size_t partition{1}; partition < threads; partition++) {
+            hulls.merge(merged[partition]);
+        }
+        return hulls;
+    }
+}
+
+#endif
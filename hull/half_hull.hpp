@@ -0,0 +1,243 @@
+/**
+ * Lower and upper hulls, computed on their own.
+ * Envelope computations (the upper envelope of a time series, the lower
+ * envelope of a support curve) only need one chain of the convex hull.
+ * The functions below run a single Monotone Chain scan instead of two,
+ * and their output is at most as large as their input.
+ * Both chains go from the lowest point to the highest point with respect
+ * to lexicographic_less (by x-coordinate, then by y-coordinate):
+ *      lower hull  the vertices turning left (counter-clockwise);
+ *      upper hull  the vertices turning right (clockwise).
+ * Hence, the convex hull of monotone_chain is the lower hull followed by
+ * the upper hull reversed, without its endpoints.
+ * Each function has:
+ * - a presorted variant, for points already sorted with lexicographic_less
+ *   (a time series, for instance), which does not sort nor modify the input;
+ * - a parallel variant: each thread computes the chain of a contiguous
+ *   chunk of the points, then a last scan runs on the concatenated chains.
+ * Example:
+ *      <code>
+ *      std::vector<point> envelope(samples.size());
+ *      envelope.erase(hull::upper_hull(hull::presorted, std::begin(samples), std::end(samples), std::begin(envelope)),
+ *                     std::end(envelope));
+ *      </code>
+ */
+
+#ifndef half_hull_h
+#define half_hull_h
+
+#include "angle.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace hull::algorithms::details::half_hull {
+    /**
+     * The smallest number of points worth a thread.
+     */
+    constexpr std::size_t min_chunk = 4096;
+    
+    /**
+     * Compute one chain of the convex hull of sorted points.
+     * Duplicate consecutive points are skipped.
+     * Average time complexity: O(N) where N is the number of points.
+     * @param first - the forward iterator to the first point (sorted with lexicographic_less).
+     * @param last - the forward iterator to the one-past last point.
+     * @param first2 - the random access iterator to the first point of the chain.
+     * @return - the number of points on the chain.
+     */
+    template <bool Upper, typename ForwardIt, typename RandomIt>
+    std::size_t chain(ForwardIt first, ForwardIt last, RandomIt first2) {
+        std::size_t k{};
+        for (; first != last; ++first) {
+            const auto& p = *first;
+            if (k > 0 && hull::equals(*(first2 + (k - 1)), p)) {
+                continue;
+            }
+            
+            while (k >= 2) {
+                const auto c = cross(*(first2 + (k - 2)), *(first2 + (k - 1)), p);
+                if (Upper ? c < 0 : c > 0) {
+                    break;
+                }
+                k--;
+            }
+            *(first2 + k) = p;
+            k++;
+        }
+        return k;
+    }
+    
+    /**
+     * Run a linear scan of sorted points (a chain, a Pareto front...) with
+     * the given number of threads. A point dropped by the scan of a subset
+     * must be dropped by the scan of the whole set: then each thread scans
+     * a contiguous chunk of the points, and a last scan runs on the
+     * concatenated outputs of the chunks. Unless Sorted, the points are
+     * sorted in place, chunk by chunk when several threads are used.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @param scan - the scan, called as scan(first, last, first2) on sorted points
+     *               and returning the number of points written.
+     * @return - the number of points written.
+     */
+    template <
+        bool Sorted,
+        typename RandomIt1,
+        typename RandomIt2,
+        typename Scan,
+        typename TPoint = typename std::iterator_traits<RandomIt1>::value_type
+    >
+    std::size_t chunked_scan(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t threads, Scan scan) {
+        const auto N = static_cast<std::size_t>(std::distance(first, last));
+        const auto chunks = parallel::thread_count(threads, N / min_chunk);
+        if (chunks <= 1) {
+            if constexpr (!Sorted) {
+                monotone::sort(first, last);
+            }
+            return scan(first, last, first2);
+        }
+        
+        std::vector<std::vector<TPoint>> outputs(chunks);
+        parallel::for_each_chunk(N, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            const auto chunk_first = first + static_cast<std::ptrdiff_t>(begin);
+            const auto chunk_last = first + static_cast<std::ptrdiff_t>(end);
+            if constexpr (!Sorted) {
+                monotone::sort(chunk_first, chunk_last);
+            }
+            auto& output = outputs[chunk];
+            output.resize(end - begin);
+            output.resize(scan(chunk_first, chunk_last, std::begin(output)));
+        });
+        
+        std::vector<TPoint> points;
+        for (const auto& output: outputs) {
+            points.insert(std::end(points), std::begin(output), std::end(output));
+        }
+        if constexpr (!Sorted) {
+            monotone::sort(std::begin(points), std::end(points));
+        }
+        return scan(std::begin(points), std::end(points), first2);
+    }
+    
+    /**
+     * Compute one chain of the convex hull, with the given number of threads.
+     * A point which is not on the chain of a subset is not on the chain of
+     * the whole set, so that the chunks may be scanned on their own.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the chain.
+     */
+    template <bool Upper, bool Sorted, typename RandomIt1, typename RandomIt2>
+    RandomIt2 compute(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t threads) {
+        const auto k = chunked_scan<Sorted>(first, last, first2, threads, [](auto chain_first, auto chain_last, auto chain_first2) {
+            return chain<Upper>(chain_first, chain_last, chain_first2);
+        });
+        return first2 + static_cast<std::ptrdiff_t>(k);
+    }
+}
+
+namespace hull {
+    /**
+     * Tag telling that the input points are already sorted
+     * with lexicographic_less (by x-coordinate, then by y-coordinate).
+     */
+    struct presorted_t {};
+    static constexpr const presorted_t presorted{};
+    
+    /**
+     * Compute the lower hull of a container of points. The points are
+     * reordered in place: they are sorted as with monotone_chain
+     * when a single chunk is used, and only chunk by chunk otherwise.
+     * Average time complexity: O(N * log(N) / T) where N is the number of
+     * points and T the number of threads.
+     * Average space complexity: O(N).
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the lower hull.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 lower_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t threads = 1) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        return algorithms::details::half_hull::compute<false, false>(first, last, first2, threads);
+    }
+    
+    /**
+     * Compute the upper hull of a container of points. The points are
+     * reordered in place, as with lower_hull.
+     * Average time complexity: O(N * log(N) / T) where N is the number of
+     * points and T the number of threads.
+     * Average space complexity: O(N).
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the upper hull.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 upper_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t threads = 1) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        return algorithms::details::half_hull::compute<true, false>(first, last, first2, threads);
+    }
+    
+    /**
+     * Compute the lower hull of points already sorted with lexicographic_less.
+     * The input is not modified.
+     * Average time complexity: O(N / T) where N is the number of points
+     * and T the number of threads.
+     * Average space complexity: O(H * T) where H is the number of points on the lower hull.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the lower hull.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 lower_hull(presorted_t, RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t threads = 1) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        return algorithms::details::half_hull::compute<false, true>(first, last, first2, threads);
+    }
+    
+    /**
+     * Compute the upper hull of points already sorted with lexicographic_less.
+     * The input is not modified.
+     * Average time complexity: O(N / T) where N is the number of points
+     * and T the number of threads.
+     * Average space complexity: O(H * T) where H is the number of points on the upper hull.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the upper hull.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 upper_hull(presorted_t, RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t threads = 1) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        return algorithms::details::half_hull::compute<true, true>(first, last, first2, threads);
+    }
+}
+
+#endif
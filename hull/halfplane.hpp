@@ -0,0 +1,393 @@
+/**
+ * Intersection of half-planes a * x + b * y <= c, that is the feasible
+ * region of a linear program with 2 variables.
+ * By point-line duality, the intersection is made of envelopes of lines
+ * (see line_envelope.hpp):
+ *      b > 0       y <= m * x + q, with m = -a / b and q = c / b: the region
+ *                  is below the lower envelope D of these lines;
+ *      b < 0       y >= m * x + q: the region is above the upper envelope U;
+ *      b = 0       a bound on x (or, if a = 0 too, a constraint 0 <= c
+ *                  which is either always or never satisfied).
+ * D and U are the lower and upper hulls of the dual points (m, q), computed
+ * with the Monotone Chain scan. D - U is concave, so that the feasible x
+ * form an interval, found from the values of D - U at the breakpoints of
+ * the envelopes. The vertices of the region are then the breakpoints of
+ * U and D within this interval, and its ends.
+ * Time complexity: O(N * log(N)) where N is the number of half-planes.
+ * Many small systems are solved at once with halfplane_intersections,
+ * which takes them in the CSR layout of batch.hpp.
+ * Example:
+ *      <code>
+ *      std::vector<hull::halfplane> constraints{{1, 0, 4}, {-1, 0, 0}, {0, 1, 3}, {0, -1, 0}};
+ *      const auto result = hull::halfplane_intersection<std::array<double, 2>>(std::begin(constraints), std::end(constraints));
+ *      if (result.status == hull::halfplane_status::bounded) { ... result.polygon ... }
+ *      </code>
+ */
+
+#ifndef halfplane_h
+#define halfplane_h
+
+#include "line_envelope.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace hull {
+    /**
+     * The half-plane a * x + b * y <= c.
+     */
+    struct halfplane {
+        double a{};
+        double b{};
+        double c{};
+    };
+    
+    /**
+     * Outcome of a half-plane intersection.
+     * @param bounded - the intersection is a non-empty convex polygon (possibly
+     *                  degenerate: a segment or a point).
+     * @param empty - the half-planes have no point in common.
+     * @param unbounded - the intersection is non-empty and unbounded.
+     */
+    enum class halfplane_status {
+        bounded,
+        empty,
+        unbounded
+    };
+    
+    /**
+     * Result of a half-plane intersection.
+     * @param status - whether the intersection is bounded, empty or unbounded.
+     * @param polygon - the vertices of the intersection if it is bounded, in the
+     *                  same order as monotone_chain (empty otherwise).
+     */
+    template <typename TPoint>
+    struct halfplane_result {
+        halfplane_status status{halfplane_status::empty};
+        std::vector<TPoint> polygon;
+    };
+}
+
+namespace hull::details::halfplane {
+    using line = std::array<double, 2>;
+    using envelope = line_envelope<line>;
+    
+    /**
+     * Relative tolerance on D - U: the envelopes are evaluated at rounded
+     * breakpoints, so a region reduced to a point or a segment, and the
+     * ends of the interval of the feasible x, are only met up to rounding.
+     */
+    constexpr double tolerance = 1e-9;
+    
+    /**
+     * @return - the x-coordinates where the lowest line of the envelope changes.
+     */
+    inline std::vector<double> breakpoints(const envelope& e) {
+        std::vector<double> xs;
+        const auto& lines = e.lines();
+        for (std::size_t i{}; i + 1 < lines.size(); i++) {
+            xs.push_back((lines[i][1] - lines[i + 1][1]) / (lines[i + 1][0] - lines[i][0]));
+        }
+        return xs;
+    }
+    
+    /**
+     * Intersection of half-planes split into the envelopes D and U
+     * (U being stored negated, as a lower envelope) and bounds on x.
+     */
+    struct system {
+        envelope below;
+        envelope above;
+        double left{-std::numeric_limits<double>::infinity()};
+        double right{std::numeric_limits<double>::infinity()};
+        bool infeasible{};
+        
+        double D(double x) const {
+            return below.minimum(x);
+        }
+        
+        double U(double x) const {
+            return -above.minimum(x);
+        }
+        
+        double g(double x) const {
+            return D(x) - U(x);
+        }
+        
+        /**
+         * @return - D - U at x, or 0 if it is within the tolerance of the values at x.
+         */
+        double rounded_g(double x) const {
+            const auto d = D(x);
+            const auto u = U(x);
+            const auto scale = std::max({1., std::abs(x), std::abs(d), std::abs(u)});
+            return std::abs(d - u) <= tolerance * scale ? 0. : d - u;
+        }
+    };
+    
+    /**
+     * Split the half-planes into the envelopes and the bounds on x.
+     * @param first - the forward iterator to the first half-plane.
+     * @param last - the forward iterator to the one-past last half-plane.
+     * @return - the system.
+     */
+    template <typename ForwardIt>
+    system make_system(ForwardIt first, ForwardIt last) {
+        system s;
+        std::vector<line> below;
+        std::vector<line> above;
+        for (; first != last; ++first) {
+            const hull::halfplane& h = *first;
+            if (h.b > 0) {
+                below.push_back({{-h.a / h.b, h.c / h.b}});
+            }
+            else if (h.b < 0) {
+                above.push_back({{h.a / h.b, -h.c / h.b}});
+            }
+            else if (h.a > 0) {
+                s.right = std::min(s.right, h.c / h.a);
+            }
+            else if (h.a < 0) {
+                s.left = std::max(s.left, h.c / h.a);
+            }
+            else if (h.c < 0) {
+                s.infeasible = true;
+            }
+        }
+        s.below = envelope(std::begin(below), std::end(below));
+        s.above = envelope(std::begin(above), std::end(above));
+        return s;
+    }
+    
+    /**
+     * @return - the root of the linear function through (x1, g1) and (x2, g2),
+     *           where g1 and g2 have opposite signs (or one of them is 0),
+     *           clamped to [x1 ; x2].
+     */
+    inline double root(double x1, double g1, double x2, double g2) {
+        if (g1 == 0) {
+            return x1;
+        }
+        if (g2 == 0) {
+            return x2;
+        }
+        return std::clamp(x1 + (x2 - x1) * g1 / (g1 - g2), std::min(x1, x2), std::max(x1, x2));
+    }
+    
+    /**
+     * Compute the intersection of half-planes.
+     * @param first - the forward iterator to the first half-plane.
+     * @param last - the forward iterator to the one-past last half-plane.
+     * @return - the status and the polygon of the intersection.
+     */
+    template <typename TPoint, typename ForwardIt>
+    halfplane_result<TPoint> solve(ForwardIt first, ForwardIt last) {
+        using coordinate_type = std::decay_t<coordinate_t<TPoint>>;
+        halfplane_result<TPoint> result;
+        
+        const auto s = make_system(first, last);
+        if (s.infeasible || s.left > s.right) {
+            return result;
+        }
+        if (s.below.lines().empty() || s.above.lines().empty()) {
+            // A non-empty strip or half-plane of the x bounds, unbounded along y.
+            result.status = halfplane_status::unbounded;
+            return result;
+        }
+        
+        // The values of D - U at the breakpoints within the bounds, and at the bounds.
+        const auto below_xs = breakpoints(s.below);
+        const auto above_xs = breakpoints(s.above);
+        std::vector<double> xs = below_xs;
+        xs.insert(std::end(xs), std::begin(above_xs), std::end(above_xs));
+        xs.erase(std::remove_if(std::begin(xs), std::end(xs), [&s](double x) { return x <= s.left || x >= s.right; }),
+                 std::end(xs));
+        const auto has_left = s.left != -std::numeric_limits<double>::infinity();
+        const auto has_right = s.right != std::numeric_limits<double>::infinity();
+        if (has_left) {
+            xs.push_back(s.left);
+        }
+        if (has_right) {
+            xs.push_back(s.right);
+        }
+        if (xs.empty()) {
+            xs.push_back(0.);
+        }
+        std::sort(std::begin(xs), std::end(xs));
+        xs.erase(std::unique(std::begin(xs), std::end(xs)), std::end(xs));
+        
+        std::vector<double> gs(xs.size());
+        std::transform(std::begin(xs), std::end(xs), std::begin(gs), [&s](double x) { return s.rounded_g(x); });
+        
+        // Slopes of D - U beyond the breakpoints: the steepest lines of D at
+        // -infinity and the flattest ones at +infinity, and the opposite for U.
+        const auto left_slope = s.below.lines().back()[0] + s.above.lines().back()[0];
+        const auto right_slope = s.below.lines().front()[0] + s.above.lines().front()[0];
+        if ((!has_left && (left_slope < 0 || (left_slope == 0 && gs.front() >= 0))) ||
+            (!has_right && (right_slope > 0 || (right_slope == 0 && gs.back() >= 0))))
+        {
+            result.status = halfplane_status::unbounded;
+            return result;
+        }
+        
+        const auto best = static_cast<std::size_t>(std::max_element(std::begin(gs), std::end(gs)) - std::begin(gs));
+        if (gs[best] < 0) {
+            return result;
+        }
+        
+        // The ends of the interval of the feasible x.
+        auto i = best;
+        for (; i > 0 && gs[i - 1] >= 0; i--) {}
+        double x_left = xs[i];
+        if (i > 0) {
+            x_left = root(xs[i - 1], gs[i - 1], xs[i], gs[i]);
+        }
+        else if (!has_left && gs[0] > 0) {
+            x_left = xs[0] - gs[0] / left_slope;
+        }
+        auto j = best;
+        for (; j + 1 < xs.size() && gs[j + 1] >= 0; j++) {}
+        double x_right = xs[j];
+        if (j + 1 < xs.size()) {
+            x_right = root(xs[j], gs[j], xs[j + 1], gs[j + 1]);
+        }
+        else if (!has_right && gs[j] > 0) {
+            x_right = xs[j] - gs[j] / right_slope;
+        }
+        
+        // The vertices of the region, cleaned by Monotone Chain: at each end,
+        // a single vertex where D and U meet (up to the tolerance) and two
+        // otherwise, then the breakpoints of D and U between the ends.
+        std::vector<TPoint> vertices;
+        auto add = [&vertices](double x, double y) {
+            vertices.push_back(make_point<TPoint>(static_cast<coordinate_type>(x), static_cast<coordinate_type>(y)));
+        };
+        auto add_end = [&s, &add](double x, bool meet) {
+            if (meet || s.rounded_g(x) == 0) {
+                add(x, (s.D(x) + s.U(x)) / 2);
+            }
+            else {
+                add(x, s.D(x));
+                add(x, s.U(x));
+            }
+        };
+        // The ends found by a root are where D and U meet.
+        add_end(x_left, i > 0 || (!has_left && gs[0] > 0));
+        add_end(x_right, j + 1 < xs.size() || (!has_right && gs[j] > 0));
+        for (const auto x: below_xs) {
+            if (x > x_left && x < x_right) {
+                add(x, s.D(x));
+            }
+        }
+        for (const auto x: above_xs) {
+            if (x > x_left && x < x_right) {
+                add(x, s.U(x));
+            }
+        }
+        
+        std::sort(std::begin(vertices), std::end(vertices), algorithms::details::monotone::lexicographic_less{});
+        vertices.erase(std::unique(std::begin(vertices), std::end(vertices)), std::end(vertices));
+        
+        result.status = halfplane_status::bounded;
+        result.polygon.resize(2 * vertices.size());
+        result.polygon.erase(algorithms::monotone_chain(std::begin(vertices), std::end(vertices), std::begin(result.polygon)),
+                             std::end(result.polygon));
+        return result;
+    }
+}
+
+namespace hull {
+    /**
+     * Compute the intersection of half-planes a * x + b * y <= c.
+     * Time complexity: O(N * log(N)) where N is the number of half-planes.
+     * Space complexity: O(N).
+     * @param first - the forward iterator to the first half-plane.
+     * @param last - the forward iterator to the one-past last half-plane.
+     * @return - the status of the intersection, and its vertices if it is bounded.
+     */
+    template <typename TPoint, typename ForwardIt>
+    halfplane_result<TPoint> halfplane_intersection(ForwardIt first, ForwardIt last) {
+        static_assert_is_point<TPoint>();
+        
+        return details::halfplane::solve<TPoint>(first, last);
+    }
+    
+    /**
+     * Container-based version of halfplane_intersection.
+     * @param halfplanes - the half-planes.
+     * @return - the status of the intersection, and its vertices if it is bounded.
+     */
+    template <typename TPoint, typename TContainer>
+    halfplane_result<TPoint> halfplane_intersection(const TContainer& halfplanes) {
+        return halfplane_intersection<TPoint>(std::begin(halfplanes), std::end(halfplanes));
+    }
+    
+    /**
+     * Compute the intersections of many systems of half-planes given in
+     * the CSR layout: the system i is [first[offsets[i]] ; first[offsets[i + 1]]).
+     * The systems are split into contiguous chunks, one per thread.
+     * @param first - the random access iterator to the first half-plane of the flat array.
+     * @param offsets_first - the forward iterator to the first offset (S + 1 offsets for S systems,
+     *                        non-decreasing, relative to first).
+     * @param offsets_last - the forward iterator to the one-past last offset.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the result of each system.
+     * @throw std::invalid_argument - if the offsets are decreasing.
+     */
+    template <typename TPoint, typename RandomIt, typename ForwardIt>
+    std::vector<halfplane_result<TPoint>> halfplane_intersections(RandomIt first, ForwardIt offsets_first, ForwardIt offsets_last,
+                                                                  std::size_t threads = 0)
+    {
+        static_assert_is_point<TPoint>();
+        
+        const std::vector<std::size_t> offsets(offsets_first, offsets_last);
+        if (offsets.size() <= 1) {
+            return {};
+        }
+        if (!std::is_sorted(std::begin(offsets), std::end(offsets))) {
+            throw std::invalid_argument("the offsets of a batch must be non-decreasing");
+        }
+        
+        std::vector<halfplane_result<TPoint>> results(offsets.size() - 1);
+        parallel::for_each_chunk(results.size(), threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                results[i] = details::halfplane::solve<TPoint>(first + static_cast<std::ptrdiff_t>(offsets[i]),
+                                                               first + static_cast<std::ptrdiff_t>(offsets[i + 1]));
+            }
+        });
+        return results;
+    }
+    
+    /**
+     * Container-based version of halfplane_intersections.
+     * @param halfplanes - the flat array of half-planes.
+     * @param offsets - the S + 1 offsets of the S systems.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the result of each system.
+     * @throw std::invalid_argument - if the offsets are decreasing or exceed the half-planes.
+     */
+    template <typename TPoint, typename TContainer, typename TOffsets>
+    std::vector<halfplane_result<TPoint>> halfplane_intersections(const TContainer& halfplanes, const TOffsets& offsets,
+                                                                  std::size_t threads = 0)
+    {
+        if (std::begin(offsets) != std::end(offsets) &&
+            static_cast<std::size_t>(*std::prev(std::end(offsets))) > halfplanes.size())
+        {
+            throw std::invalid_argument("the offsets of a batch exceed the half-planes");
+        }
+        return halfplane_intersections<TPoint>(std::begin(halfplanes), std::begin(offsets), std::end(offsets), threads);
+    }
+}
+
+#endif
@@ -0,0 +1,356 @@
+/**
+ * Compact binary serialization of convex hulls.
+ * The vertices of a convex hull are close to each other: instead of
+ * raw coordinates, each hull is stored as small integer deltas.
+ * 1. the coordinates are quantized on a per-hull grid: a scale (a power
+ *    of 2, so that the quantization is exact in binary floating-point)
+ *    and an origin (the bottom-left corner of the bounding box);
+ * 2. each vertex is stored as the difference with the previous one,
+ *    zigzag-encoded (so that small negative deltas stay small) and
+ *    written as a LEB128 varint (7 bits per byte).
+ * Layout of a hull (every field but the tag is a varint):
+ *      tag      one byte: the version of the format (3 high bits), 1 if the
+ *               coordinates are floating-point (next bit) and their size
+ *               in bytes (4 low bits), so that a hull is never decoded with
+ *               another coordinate type
+ *      N        number of vertices (the hull stops here if N = 0)
+ *      e        floating-point coordinates only: zigzag exponent of the scale 2^e
+ *      origin   zigzag x and y of the origin, in units of the scale
+ *      deltas   N times: zigzag dx, zigzag dy, in units of the scale
+ * Hulls are simply concatenated in a stream. Integral coordinates are
+ * stored losslessly. Floating-point coordinates are rounded to the
+ * nearest point of the grid: the error is at most 2^e / 2 per coordinate.
+ * Example:
+ *      <code>
+ *      std::vector<unsigned char> bytes;
+ *      hull::io::encode_hull(std::begin(convex_hull), std::end(convex_hull), bytes);
+ *      hull::io::hull_reader<double> reader(bytes.data(), bytes.data() + bytes.size());
+ *      reader.read_into(decoded_hull);
+ *      </code>
+ */
+
+#ifndef hull_codec_h
+#define hull_codec_h
+
+#include "mapped_points.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace hull::io {
+    /**
+     * Quantization of floating-point coordinates (ignored for
+     * integral coordinates, which are stored losslessly).
+     * @param quantum - if positive, the scale of every hull is the largest
+     *                  power of 2 not above quantum (the error is at most quantum / 2).
+     * @param precision_bits - otherwise, the scale of a hull is about the extent
+     *                         of its bounding box divided by 2^precision_bits.
+     * In both cases, the scale is never finer than the precision of the
+     * coordinates themselves.
+     */
+    struct hull_codec_options {
+        double quantum{};
+        unsigned precision_bits{24};
+    };
+}
+
+namespace hull::io::details::codec {
+    constexpr unsigned version = 1;
+    
+    /**
+     * @return - the tag of the hulls of coordinate type T (see the layout).
+     */
+    template <typename T>
+    constexpr unsigned char tag() noexcept {
+        static_assert(sizeof(T) < 16, "unsupported coordinate type");
+        return static_cast<unsigned char>((version << 5) | (std::is_floating_point<T>::value ? 0x10 : 0) | sizeof(T));
+    }
+    
+    inline std::uint64_t zigzag(std::int64_t value) noexcept {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+    
+    inline std::int64_t unzigzag(std::uint64_t value) noexcept {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+    
+    inline void put_varint(std::uint64_t value, std::vector<unsigned char>& out) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+    
+    /**
+     * Read a varint.
+     * @param p - the first byte; it is moved past the varint.
+     * @param last - the end of the buffer.
+     * @throw std::runtime_error - if the varint is truncated or too long.
+     */
+    inline std::uint64_t get_varint(const unsigned char*& p, const unsigned char* last) {
+        // Fast paths: most deltas fit in one or two bytes.
+        if (last - p >= 2) {
+            if (p[0] < 0x80) {
+                return *p++;
+            }
+            if (p[1] < 0x80) {
+                const auto value = static_cast<std::uint64_t>(p[0] & 0x7f) | (static_cast<std::uint64_t>(p[1]) << 7);
+                p += 2;
+                return value;
+            }
+        }
+        
+        std::uint64_t value{};
+        for (unsigned shift{}; shift < 64; shift += 7) {
+            if (p == last) {
+                throw std::runtime_error("truncated hull stream");
+            }
+            const auto byte = *p++;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+        throw std::runtime_error("corrupted hull stream");
+    }
+    
+    /**
+     * Choose the exponent e of the scale 2^e of a hull (see hull_codec_options).
+     * @return - the exponent.
+     */
+    inline std::int64_t scale_exponent(double min_x, double min_y, double max_x, double max_y,
+                                       const hull_codec_options& options) {
+        const auto magnitude = std::max({std::abs(min_x), std::abs(min_y), std::abs(max_x), std::abs(max_y)});
+        // A grid finer than the precision of a double is pointless, and
+        // this bound keeps the quantized coordinates below 2^54.
+        const auto finest = (magnitude > 0.) ? std::ilogb(magnitude) - 52 : 0;
+        
+        int exponent{};
+        if (options.quantum > 0.) {
+            exponent = std::ilogb(options.quantum);
+        }
+        else {
+            const auto extent = std::max(max_x - min_x, max_y - min_y);
+            exponent = (extent > 0.) ? std::ilogb(extent) + 1 - static_cast<int>(std::min(options.precision_bits, 62u))
+                                     : finest;
+        }
+        return std::max(exponent, finest);
+    }
+}
+
+namespace hull::io {
+    /**
+     * Append the compact encoding of a convex hull to a buffer (see
+     * the layout at the top of this file).
+     * Average time complexity: O(H) where H is the number of vertices.
+     * @param first - the forward iterator to the first vertex of the hull.
+     * @param last - the forward iterator to the one-past last vertex of the hull.
+     * @param out - the buffer the encoding is appended to.
+     * @param options - the quantization of floating-point coordinates.
+     * @return - the number of bytes appended.
+     */
+    template <typename ForwardIt>
+    std::size_t encode_hull(ForwardIt first, ForwardIt last, std::vector<unsigned char>& out,
+                            const hull_codec_options& options = {})
+    {
+        static_assert_is_forward_iterator_to_point<ForwardIt>();
+        using point_type = typename std::iterator_traits<ForwardIt>::value_type;
+        using coordinate_type = std::decay_t<coordinate_t<point_type>>;
+        using namespace details::codec;
+        
+        const auto size = out.size();
+        out.push_back(tag<coordinate_type>());
+        put_varint(static_cast<std::uint64_t>(std::distance(first, last)), out);
+        if (first == last) {
+            return out.size() - size;
+        }
+        
+        auto min_x = x(*first);
+        auto min_y = y(*first);
+        auto max_x = min_x;
+        auto max_y = min_y;
+        std::for_each(first, last, [&](const auto& p) {
+            min_x = std::min<coordinate_type>(min_x, x(p));
+            min_y = std::min<coordinate_type>(min_y, y(p));
+            max_x = std::max<coordinate_type>(max_x, x(p));
+            max_y = std::max<coordinate_type>(max_y, y(p));
+        });
+        
+        auto quantize = [](coordinate_type value, double scale) {
+            if constexpr (std::is_integral<coordinate_type>::value) {
+                return static_cast<std::int64_t>(value);
+            }
+            else {
+                return static_cast<std::int64_t>(std::llround(static_cast<double>(value) * scale));
+            }
+        };
+        
+        // Multiplying by 1 / 2^e is exact.
+        auto inverse_scale = 1.;
+        if constexpr (!std::is_integral<coordinate_type>::value) {
+            const auto exponent = scale_exponent(static_cast<double>(min_x), static_cast<double>(min_y),
+                                                 static_cast<double>(max_x), static_cast<double>(max_y), options);
+            put_varint(zigzag(exponent), out);
+            inverse_scale = std::ldexp(1., -exponent);
+        }
+        
+        auto previous_x = quantize(min_x, inverse_scale);
+        auto previous_y = quantize(min_y, inverse_scale);
+        put_varint(zigzag(previous_x), out);
+        put_varint(zigzag(previous_y), out);
+        std::for_each(first, last, [&](const auto& p) {
+            const auto qx = quantize(x(p), inverse_scale);
+            const auto qy = quantize(y(p), inverse_scale);
+            put_varint(zigzag(qx - previous_x), out);
+            put_varint(zigzag(qy - previous_y), out);
+            previous_x = qx;
+            previous_y = qy;
+        });
+        
+        return out.size() - size;
+    }
+    
+    /**
+     * Zero-copy decoder of a stream of hulls encoded with encode_hull.
+     * The buffer must outlive the reader.
+     */
+    template <typename T, typename TPoint = std::array<T, 2>>
+    class hull_reader {
+    public:
+        /**
+         * @param first - the first byte of the stream.
+         * @param last - the one-past last byte of the stream.
+         */
+        hull_reader(const unsigned char* first, const unsigned char* last) noexcept : p_{first}, last_{last} {}
+        
+        /**
+         * @return - true once all the hulls have been read.
+         */
+        bool done() const noexcept {
+            return p_ == last_;
+        }
+        
+        /**
+         * @return - the position of the next hull in the buffer.
+         */
+        const unsigned char* position() const noexcept {
+            return p_;
+        }
+        
+        /**
+         * Decode the next hull into an output iterator.
+         * Average time complexity: O(H) where H is the number of vertices.
+         * @param first2 - the output iterator to the first point of the destination container.
+         * @return - the iterator to the one-past last decoded point.
+         * @throw std::runtime_error - if the stream is truncated or corrupted, or if the
+         *                             hull was encoded with another coordinate type.
+         */
+        template <typename OutputIt>
+        OutputIt read(OutputIt first2) {
+            const auto n = read_header();
+            for (std::size_t i{}; i < n; i++) {
+                *first2++ = next();
+            }
+            return first2;
+        }
+        
+        /**
+         * Decode the next hull into a container, which is resized to the
+         * number of vertices, so that it may be reused from one hull to
+         * the next without allocation.
+         * @param hull - the destination container.
+         * @throw std::runtime_error - if the stream is truncated or corrupted, or if the
+         *                             hull was encoded with another coordinate type.
+         */
+        template <typename TContainer>
+        void read_into(TContainer& hull) {
+            const auto n = read_header();
+            hull.resize(n);
+            for (auto& p: hull) {
+                p = next();
+            }
+        }
+        
+        /**
+         * Skip the next hull without decoding its vertices.
+         * @return - the number of vertices of the skipped hull.
+         * @throw std::runtime_error - if the stream is truncated or corrupted, or if the
+         *                             hull was encoded with another coordinate type.
+         */
+        std::size_t skip() {
+            const auto n = read_header();
+            for (std::size_t i{}; i < 2 * n; i++) {
+                details::codec::get_varint(p_, last_);
+            }
+            return n;
+        }
+    
+    private:
+        std::size_t read_header() {
+            using namespace details::codec;
+            
+            if (p_ == last_) {
+                throw std::runtime_error("truncated hull stream");
+            }
+            const auto found = *p_++;
+            if ((found >> 5) != version) {
+                throw std::runtime_error("unsupported hull stream version");
+            }
+            if (found != tag<T>()) {
+                throw std::runtime_error("hull stream of another coordinate type");
+            }
+            
+            const auto n = get_varint(p_, last_);
+            // Each vertex takes at least 2 bytes: reject absurd counts early.
+            if (n > static_cast<std::uint64_t>(last_ - p_) / 2) {
+                throw std::runtime_error("corrupted hull stream");
+            }
+            if (n == 0) {
+                return 0;
+            }
+            
+            if constexpr (!std::is_integral<T>::value) {
+                const auto exponent = unzigzag(get_varint(p_, last_));
+                if (exponent < -1100 || exponent > 1100) {
+                    throw std::runtime_error("corrupted hull stream");
+                }
+                scale_ = std::ldexp(1., static_cast<int>(exponent));
+            }
+            x_ = unzigzag(get_varint(p_, last_));
+            y_ = unzigzag(get_varint(p_, last_));
+            return static_cast<std::size_t>(n);
+        }
+        
+        TPoint next() {
+            using namespace details::codec;
+            
+            x_ += unzigzag(get_varint(p_, last_));
+            y_ += unzigzag(get_varint(p_, last_));
+            if constexpr (std::is_integral<T>::value) {
+                return make_point<TPoint>(static_cast<T>(x_), static_cast<T>(y_));
+            }
+            else {
+                return make_point<TPoint>(static_cast<T>(static_cast<double>(x_) * scale_),
+                                          static_cast<T>(static_cast<double>(y_) * scale_));
+            }
+        }
+        
+        const unsigned char* p_;
+        const unsigned char* last_;
+        double scale_{1.};
+        std::int64_t x_{};
+        std::int64_t y_{};
+    };
+}
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * Linear-time merge of convex hulls.
+ * The convex hull of the union of two convex polygons only depends on
+ * their vertices. Once split at their leftmost and rightmost vertices,
+ * the lower and upper chains of a convex polygon are already sorted by
+ * x-coordinate: the 4 chains of two polygons are merged in linear time
+ * and fed to a streaming Monotone Chain. Merging two hulls of H1 and H2
+ * vertices is then O(H1 + H2), instead of O((H1 + H2) * log(H1 + H2))
+ * when the vertices are concatenated and the convex hull is computed
+ * again.
+ * This is the combining step of any sharded computation: each shard
+ * computes the convex hull of its own points, and the partial hulls are
+ * merged with a parallel reduction tree (see sharded_hull.hpp).
+ */
+
+#ifndef hull_merge_h
+#define hull_merge_h
+
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace hull::algorithms::details::hull_merge {
+    /**
+     * Vertices of a convex polygon, split into two chains sorted with
+     * lexicographic_less: the lower chain (from the leftmost to the
+     * rightmost vertex) and the upper chain (same direction).
+     */
+    template <typename TPoint>
+    struct sorted_chains {
+        std::vector<TPoint> lower;
+        std::vector<TPoint> upper;
+    };
+    
+    /**
+     * Split a convex polygon into its sorted chains. The polygon may be
+     * clockwise or counter-clockwise and start at any vertex, so that the
+     * output of any algorithm of this library is accepted.
+     * Average time complexity: O(H) where H is the number of vertices.
+     * @param first - the forward iterator to the first vertex of the polygon.
+     * @param last - the forward iterator to the one-past last vertex of the polygon.
+     * @return - the sorted chains.
+     */
+    template <
+        typename ForwardIt,
+        typename TPoint = typename std::iterator_traits<ForwardIt>::value_type
+    >
+    sorted_chains<TPoint> split(ForwardIt first, ForwardIt last) {
+        std::vector<TPoint> polygon(first, last);
+        sorted_chains<TPoint> chains;
+        if (polygon.empty()) {
+            return chains;
+        }
+        
+        // Counter-clockwise, starting at the leftmost vertex.
+        const auto less = monotone::lexicographic_less{};
+        std::rotate(std::begin(polygon), std::min_element(std::begin(polygon), std::end(polygon), less), std::end(polygon));
+        const auto n = polygon.size();
+        for (std::size_t i{1}; i + 1 < n; i++) {
+            const auto orientation = cross(polygon[0], polygon[i], polygon[i + 1]);
+            if (orientation < 0) {
+                std::reverse(std::next(std::begin(polygon)), std::end(polygon));
+                break;
+            }
+            if (orientation > 0) {
+                break;
+            }
+        }
+        
+        const auto rightmost = std::max_element(std::begin(polygon), std::end(polygon), less);
+        chains.lower.assign(std::begin(polygon), std::next(rightmost));
+        chains.upper.assign(rightmost, std::end(polygon));
+        chains.upper.push_back(polygon.front());
+        std::reverse(std::begin(chains.upper), std::end(chains.upper));
+        
+        return chains;
+    }
+}
+
+namespace hull::algorithms {
+    /**
+     * Compute the convex hull of the union of two convex polygons.
+     * The polygons may be given in the order of any algorithm of this
+     * library (clockwise or counter-clockwise, starting at any vertex).
+     * The output is in the same order as monotone_chain.
+     * Average time complexity: O(H1 + H2) where H1 and H2 are the numbers
+     * of vertices of the polygons.
+     * Average space complexity: O(H1 + H2).
+     * @param first1 - the forward iterator to the first vertex of the first polygon.
+     * @param last1 - the forward iterator to the one-past last vertex of the first polygon.
+     * @param first2 - the forward iterator to the first vertex of the second polygon.
+     * @param last2 - the forward iterator to the one-past last vertex of the second polygon.
+     * @param first3 - the output iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull.
+     */
+    template <typename ForwardIt1, typename ForwardIt2, typename OutputIt>
+    OutputIt merge_hulls(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2, OutputIt first3) {
+        static_assert_is_forward_iterator_to_point<ForwardIt1>();
+        static_assert_is_forward_iterator_to_point<ForwardIt2>();
+        using point_type = typename std::iterator_traits<ForwardIt1>::value_type;
+        
+        const auto chains1 = details::hull_merge::split(first1, last1);
+        const auto chains2 = details::hull_merge::split(first2, last2);
+        const auto less = details::monotone::lexicographic_less{};
+        
+        std::vector<point_type> lower;
+        lower.reserve(chains1.lower.size() + chains2.lower.size());
+        std::merge(std::begin(chains1.lower), std::end(chains1.lower),
+                   std::begin(chains2.lower), std::end(chains2.lower), std::back_inserter(lower), less);
+        
+        std::vector<point_type> upper;
+        upper.reserve(chains1.upper.size() + chains2.upper.size());
+        std::merge(std::begin(chains1.upper), std::end(chains1.upper),
+                   std::begin(chains2.upper), std::end(chains2.upper), std::back_inserter(upper), less);
+        
+        std::vector<point_type> sorted;
+        sorted.reserve(lower.size() + upper.size());
+        std::merge(std::begin(lower), std::end(lower), std::begin(upper), std::end(upper), std::back_inserter(sorted), less);
+        
+        details::monotone::chain_builder<point_type> chain;
+        for (const auto& p: sorted) {
+            chain.push(p);
+        }
+        return chain.copy(first3);
+    }
+    
+    /**
+     * Compute the convex hull of the union of K convex polygons with a
+     * reduction tree: at each level, the polygons are merged by pairs,
+     * the pairs being merged in parallel.
+     * Average time complexity: O(H * log(K) / T) where H is the total
+     * number of vertices and T the number of threads.
+     * Average space complexity: O(H).
+     * @param first - the forward iterator to the first container of vertices.
+     * @param last - the forward iterator to the one-past last container of vertices.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the vertices of the convex hull, in the same order as monotone_chain.
+     */
+    template <
+        typename ForwardIt,
+        typename TContainer = typename std::iterator_traits<ForwardIt>::value_type,
+        typename TPoint = typename TContainer::value_type
+    >
+    std::vector<TPoint> merge_hull_tree(ForwardIt first, ForwardIt last, std::size_t threads = 0) {
+        static_assert_is_point<TPoint>();
+        
+        std::vector<std::vector<TPoint>> level;
+        std::for_each(first, last, [&level](const auto& polygon) {
+            level.emplace_back(std::begin(polygon), std::end(polygon));
+        });
+        if (level.empty()) {
+            return {};
+        }
+        if (level.size() == 1) {
+            // Normalize the order, as if merged with an empty polygon.
+            std::vector<TPoint> convex_hull;
+            merge_hulls(std::begin(level[0]), std::end(level[0]), std::begin(level[0]), std::begin(level[0]),
+                        std::back_inserter(convex_hull));
+            return convex_hull;
+        }
+        
+        while (level.size() > 1) {
+            const auto pairs = level.size() / 2;
+            std::vector<std::vector<TPoint>> next((level.size() + 1) / 2);
+            
+            parallel::for_each_chunk(pairs, threads, [&level, &next](std::size_t, std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    auto& a = level[2 * i];
+                    auto& b = level[2 * i + 1];
+                    merge_hulls(std::begin(a), std::end(a), std::begin(b), std::end(b), std::back_inserter(next[i]));
+                }
+            });
+            if (level.size() % 2 == 1) {
+                next.back() = std::move(level.back());
+            }
+            
+            level = std::move(next);
+        }
+        
+        return std::move(level.front());
+    }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #define jarvis_march_h
 
 #include "angle.hpp"
+#include "metrics.hpp"
 #include "point_concept.hpp"
 #include "static_assert.hpp"
 
@@ -89,27 +90,30 @@ namespace hull::algorithms::details {
      * Reference: https://en.wikipedia.org/wiki/Gift_wrapping_algorithm
      * @param first - the random access iterator to the first point of the container.
      * @param last - the random access iterator to the one-past last point of the container.
-     * @param first2 - the random access iterator to the first point of the destination container.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @param observer - the observer of the points emitted on the convex hull (see metrics.hpp).
      * @return - the iterator to the last element forming the convex hull of the
      *           provided container of points.
      */
-    template <typename RandomIt1, typename RandomIt2>
-    RandomIt2 jarvis_march_impl(RandomIt1 first, RandomIt1 last, RandomIt2 first2) {
+    template <typename RandomIt1, typename OutputIt, typename Observer = hull::details::metrics::none>
+    OutputIt jarvis_march_impl(RandomIt1 first, RandomIt1 last, OutputIt first2, Observer&& observer = Observer{}) {
         // leftmost point
-        auto point_on_hull = *jarvis::get_left_most(first, last);
+        const auto left_most = *jarvis::get_left_most(first, last);
+        auto point_on_hull = left_most;
         
         // Repeat until wrapped around to first hull point
         std::size_t i{};
         do {
-            *(first2 + i) = point_on_hull;
+            *first2++ = point_on_hull;
+            observer.push(i, point_on_hull);
             
             point_on_hull = jarvis::next_point_on_hull(first, last, point_on_hull);
             
             i++;
         }
-        while (!hull::equals(point_on_hull, *first2));
+        while (!hull::equals(point_on_hull, left_most));
         
-        return first2 + i;
+        return first2;
     }
 }
 
@@ -177,6 +181,31 @@ namespace hull {
         return algorithms::jarvis_march(first, last, first2);
     }
     
+    /**
+     * Same as compute_convex_hull for Jarvis March, which also returns
+     * the metrics of the convex hull, accumulated as the hull is wrapped.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull, and its metrics.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    hull_result<RandomIt2> compute_convex_hull_with_metrics(jarvis_march_t policy, RandomIt1 first, RandomIt1 last, RandomIt2 first2) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        details::metrics::accumulator<> metrics;
+        if (std::distance(first, last) <= 1) {
+            if (first != last) {
+                metrics.push(0, *first);
+            }
+            return {std::copy(first, last, first2), metrics.result(static_cast<std::size_t>(std::distance(first, last)))};
+        }
+        
+        const auto last2 = algorithms::details::jarvis_march_impl(first, last, first2, metrics);
+        return {last2, metrics.result(static_cast<std::size_t>(std::distance(first2, last2)))};
+    }
+    
     namespace convex {
         /**
          * Overload of container-based convex hull computation for Jarvis March.
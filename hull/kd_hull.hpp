@@ -0,0 +1,255 @@
+/**
+ * Convex hulls of the points within axis-aligned rectangles (viewports
+ * of a map, for instance), for many rectangles over the same static set
+ * of points.
+ * The points are indexed by a kd-tree: each node splits its points at
+ * the median along the larger side of its bounding box, down to leaves
+ * of at most leaf_size points. Each node caches its bounding box and the
+ * convex hull of its points: the hulls of the leaves are computed with
+ * the policy of the tree, and the hulls of the other nodes are the
+ * linear-time merges of the hulls of their children (see hull_merge.hpp).
+ * A query:
+ * - skips the nodes whose bounding box does not meet the rectangle;
+ * - takes the cached hull of the nodes whose bounding box is inside the
+ *   rectangle, without visiting their points;
+ * - descends into the other nodes, down to the leaves, whose points are
+ *   filtered.
+ * The hulls found are merged with a reduction tree.
+ * The tree is built level by level, the nodes of a level being processed
+ * in parallel.
+ * Example:
+ *      <code>
+ *      const hull::kd_hull<point> index(std::begin(points), std::end(points), 0);
+ *      const auto convex_hull = index.query(point{x_min, y_min}, point{x_max, y_max});
+ *      </code>
+ */
+
+#ifndef kd_hull_h
+#define kd_hull_h
+
+#include "bounding_box.hpp"
+#include "hull_merge.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace hull {
+    /**
+     * Static index answering convex hull queries over axis-aligned rectangles.
+     * @param TPoint - the type of the points.
+     * @param Policy - the algorithm computing the hulls of the leaves.
+     */
+    template <typename TPoint, typename Policy = monotone_chain_t>
+    class kd_hull {
+    public:
+        using point_type = TPoint;
+        
+        /**
+         * The greatest number of points in a leaf of the tree.
+         */
+        static constexpr std::size_t leaf_size = 64;
+        
+        kd_hull() = default;
+        
+        /**
+         * Build the index of a set of points, in any order.
+         * Average time complexity: O(N * log(N) / T) where N is the number
+         * of points and T the number of threads.
+         * Average space complexity: O(N).
+         * @param first - the forward iterator to the first point.
+         * @param last - the forward iterator to the one-past last point.
+         * @param threads - the number of threads (0 for all hardware threads).
+         */
+        template <typename ForwardIt>
+        kd_hull(ForwardIt first, ForwardIt last, std::size_t threads = 1) : points_(first, last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            
+            if (points_.empty()) {
+                return ;
+            }
+            
+            // Top-down: the bounding boxes and the splits, one level at a time.
+            std::vector<std::array<std::size_t, 2>> levels;
+            nodes_.push_back(node{0, points_.size(), 0, TPoint{}, TPoint{}, {}});
+            for (std::array<std::size_t, 2> level{{0, 1}}; level[0] < level[1]; level = {{level[1], nodes_.size()}}) {
+                levels.push_back(level);
+                parallel::for_each_chunk(level[1] - level[0], threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (auto i = level[0] + begin; i < level[0] + end; i++) {
+                        split(nodes_[i]);
+                    }
+                });
+                for (auto i = level[0]; i < level[1]; i++) {
+                    const auto begin = nodes_[i].begin;
+                    const auto end = nodes_[i].end;
+                    if (end - begin > leaf_size) {
+                        const auto middle = begin + (end - begin) / 2;
+                        nodes_[i].child = nodes_.size();
+                        nodes_.push_back(node{begin, middle, 0, TPoint{}, TPoint{}, {}});
+                        nodes_.push_back(node{middle, end, 0, TPoint{}, TPoint{}, {}});
+                    }
+                }
+            }
+            
+            // Bottom-up: the convex hulls.
+            for (auto level = std::rbegin(levels); level != std::rend(levels); ++level) {
+                const auto level_begin = (*level)[0];
+                const auto level_end = (*level)[1];
+                parallel::for_each_chunk(level_end - level_begin, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (auto i = level_begin + begin; i < level_begin + end; i++) {
+                        auto& n = nodes_[i];
+                        if (n.child == 0) {
+                            n.hull = hull_of(std::begin(points_) + static_cast<std::ptrdiff_t>(n.begin),
+                                             std::begin(points_) + static_cast<std::ptrdiff_t>(n.end));
+                            continue;
+                        }
+                        const auto& a = nodes_[n.child].hull;
+                        const auto& b = nodes_[n.child + 1].hull;
+                        algorithms::merge_hulls(std::begin(a), std::end(a), std::begin(b), std::end(b), std::back_inserter(n.hull));
+                    }
+                });
+            }
+        }
+        
+        /**
+         * Container-based constructor.
+         * @param points - the points.
+         * @param threads - the number of threads (0 for all hardware threads).
+         */
+        template <typename TContainer>
+        explicit kd_hull(const TContainer& points, std::size_t threads = 1) :
+            kd_hull(std::begin(points), std::end(points), threads) {}
+        
+        /**
+         * Compute the convex hull of the points within a rectangle (borders included).
+         * Average time complexity: O(sqrt(N) * leaf_size + K * H) where N is the number of
+         * points, K the number of nodes taken and H the number of vertices of their hulls.
+         * @param min_corner - the corner of the rectangle with the lowest coordinates.
+         * @param max_corner - the corner of the rectangle with the greatest coordinates.
+         * @return - the vertices of the convex hull, in the same order as monotone_chain
+         *           (empty if no point is within the rectangle).
+         */
+        std::vector<TPoint> query(const TPoint& min_corner, const TPoint& max_corner) const {
+            if (nodes_.empty()) {
+                return {};
+            }
+            
+            std::vector<std::vector<TPoint>> hulls;
+            std::vector<TPoint> loose;
+            std::vector<std::size_t> stack{0};
+            while (!stack.empty()) {
+                const auto& n = nodes_[stack.back()];
+                stack.pop_back();
+                if (x(n.max_corner) < x(min_corner) || x(max_corner) < x(n.min_corner) ||
+                    y(n.max_corner) < y(min_corner) || y(max_corner) < y(n.min_corner))
+                {
+                    continue;
+                }
+                if (!(x(n.min_corner) < x(min_corner)) && !(x(max_corner) < x(n.max_corner)) &&
+                    !(y(n.min_corner) < y(min_corner)) && !(y(max_corner) < y(n.max_corner)))
+                {
+                    hulls.push_back(n.hull);
+                    continue;
+                }
+                if (n.child != 0) {
+                    stack.push_back(n.child);
+                    stack.push_back(n.child + 1);
+                    continue;
+                }
+                for (auto i = n.begin; i < n.end; i++) {
+                    const auto& p = points_[i];
+                    if (!(x(p) < x(min_corner)) && !(x(max_corner) < x(p)) && !(y(p) < y(min_corner)) && !(y(max_corner) < y(p))) {
+                        loose.push_back(p);
+                    }
+                }
+            }
+            if (!loose.empty()) {
+                hulls.push_back(hull_of(std::begin(loose), std::end(loose)));
+            }
+            return algorithms::merge_hull_tree(std::begin(hulls), std::end(hulls), 1);
+        }
+        
+        /**
+         * @return - the convex hull of all the points, in the same order as monotone_chain.
+         */
+        std::vector<TPoint> convex_hull() const {
+            return nodes_.empty() ? std::vector<TPoint>{} : nodes_.front().hull;
+        }
+        
+        /**
+         * @return - the number of points.
+         */
+        std::size_t size() const noexcept {
+            return points_.size();
+        }
+    
+    private:
+        /**
+         * Node of the tree: its points are [begin ; end) in points_, and its
+         * children (if any) are the nodes child and child + 1.
+         */
+        struct node {
+            std::size_t begin{};
+            std::size_t end{};
+            std::size_t child{};
+            TPoint min_corner{};
+            TPoint max_corner{};
+            std::vector<TPoint> hull;
+        };
+        
+        /**
+         * Compute the bounding box of a node and, if it is not a leaf, move
+         * the lower half of its points along the larger side before the other half.
+         */
+        void split(node& n) {
+            const auto first = std::begin(points_) + static_cast<std::ptrdiff_t>(n.begin);
+            const auto last = std::begin(points_) + static_cast<std::ptrdiff_t>(n.end);
+            std::array<TPoint, 4> box;
+            algorithms::bounding_box(first, last, std::begin(box));
+            n.min_corner = box[0];
+            n.max_corner = box[2];
+            if (n.end - n.begin <= leaf_size) {
+                return ;
+            }
+            
+            const auto middle = first + static_cast<std::ptrdiff_t>((n.end - n.begin) / 2);
+            if (y(n.max_corner) - y(n.min_corner) < x(n.max_corner) - x(n.min_corner)) {
+                std::nth_element(first, middle, last, [](const TPoint& p1, const TPoint& p2) { return x(p1) < x(p2); });
+            }
+            else {
+                std::nth_element(first, middle, last, [](const TPoint& p1, const TPoint& p2) { return y(p1) < y(p2); });
+            }
+        }
+        
+        /**
+         * @return - the convex hull of a few points with the policy of the
+         *           tree, in the same order as monotone_chain.
+         */
+        template <typename ForwardIt>
+        static std::vector<TPoint> hull_of(ForwardIt first, ForwardIt last) {
+            std::vector<TPoint> points(first, last);
+            std::vector<TPoint> scratch(2 * points.size());
+            scratch.erase(compute_convex_hull(Policy{}, std::begin(points), std::end(points), std::begin(scratch)), std::end(scratch));
+            if (scratch.empty() && first != last) {
+                scratch.push_back(*first);
+            }
+            
+            // Normalize the order, as if merged with an empty polygon.
+            std::vector<TPoint> convex_hull;
+            algorithms::merge_hulls(std::begin(scratch), std::end(scratch), std::begin(scratch), std::begin(scratch),
+                                    std::back_inserter(convex_hull));
+            return convex_hull;
+        }
+        
+        std::vector<TPoint> points_;
+        std::vector<node> nodes_;
+    };
+}
+
+#endif
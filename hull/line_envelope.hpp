@@ -0,0 +1,206 @@
+/**
+ * Lower envelope of a set of lines (the "convex hull trick").
+ * A line y = m * x + b is seen as the point (m, b): the point concept of
+ * this library is reused, x() being the slope and y() the intercept. At
+ * a given x, the lowest line minimizes the dot product of (m, b) with
+ * (x, 1). By duality, only the lines on the lower hull of the points
+ * (m, b) are ever the lowest (see half_hull.hpp); sorted by slope, their
+ * values at a given x are unimodal. Hence:
+ * - a query at any x is a binary search, in O(log(N));
+ * - a sequence of monotone queries walks along the envelope, in O(1)
+ *   amortized per query (see line_envelope::walker);
+ * - lines added online by non-decreasing slope update the envelope with
+ *   the Monotone Chain step, in O(1) amortized per line.
+ * For the upper envelope (the maximum), negate the slopes and the
+ * intercepts, and the values of the queries.
+ * Example:
+ *      <code>
+ *      std::vector<std::array<long long, 2>> lines = {{slope, intercept}, ...};
+ *      hull::line_envelope<std::array<long long, 2>> envelope(std::begin(lines), std::end(lines));
+ *      const auto best = envelope.minimum(x);
+ *      </code>
+ */
+
+#ifndef line_envelope_h
+#define line_envelope_h
+
+#include "angle.hpp"
+#include "half_hull.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace hull {
+    /**
+     * Lower envelope of lines given as points (slope, intercept).
+     */
+    template <typename TPoint>
+    class line_envelope {
+    public:
+        using line_type = TPoint;
+        using value_type = std::decay_t<coordinate_t<TPoint>>;
+        
+        /**
+         * Walker along the envelope for monotone sequences of queries
+         * (non-decreasing or non-increasing x): it starts from the line
+         * of the previous query, so that the whole sequence costs
+         * O(N + Q) for Q queries. It is invalidated by add.
+         */
+        class walker {
+        public:
+            /**
+             * @param envelope - the envelope to walk along.
+             */
+            explicit walker(const line_envelope& envelope) noexcept : envelope_(envelope) {}
+            
+            /**
+             * @param x - the abscissa of the query.
+             * @return - the lowest line at x.
+             * @throw std::out_of_range - if the envelope is empty.
+             */
+            const line_type& line(value_type x) {
+                const auto& lines = envelope_.check();
+                while (i_ > 0 && value(lines[i_ - 1], x) <= value(lines[i_], x)) {
+                    i_--;
+                }
+                while (i_ + 1 < lines.size() && value(lines[i_ + 1], x) < value(lines[i_], x)) {
+                    i_++;
+                }
+                return lines[i_];
+            }
+            
+            /**
+             * @param x - the abscissa of the query.
+             * @return - the minimum of the lines at x.
+             * @throw std::out_of_range - if the envelope is empty.
+             */
+            value_type minimum(value_type x) {
+                return value(line(x), x);
+            }
+        
+        private:
+            const line_envelope& envelope_;
+            std::size_t i_{};
+        };
+        
+        line_envelope() = default;
+        
+        /**
+         * Build the envelope of a set of lines, in any order.
+         * Average time complexity: O(N * log(N)) where N is the number of lines.
+         * @param first - the forward iterator to the first line.
+         * @param last - the forward iterator to the one-past last line.
+         */
+        template <typename ForwardIt>
+        line_envelope(ForwardIt first, ForwardIt last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            
+            std::vector<line_type> sorted(first, last);
+            lines_.resize(sorted.size());
+            lines_.erase(hull::lower_hull(std::begin(sorted), std::end(sorted), std::begin(lines_)), std::end(lines_));
+            
+            // Among the lines of the largest slope, only the lowest one matters.
+            if (lines_.size() >= 2 && hull::equals(x(lines_[lines_.size() - 2]), x(lines_.back()))) {
+                lines_.pop_back();
+            }
+        }
+        
+        /**
+         * Add a line online. Its slope must not be lower than the slopes
+         * of the lines added before.
+         * Average time complexity: O(1) amortized.
+         * @param line - the line (slope, intercept).
+         * @throw std::invalid_argument - if the slope is lower than the previous one.
+         */
+        void add(const line_type& line) {
+            if (!lines_.empty()) {
+                const auto& back = lines_.back();
+                if (x(line) < x(back)) {
+                    throw std::invalid_argument("the lines of an envelope must be added by non-decreasing slope");
+                }
+                if (hull::equals(x(line), x(back))) {
+                    if (!(y(line) < y(back))) {
+                        return ;
+                    }
+                    lines_.pop_back();
+                }
+            }
+            
+            while (lines_.size() >= 2 && cross(lines_[lines_.size() - 2], lines_.back(), line) <= 0) {
+                lines_.pop_back();
+            }
+            lines_.push_back(line);
+        }
+        
+        /**
+         * Average time complexity: O(log(N)) where N is the number of lines.
+         * @param x - the abscissa of the query.
+         * @return - the lowest line at x.
+         * @throw std::out_of_range - if the envelope is empty.
+         */
+        const line_type& line(value_type x) const {
+            const auto& lines = check();
+            std::size_t lo{};
+            auto hi = lines.size() - 1;
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+                if (value(lines[mid + 1], x) < value(lines[mid], x)) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+            return lines[lo];
+        }
+        
+        /**
+         * Average time complexity: O(log(N)) where N is the number of lines.
+         * @param x - the abscissa of the query.
+         * @return - the minimum of the lines at x.
+         * @throw std::out_of_range - if the envelope is empty.
+         */
+        value_type minimum(value_type x) const {
+            return value(line(x), x);
+        }
+        
+        /**
+         * @return - a walker for monotone sequences of queries.
+         */
+        walker walk() const noexcept {
+            return walker(*this);
+        }
+        
+        /**
+         * @return - the lines of the envelope, by increasing slope (that is,
+         *           from the lowest line at +infinity to the lowest at -infinity).
+         */
+        const std::vector<line_type>& lines() const noexcept {
+            return lines_;
+        }
+        
+        /**
+         * @return - the value of a line at x.
+         */
+        static value_type value(const line_type& line, value_type x) {
+            return hull::x(line) * x + hull::y(line);
+        }
+    
+    private:
+        const std::vector<line_type>& check() const {
+            if (lines_.empty()) {
+                throw std::out_of_range("the line envelope is empty");
+            }
+            return lines_;
+        }
+        
+        std::vector<line_type> lines_;
+    };
+}
+
+#endif
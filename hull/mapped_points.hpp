@@ -0,0 +1,452 @@
+/**
+ * Memory-mapped access to flat binary files of points.
+ * The expected layout is the simplest possible one: interleaved
+ * little-endian coordinates x0 y0 x1 y1 ... without any header.
+ * The coordinates may be float, double or int32_t.
+ * The file is mapped read-only: nothing is read at startup and the
+ * pages are shared with any other process mapping the same file.
+ * Example:
+ *      <code>
+ *      hull::io::mapped_points<double> points("dump.bin");
+ *      std::vector<std::array<double, 2>> convex_hull;
+ *      hull::convex::compute(hull::choice::jarvis_march, points, convex_hull);
+ *      </code>
+ */
+
+#ifndef mapped_points_h
+#define mapped_points_h
+
+#include "chan_algorithm.hpp"
+#include "graham_scan.hpp"
+#include "jarvis_march.hpp"
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hull::io {
+    /**
+     * Access pattern hints forwarded to madvise.
+     * @param sequential - the pages are read once, in order (read-ahead, early eviction).
+     * @param random - the pages are accessed in no particular order (no read-ahead).
+     * @param will_need - the pages should be paged in now.
+     */
+    enum class access_pattern {
+        sequential,
+        random,
+        will_need
+    };
+    
+    /**
+     * RAII read-only memory mapping of a whole file.
+     * An empty file is valid and results in an empty mapping.
+     */
+    class mapped_file {
+    public:
+        /**
+         * Map the file at the given path.
+         * @param path - the path to the file.
+         * @throw std::system_error - if the file cannot be opened or mapped.
+         */
+        explicit mapped_file(const std::string& path) {
+            const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+            }
+            
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                const auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "cannot stat " + path);
+            }
+            
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ != 0) {
+                auto address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+                if (address == MAP_FAILED) {
+                    const auto error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "cannot map " + path);
+                }
+                data_ = static_cast<const unsigned char*>(address);
+            }
+            
+            // The mapping keeps its own reference to the file.
+            ::close(fd);
+        }
+        
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+        
+        mapped_file(mapped_file&& other) noexcept
+            : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+        
+        mapped_file& operator=(mapped_file&& other) noexcept {
+            if (this != &other) {
+                unmap();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+        
+        ~mapped_file() {
+            unmap();
+        }
+        
+        /**
+         * @return - the first byte of the mapping (nullptr if empty).
+         */
+        const unsigned char* data() const noexcept {
+            return data_;
+        }
+        
+        /**
+         * @return - the size of the mapping in bytes.
+         */
+        std::size_t size() const noexcept {
+            return size_;
+        }
+        
+        /**
+         * Give a hint to the kernel about the way a range of the
+         * mapping is about to be accessed. This is only a hint:
+         * failures are silently ignored.
+         * @param pattern - the expected access pattern.
+         * @param offset - the offset of the range in bytes.
+         * @param length - the length of the range in bytes.
+         */
+        void advise(access_pattern pattern, std::size_t offset, std::size_t length) const noexcept {
+            if (data_ == nullptr || offset >= size_) {
+                return ;
+            }
+            
+            // madvise requires a page-aligned address.
+            static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const auto aligned = offset - offset % page;
+            length = std::min(length, size_ - offset) + (offset - aligned);
+            
+            auto address = const_cast<unsigned char*>(data_ + aligned);
+            ::madvise(address, length, to_advice(pattern));
+        }
+        
+        /**
+         * Same as above, for the whole mapping.
+         * @param pattern - the expected access pattern.
+         */
+        void advise(access_pattern pattern) const noexcept {
+            advise(pattern, 0, size_);
+        }
+    
+    private:
+        static int to_advice(access_pattern pattern) noexcept {
+            switch (pattern) {
+                case access_pattern::sequential: return MADV_SEQUENTIAL;
+                case access_pattern::random: return MADV_RANDOM;
+                case access_pattern::will_need: return MADV_WILLNEED;
+            }
+            return MADV_NORMAL;
+        }
+        
+        void unmap() noexcept {
+            if (data_ != nullptr) {
+                ::munmap(const_cast<unsigned char*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+        
+        const unsigned char* data_{};
+        std::size_t size_{};
+    };
+}
+
+namespace hull::io::details {
+    /**
+     * Tells whether T is one of the supported on-disk coordinate types.
+     */
+    template <typename T>
+    constexpr bool is_binary_coordinate_v() {
+        return std::is_same<T, float>::value ||
+               std::is_same<T, double>::value ||
+               std::is_same<T, std::int32_t>::value;
+    }
+    
+    /**
+     * Load a little-endian value from a possibly unaligned address.
+     * @param bytes - the address of the first byte of the value.
+     * @return - the value in the host byte order.
+     */
+    template <typename T>
+    T load_little_endian(const unsigned char* bytes) {
+        T value;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        unsigned char reversed[sizeof(T)];
+        std::reverse_copy(bytes, bytes + sizeof(T), reversed);
+        std::memcpy(&value, reversed, sizeof(T));
+#else
+        std::memcpy(&value, bytes, sizeof(T));
+#endif
+        return value;
+    }
+    
+    /**
+     * Store a value in little-endian byte order.
+     * @param value - the value to store.
+     * @param bytes - the address of the first destination byte.
+     */
+    template <typename T>
+    void store_little_endian(T value, unsigned char* bytes) {
+        std::memcpy(bytes, &value, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        std::reverse(bytes, bytes + sizeof(T));
+#endif
+    }
+}
+
+namespace hull::io {
+    /**
+     * Read-only random access range over a memory-mapped file of
+     * interleaved little-endian coordinates.
+     * The points are decoded on the fly: dereferencing an iterator
+     * returns a TPoint by value. Therefore, this range may be given
+     * directly to the algorithms which do not modify their input
+     * (Jarvis March, bounding box). The algorithms which reorder their
+     * input work on a private copy (see to_vector).
+     */
+    template <typename T, typename TPoint = std::array<T, 2>>
+    class mapped_points {
+        static_assert(details::is_binary_coordinate_v<T>(), "unsupported on-disk coordinate type");
+    
+    public:
+        using value_type = TPoint;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        
+        /**
+         * Size in bytes of a point in the file.
+         */
+        static constexpr std::size_t stride = 2 * sizeof(T);
+        
+        /**
+         * Random access iterator decoding the points on the fly.
+         */
+        class const_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = TPoint;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = TPoint;
+            
+            const_iterator() = default;
+            explicit const_iterator(const unsigned char* position) : position_{position} {}
+            
+            TPoint operator*() const {
+                return make_point<TPoint>(details::load_little_endian<T>(position_),
+                                          details::load_little_endian<T>(position_ + sizeof(T)));
+            }
+            
+            TPoint operator[](difference_type n) const {
+                return *(*this + n);
+            }
+            
+            const_iterator& operator++() { position_ += stride; return *this; }
+            const_iterator& operator--() { position_ -= stride; return *this; }
+            const_iterator operator++(int) { auto it = *this; ++*this; return it; }
+            const_iterator operator--(int) { auto it = *this; --*this; return it; }
+            
+            const_iterator& operator+=(difference_type n) {
+                position_ += n * static_cast<difference_type>(stride);
+                return *this;
+            }
+            
+            const_iterator& operator-=(difference_type n) {
+                return *this += -n;
+            }
+            
+            friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+            friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+            friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+            
+            friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+                return (a.position_ - b.position_) / static_cast<difference_type>(stride);
+            }
+            
+            friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.position_ == b.position_; }
+            friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.position_ != b.position_; }
+            friend bool operator<(const const_iterator& a, const const_iterator& b) { return a.position_ < b.position_; }
+            friend bool operator>(const const_iterator& a, const const_iterator& b) { return a.position_ > b.position_; }
+            friend bool operator<=(const const_iterator& a, const const_iterator& b) { return a.position_ <= b.position_; }
+            friend bool operator>=(const const_iterator& a, const const_iterator& b) { return a.position_ >= b.position_; }
+        
+        private:
+            const unsigned char* position_{};
+        };
+        
+        using iterator = const_iterator;
+        
+        /**
+         * Map the file at the given path. The whole file is
+         * advised for a sequential scan.
+         * @param path - the path to the file.
+         * @throw std::system_error - if the file cannot be mapped.
+         * @throw std::runtime_error - if the file size is not a multiple of the point size.
+         */
+        explicit mapped_points(const std::string& path) : file_{path} {
+            static_assert_is_point<TPoint>();
+            
+            if (file_.size() % stride != 0) {
+                throw std::runtime_error("truncated point file: " + path);
+            }
+            
+            file_.advise(access_pattern::sequential);
+        }
+        
+        const_iterator begin() const noexcept {
+            return const_iterator{file_.data()};
+        }
+        
+        const_iterator end() const noexcept {
+            return const_iterator{file_.data() + file_.size()};
+        }
+        
+        size_type size() const noexcept {
+            return file_.size() / stride;
+        }
+        
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+        
+        TPoint operator[](size_type i) const {
+            return begin()[static_cast<difference_type>(i)];
+        }
+        
+        /**
+         * Give a hint to the kernel about the way the points in
+         * [first ; first + count) are about to be accessed.
+         * @param pattern - the expected access pattern.
+         * @param first - the index of the first point.
+         * @param count - the number of points.
+         */
+        void advise(access_pattern pattern, size_type first, size_type count) const noexcept {
+            file_.advise(pattern, first * stride, count * stride);
+        }
+        
+        /**
+         * Same as above, for the whole file.
+         * @param pattern - the expected access pattern.
+         */
+        void advise(access_pattern pattern) const noexcept {
+            file_.advise(pattern);
+        }
+        
+        /**
+         * Decode the points into a private compact working set.
+         * This is what the algorithms which reorder their input use.
+         * @return - a vector containing all the points of the file.
+         */
+        std::vector<TPoint> to_vector() const {
+            std::vector<TPoint> points;
+            points.reserve(size());
+            std::copy(begin(), end(), std::back_inserter(points));
+            return points;
+        }
+    
+    private:
+        mapped_file file_;
+    };
+}
+
+namespace hull::convex {
+    /**
+     * Overload of container-based convex hull computation for Jarvis March
+     * on a memory-mapped file. Jarvis March does not modify its input: the
+     * mapping is scanned in place, without any copy, and only the vertices
+     * of the convex hull are appended to c2.
+     * @param c1 - the input mapped points.
+     * @param c2 - the destination container.
+     */
+    template <typename T, typename TPoint, typename TContainer2>
+    void compute(jarvis_march_t policy, const io::mapped_points<T, TPoint>& c1, TContainer2& c2) {
+        c2.clear();
+        
+        if (c1.size() <= 1) {
+            std::copy(std::begin(c1), std::end(c1), std::back_inserter(c2));
+            return ;
+        }
+        hull::algorithms::details::jarvis_march_impl(std::begin(c1), std::end(c1), std::back_inserter(c2));
+    }
+    
+    /**
+     * Overload of container-based convex hull computation for Graham Scan
+     * on a memory-mapped file. Graham Scan works in-place: the points are
+     * decoded once into c2, which is the working set.
+     * @param c1 - the input mapped points.
+     * @param c2 - the destination container.
+     */
+    template <typename T, typename TPoint, typename TContainer2>
+    void compute(graham_scan_t policy, const io::mapped_points<T, TPoint>& c1, TContainer2& c2) {
+        c2.resize(c1.size());
+        
+        std::copy(std::begin(c1), std::end(c1), std::begin(c2));
+        auto last = hull::algorithms::graham_scan(std::begin(c2), std::end(c2));
+        
+        c2.erase(last, std::end(c2));
+    }
+    
+    /**
+     * Overload of container-based convex hull computation for Monotone Chain
+     * on a memory-mapped file. The sort happens on a private working set,
+     * which is then scanned incrementally: only the convex hull is stored
+     * next to it, so that the peak memory is O(N + H).
+     * @param c1 - the input mapped points.
+     * @param c2 - the destination container.
+     */
+    template <typename T, typename TPoint, typename TContainer2>
+    void compute(monotone_chain_t policy, const io::mapped_points<T, TPoint>& c1, TContainer2& c2) {
+        auto points = c1.to_vector();
+        hull::algorithms::details::monotone::sort(std::begin(points), std::end(points));
+        
+        hull::algorithms::details::monotone::chain_builder<TPoint> chain;
+        for (const auto& p: points) {
+            chain.push(p);
+        }
+        
+        c2.resize(chain.size());
+        chain.copy(std::begin(c2));
+    }
+    
+    /**
+     * Overload of container-based convex hull computation for Chan
+     * on a memory-mapped file. The partitions are built on a private
+     * working set, and the output grows with the convex hull only.
+     * @param c1 - the input mapped points.
+     * @param c2 - the destination container.
+     */
+    template <typename T, typename TPoint, typename TContainer2>
+    void compute(chan_t policy, const io::mapped_points<T, TPoint>& c1, TContainer2& c2) {
+        compute(policy, c1.to_vector(), c2);
+    }
+}
+
+#endif
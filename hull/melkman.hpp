@@ -0,0 +1,223 @@
+/**
+ * Implementation of Melkman's algorithm for the convex hull of a
+ * simple polygon (or of a simple polyline) in the 2d space.
+ * When the input is already a simple polygon (building footprints,
+ * contours, GPS traces which do not cross themselves...), its vertex
+ * order is enough to build the convex hull: there is no need to sort
+ * the points. The hull is kept in a deque whose both ends are the last
+ * vertex read. A new vertex on the left of the 2 edges around it is
+ * inside the hull and skipped in O(1); otherwise, the vertices which
+ * are no longer convex are popped at both ends and it is pushed at
+ * both ends.
+ * Reference: A. Melkman, "On-line construction of the convex hull of a
+ * simple polyline", Information Processing Letters 25 (1987).
+ * The result is undefined if the polygon is not simple.
+ */
+
+#ifndef melkman_h
+#define melkman_h
+
+#include "angle.hpp"
+#include "metrics.hpp"
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+
+namespace hull::algorithms::details {
+    /**
+     * Compute the convex hull of a simple polygon with Melkman's algorithm.
+     * The convex hull is in counter-clockwise order, from its lowest point
+     * by x-coordinate (then y-coordinate), as with monotone_chain.
+     * Time complexity: O(N) where N is the number of vertices.
+     * Space complexity: O(H) where H is the number of points on the convex hull
+     * (of the vertices read so far).
+     * @param first - the forward iterator to the first vertex of the polygon.
+     * @param last - the forward iterator to the one-past last vertex of the polygon.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @param observer - the observer of the points emitted on the convex hull (see metrics.hpp).
+     * @return - the output iterator to the one-past last point of the convex hull.
+     */
+    template <
+        typename ForwardIt,
+        typename OutputIt,
+        typename Observer = hull::details::metrics::none,
+        typename TPoint = typename std::iterator_traits<ForwardIt>::value_type
+    >
+    OutputIt melkman_impl(ForwardIt first, ForwardIt last, OutputIt first2, Observer&& observer = Observer{}) {
+        const auto less = monotone::lexicographic_less{};
+        auto emit = [&first2, &observer](std::size_t k, const TPoint& p) {
+            *first2 = p;
+            ++first2;
+            observer.push(k, p);
+        };
+        
+        if (first == last) {
+            return first2;
+        }
+        
+        // The leading vertices collinear with the first 2 distinct ones
+        // only matter by their extremes a and b.
+        const TPoint p0 = *first;
+        TPoint a = p0;
+        TPoint b = p0;
+        auto it = std::next(first);
+        for (; it != last; ++it) {
+            if (hull::equals(a, b)) {
+                a = less(*it, p0) ? *it : p0;
+                b = less(*it, p0) ? p0 : *it;
+            }
+            else if (hull::equals(cross(a, b, *it), static_cast<decltype(cross(a, b, *it))>(0))) {
+                a = less(*it, a) ? *it : a;
+                b = less(b, *it) ? *it : b;
+            }
+            else {
+                break;
+            }
+        }
+        
+        if (it == last) {
+            emit(0, less(b, a) ? b : a);
+            if (!hull::equals(a, b)) {
+                emit(1, less(b, a) ? a : b);
+            }
+            return first2;
+        }
+        
+        // The deque is counter-clockwise from its front to its back, and
+        // its front and back are the last vertex pushed.
+        std::deque<TPoint> d;
+        const TPoint& v = *it;
+        if (cross(a, b, v) > 0) {
+            d.insert(std::end(d), {v, a, b, v});
+        }
+        else {
+            d.insert(std::end(d), {v, b, a, v});
+        }
+        
+        for (++it; it != last; ++it) {
+            const TPoint& p = *it;
+            const auto n = d.size();
+            if (cross(d[0], d[1], p) > 0 && cross(d[n - 2], d[n - 1], p) > 0) {
+                continue;
+            }
+            
+            while (d.size() >= 2 && cross(d[0], d[1], p) <= 0) {
+                d.pop_front();
+            }
+            d.push_front(p);
+            
+            while (d.size() >= 2 && cross(d[d.size() - 2], d[d.size() - 1], p) <= 0) {
+                d.pop_back();
+            }
+            d.push_back(p);
+        }
+        
+        // The back is the same vertex as the front. The last vertex read
+        // may be on the edge of its neighbours, once the polygon is closed.
+        d.pop_back();
+        if (d.size() >= 3 && cross(d.back(), d[0], d[1]) <= 0) {
+            d.pop_front();
+        }
+        const auto lowest = std::min_element(std::begin(d), std::end(d), less);
+        std::size_t k{};
+        for (auto p = lowest; p != std::end(d); ++p) {
+            emit(k++, *p);
+        }
+        for (auto p = std::begin(d); p != lowest; ++p) {
+            emit(k++, *p);
+        }
+        return first2;
+    }
+}
+
+namespace hull::algorithms {
+    /**
+     * Compute the convex hull of a simple polygon, or of a simple
+     * polyline, with Melkman's algorithm: the vertices are read once,
+     * in their order, without sorting them.
+     * The convex hull is the same as with monotone_chain.
+     * Time complexity: O(N) where N is the number of vertices.
+     * Space complexity: O(H) where H is the number of points on the convex hull.
+     * @param first - the forward iterator to the first vertex of the polygon.
+     * @param last - the forward iterator to the one-past last vertex of the polygon.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the output iterator to the one-past last point of the convex hull.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt melkman(ForwardIt first, ForwardIt last, OutputIt first2) {
+        static_assert_is_forward_iterator_to_point<ForwardIt>();
+        
+        return details::melkman_impl(first, last, first2);
+    }
+}
+
+namespace hull {
+    /**
+     * Compile-time enumeration to choose the
+     * algorithm thanks to a policy approach.
+     * @param simple_polygon_t - Melkman's algorithm, for simple polygons.
+     */
+    struct simple_polygon_t {};
+    
+    /**
+     * Algorithms policies to choose an overload.
+     * @param simple_polygon - Melkman's algorithm, for simple polygons.
+     */
+    namespace choice {
+        static constexpr const simple_polygon_t simple_polygon{};
+    }
+    
+    /**
+     * Overload of iterator-based convex hull computation for simple polygons.
+     * The input is not modified, and a std::back_insert_iterator may be used.
+     * Time complexity: O(N) where N is the number of vertices.
+     * Space complexity: O(H) where H is the number of points on the convex hull.
+     * @param first - the forward iterator to the first vertex of the polygon.
+     * @param last - the forward iterator to the one-past last vertex of the polygon.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the output iterator to the one-past last point of the convex hull.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    auto compute_convex_hull(simple_polygon_t policy, ForwardIt first, ForwardIt last, OutputIt first2) {
+        return algorithms::melkman(first, last, first2);
+    }
+    
+    /**
+     * Same as compute_convex_hull for simple polygons, which also returns
+     * the metrics of the convex hull, accumulated as the hull is emitted.
+     * @param first - the forward iterator to the first vertex of the polygon.
+     * @param last - the forward iterator to the one-past last vertex of the polygon.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the output iterator to the one-past last point of the convex hull, and its metrics.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    hull_result<OutputIt> compute_convex_hull_with_metrics(simple_polygon_t policy, ForwardIt first, ForwardIt last, OutputIt first2) {
+        static_assert_is_forward_iterator_to_point<ForwardIt>();
+        
+        details::metrics::accumulator<> metrics;
+        const auto last2 = algorithms::details::melkman_impl(first, last, first2, metrics);
+        return {last2, metrics.result(metrics.size())};
+    }
+    
+    namespace convex {
+        /**
+         * Overload of container-based convex hull computation for simple polygons.
+         * Time complexity: O(N) where N is the number of vertices.
+         * Space complexity: O(H) where H is the number of points on the convex hull.
+         * @param c1 - the input container (the vertices of a simple polygon, in order).
+         * @param c2 - the destination container.
+         */
+        template <typename TContainer1, typename TContainer2>
+        void compute(simple_polygon_t policy, const TContainer1& c1, TContainer2& c2) {
+            c2.clear();
+            hull::algorithms::melkman(std::begin(c1), std::end(c1), std::back_inserter(c2));
+        }
+    }
+}
+
+#endif
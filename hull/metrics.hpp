@@ -0,0 +1,213 @@
+/**
+ * Area, perimeter and centroid of a convex hull, computed while the
+ * hull is emitted instead of walking the output again.
+ * The algorithms build their hull as a stack: a vertex may be pushed,
+ * then popped by a later point. The accumulator keeps, in a few locals,
+ * the sums of the shoelace formula along the current stack. Pushing a
+ * vertex at position k first removes the edges of the popped vertices,
+ * read back from the stack of the algorithm itself (the output of
+ * Monotone Chain, the input of Graham Scan), then adds the new edge. The
+ * metrics of the final hull are the sums plus the closing edge.
+ * The sums are computed relative to the first vertex (and in double),
+ * so that coordinates far from the origin do not lose precision.
+ */
+
+#ifndef metrics_h
+#define metrics_h
+
+#include "point_concept.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace hull {
+    /**
+     * Metrics of a convex hull.
+     * @param area - the area of the polygon.
+     * @param perimeter - the perimeter of the closed polygon (twice the
+     *                    length of the segment for a degenerate hull).
+     * @param centroid_x - the x-coordinate of the centroid of the polygon (of the
+     *                     segment, or the point itself, for a degenerate hull).
+     * @param centroid_y - the y-coordinate of the centroid.
+     */
+    struct hull_metrics {
+        double area{};
+        double perimeter{};
+        double centroid_x{};
+        double centroid_y{};
+    };
+    
+    /**
+     * Result of a convex hull computation with its metrics.
+     * @param last - the iterator to the one-past last point of the convex hull.
+     * @param metrics - the metrics of the convex hull.
+     */
+    template <typename OutputIt>
+    struct hull_result {
+        OutputIt last;
+        hull_metrics metrics;
+    };
+}
+
+namespace hull::details::metrics {
+    /**
+     * Observer of the hull stacks which does nothing: the algorithms
+     * take an observer, so that the plain versions pay nothing.
+     */
+    struct none {
+        template <typename TPoint>
+        constexpr void push(std::size_t, const TPoint&) noexcept {}
+    };
+    
+    /**
+     * Stack of the algorithms which never pop a vertex: it is never read.
+     */
+    struct no_stack {};
+    
+    /**
+     * Running sums of the metrics along the stack of a convex hull.
+     * @param Stack - called with a position, returns the vertex at this position of
+     *                the stack of the algorithm, before the push which overwrites it.
+     */
+    template <typename Stack = no_stack>
+    class accumulator {
+    public:
+        /**
+         * @param stack - the stack of the algorithm, read when vertices are popped.
+         */
+        explicit accumulator(Stack stack = Stack{}) : stack_{stack} {}
+        
+        /**
+         * Record the vertex at position k of the stack (the positions
+         * from k are popped).
+         * @param k - the position of the vertex.
+         * @param p - the vertex.
+         */
+        template <typename TPoint>
+        void push(std::size_t k, const TPoint& p) {
+            if (k == 0) {
+                origin_x_ = static_cast<double>(x(p));
+                origin_y_ = static_cast<double>(y(p));
+                sums_ = {};
+                last_ = {};
+                size_ = 1;
+                return ;
+            }
+            if (k < size_) {
+                last_ = pop(k, sums_);
+            }
+            
+            const auto e = relative(p);
+            add_edge(last_, e, sums_, 1.);
+            last_ = e;
+            size_ = k + 1;
+        }
+        
+        /**
+         * @return - the size of the stack after the last push.
+         */
+        std::size_t size() const noexcept {
+            return size_;
+        }
+        
+        /**
+         * Close the polygon made of the first n vertices of the stack.
+         * @param n - the number of vertices of the convex hull.
+         * @return - the metrics of the convex hull.
+         */
+        hull_metrics result(std::size_t n) const {
+            hull_metrics metrics;
+            if (n == 0 || size_ < n || (n < size_ && std::is_same_v<Stack, no_stack>)) {
+                return metrics;
+            }
+            
+            auto sums = sums_;
+            auto last = last_;
+            if (n < size_) {
+                last = pop(n, sums);
+            }
+            add_edge(last, vertex{}, sums, 1.);
+            
+            // The clockwise hulls have a negative signed area.
+            metrics.area = std::abs(sums.area2) / 2.;
+            metrics.perimeter = sums.perimeter;
+            if (sums.area2 != 0.) {
+                metrics.centroid_x = sums.moment_x / (3. * sums.area2);
+                metrics.centroid_y = sums.moment_y / (3. * sums.area2);
+            }
+            else if (sums.perimeter != 0.) {
+                metrics.centroid_x = sums.length_x / sums.perimeter;
+                metrics.centroid_y = sums.length_y / sums.perimeter;
+            }
+            metrics.centroid_x += origin_x_;
+            metrics.centroid_y += origin_y_;
+            return metrics;
+        }
+    
+    private:
+        /**
+         * @param area2 - twice the signed area (shoelace formula).
+         * @param moment_x, moment_y - the first moments, times 6.
+         * @param length_x, length_y - the middles of the edges weighted by their lengths.
+         */
+        struct sums_t {
+            double area2{};
+            double perimeter{};
+            double moment_x{};
+            double moment_y{};
+            double length_x{};
+            double length_y{};
+        };
+        
+        struct vertex {
+            double x{};
+            double y{};
+        };
+        
+        template <typename TPoint>
+        vertex relative(const TPoint& p) const {
+            return {static_cast<double>(x(p)) - origin_x_, static_cast<double>(y(p)) - origin_y_};
+        }
+        
+        /**
+         * Remove from the sums the edges of the stack after the vertex k - 1,
+         * the last one first.
+         * @return - the vertex k - 1, which is the top of the stack.
+         */
+        vertex pop(std::size_t k, sums_t& sums) const {
+            auto b = last_;
+            if constexpr (!std::is_same_v<Stack, no_stack>) {
+                for (auto i = size_ - 1; i >= k; i--) {
+                    const auto a = relative(stack_(i - 1));
+                    add_edge(a, b, sums, -1.);
+                    b = a;
+                }
+            }
+            return b;
+        }
+        
+        /**
+         * Add (sign 1) or remove (sign -1) the edge from a to b.
+         */
+        static void add_edge(const vertex& a, const vertex& b, sums_t& sums, double sign) {
+            const auto c = a.x * b.y - b.x * a.y;
+            const auto length = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+            sums.area2 += sign * c;
+            sums.perimeter += sign * length;
+            sums.moment_x += sign * (a.x + b.x) * c;
+            sums.moment_y += sign * (a.y + b.y) * c;
+            sums.length_x += sign * (a.x + b.x) / 2. * length;
+            sums.length_y += sign * (a.y + b.y) / 2. * length;
+        }
+        
+        Stack stack_;
+        sums_t sums_{};
+        vertex last_{};
+        std::size_t size_{};
+        double origin_x_{};
+        double origin_y_{};
+    };
+}
+
+#endif
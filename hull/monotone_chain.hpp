@@ -7,13 +7,28 @@
 #define monotone_chain_h
 
 #include "angle.hpp"
+#include "metrics.hpp"
 #include "point_concept.hpp"
+#include "small_hull.hpp"
 #include "static_assert.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <tuple>
+#include <vector>
 
 namespace hull::algorithms::details::monotone {
+    /**
+     * Order of the points in Monotone Chain: by x-coordinate (in case
+     * of a tie, by y-coordinate).
+     */
+    struct lexicographic_less {
+        template <typename TPoint>
+        constexpr bool operator()(const TPoint& p1, const TPoint& p2) const {
+            return (x(p1) < x(p2) || (hull::equals(x(p1), x(p2)) && y(p1) < y(p2)));
+        }
+    };
+    
     /**
      * Sort the points of P by x-coordinate (in case of a tie, sort by y-coordinate).
      * @param first - the random access iterator to the first point of the container.
@@ -21,9 +36,26 @@ namespace hull::algorithms::details::monotone {
      */
     template <typename RandomIt>
     void sort(RandomIt first, RandomIt last) {
-        std::sort(first, last, [](const auto& p1, const auto& p2) {
-            return (x(p1) < x(p2) || (hull::equals(x(p1), x(p2)) && y(p1) < y(p2)));
-        });
+        std::sort(first, last, lexicographic_less{});
+    }
+    
+    /**
+     * Same as sort, with an insertion sort: for a handful of points, it
+     * beats the generic sort, and it is usable in constant expressions.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     */
+    template <typename RandomIt>
+    constexpr void insertion_sort(RandomIt first, RandomIt last) {
+        const auto less = lexicographic_less{};
+        for (auto it = first; it != last; ++it) {
+            auto p = *it;
+            auto hole = it;
+            for (; hole != first && less(p, *(hole - 1)); --hole) {
+                *hole = *(hole - 1);
+            }
+            *hole = p;
+        }
     }
     
     /**
@@ -38,7 +70,7 @@ namespace hull::algorithms::details::monotone {
      *           the point at first+i is on the left of vector first2+(k-2) first2+(k-1).
      */
     template <typename RandomIt1, typename RandomIt2>
-    auto no_counter_clockwise(std::size_t& k, RandomIt1 first, RandomIt2 first2) {
+    constexpr auto no_counter_clockwise(std::size_t& k, RandomIt1 first, RandomIt2 first2) {
         return [&k, first, first2](auto i) {
             return cross(*(first2 + (k - 2)), *(first2 + (k - 1)), *(first + i)) <= 0;
         };
@@ -51,11 +83,14 @@ namespace hull::algorithms::details::monotone {
      * @param k - the number of points in the resulting convex hull.
      * @param first - iterator to the first point in the input container of points.
      * @param first2 - iterator to the first point in the resulting convex hull.
+     * @param observer - the observer of the pushes on the convex hull (see metrics.hpp).
      * @return - a lambda function which copies first+i to first2+k.
      */
-    template <typename RandomIt1, typename RandomIt2>
-    auto copy(std::size_t& k, RandomIt1 first, RandomIt2 first2) {
-        return [&k, first, first2](auto i) {
+    template <typename RandomIt1, typename RandomIt2, typename Observer>
+    constexpr auto copy(std::size_t& k, RandomIt1 first, RandomIt2 first2, Observer& observer) {
+        return [&k, first, first2, &observer](auto i) {
+            // The observer may read the popped vertices before they are overwritten.
+            observer.push(k, *(first + i));
             *(first2 + k) = *(first + i);
             k++;
         };
@@ -67,12 +102,13 @@ namespace hull::algorithms::details::monotone {
      * @param last - the random access iterator to the one-past last point of the container.
      * @param first2 - the random access iterator to the first point of the destination container.
      * @param k - this will be the number of points on the convex hull.
+     * @param observer - the observer of the pushes on the convex hull.
      * @return - a tuple containing all the dependencies of the lower and upper hull algorithms.
      */
-    template <typename RandomIt1, typename RandomIt2>
-    auto get_dependencies(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t& k) {
+    template <typename RandomIt1, typename RandomIt2, typename Observer>
+    constexpr auto get_dependencies(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t& k, Observer& observer) {
         return std::make_tuple(no_counter_clockwise(k, first, first2),
-                               copy(k, first, first2),
+                               copy(k, first, first2, observer),
                                std::distance(first, last));
     }
     
@@ -82,10 +118,11 @@ namespace hull::algorithms::details::monotone {
      * @param last - the random access iterator to the one-past last point of the container.
      * @param first2 - the random access iterator to the first point of the destination container.
      * @param k - this will be the number of points on the lower hull.
+     * @param observer - the observer of the pushes on the convex hull.
      */
-    template <typename RandomIt1, typename RandomIt2>
-    void lower_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t& k) {
-        const auto [no_counter_clockwise, copy, N] = get_dependencies(first, last, first2, k);
+    template <typename RandomIt1, typename RandomIt2, typename Observer = hull::details::metrics::none>
+    constexpr void lower_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t& k, Observer&& observer = Observer{}) {
+        const auto [no_counter_clockwise, copy, N] = get_dependencies(first, last, first2, k, observer);
         
         for (int i{}; i < N; i++) {
             while (k >= 2 && no_counter_clockwise(i)) {
@@ -94,17 +131,18 @@ namespace hull::algorithms::details::monotone {
             copy(i);
         }
     }
-
+    
     /**
      * Compute the upper hull of the convex hull.
      * @param first - the random access iterator to the first point of the container.
      * @param last - the random access iterator to the one-past last point of the container.
      * @param first2 - the random access iterator to the first point of the destination container.
      * @param k - this will be the number of points on the upper hull.
+     * @param observer - the observer of the pushes on the convex hull.
      */
-    template <typename RandomIt1, typename RandomIt2>
-    void upper_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t& k) {
-        const auto [no_counter_clockwise, copy, N] = get_dependencies(first, last, first2, k);
+    template <typename RandomIt1, typename RandomIt2, typename Observer = hull::details::metrics::none>
+    constexpr void upper_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2, std::size_t& k, Observer&& observer = Observer{}) {
+        const auto [no_counter_clockwise, copy, N] = get_dependencies(first, last, first2, k, observer);
         
         auto t = k + 1;
         for (int i{static_cast<int>(N - 2)}; i >= 0; i--) {
@@ -116,6 +154,67 @@ namespace hull::algorithms::details::monotone {
     }
 }
 
+namespace hull::algorithms::details::monotone {
+    /**
+     * Incremental version of Monotone Chain for points which arrive
+     * already sorted (see lexicographic_less), for instance from an
+     * external merge of sorted runs. The lower and upper hulls are
+     * maintained at the same time, so that the points are read once
+     * and never stored: the memory is O(H) where H is the number of
+     * points on the convex hull.
+     */
+    template <typename TPoint>
+    class chain_builder {
+    public:
+        /**
+         * Add the next point. Consecutive duplicates are ignored.
+         * @param p - a point not lower than the previous ones.
+         */
+        void push(const TPoint& p) {
+            if (!lower_.empty() && hull::equals(lower_.back(), p)) {
+                return ;
+            }
+            
+            while (lower_.size() >= 2 && cross(lower_[lower_.size() - 2], lower_.back(), p) <= 0) {
+                lower_.pop_back();
+            }
+            lower_.push_back(p);
+            
+            while (upper_.size() >= 2 && cross(upper_[upper_.size() - 2], upper_.back(), p) >= 0) {
+                upper_.pop_back();
+            }
+            upper_.push_back(p);
+        }
+        
+        /**
+         * @return - the number of points on the current convex hull.
+         */
+        std::size_t size() const noexcept {
+            return lower_.empty() ? 0 : std::max<std::size_t>(1, lower_.size() + upper_.size() - 2);
+        }
+        
+        /**
+         * Copy the convex hull of the points pushed so far, in the same
+         * order as monotone_chain (counter-clockwise, from the lowest point).
+         * @param first2 - the output iterator to the first point of the destination container.
+         * @return - the iterator to the one-past last point of the convex hull.
+         */
+        template <typename OutputIt>
+        OutputIt copy(OutputIt first2) const {
+            if (lower_.size() <= 1) {
+                return std::copy(std::begin(lower_), std::end(lower_), first2);
+            }
+            
+            first2 = std::copy(std::begin(lower_), std::end(lower_), first2);
+            return std::copy(std::next(std::rbegin(upper_)), std::prev(std::rend(upper_)), first2);
+        }
+    
+    private:
+        std::vector<TPoint> lower_;
+        std::vector<TPoint> upper_;
+    };
+}
+
 namespace hull::algorithms::details {
     /**
      * Compute the convex hull of a container of points following
@@ -128,16 +227,17 @@ namespace hull::algorithms::details {
      * @param first - the random access iterator to the first point of the container.
      * @param last - the random access iterator to the one-past last point of the container.
      * @param first2 - the random access iterator to the first point of the destination container.
+     * @param observer - the observer of the pushes on the convex hull (see metrics.hpp).
      * @return - the iterator to the last element forming the convex hull of the
      *           provided container of points.
      */
-    template <typename RandomIt1, typename RandomIt2>
-    RandomIt2 monotone_chain_impl(RandomIt1 first, RandomIt1 last, RandomIt2 first2) {
+    template <typename RandomIt1, typename RandomIt2, typename Observer = hull::details::metrics::none>
+    RandomIt2 monotone_chain_impl(RandomIt1 first, RandomIt1 last, RandomIt2 first2, Observer&& observer = Observer{}) {
         monotone::sort(first, last);
         
         std::size_t k{};
-        monotone::lower_hull(first, last, first2, k);
-        monotone::upper_hull(first, last, first2, k);
+        monotone::lower_hull(first, last, first2, k, observer);
+        monotone::upper_hull(first, last, first2, k, observer);
         
         return first2 + (k - 1);
     }
@@ -148,6 +248,8 @@ namespace hull::algorithms {
      * Compute the convex hull of a container of points following
      * the Monotone Chain algorithm. This algorithm does not work in-place, but
      * it still modifies the input points (it sorts them by x-coordinates).
+     * Up to 16 points, a fixed-size kernel is used instead (see small_hull.hpp),
+     * which leaves the input points untouched.
      * Average time complexity: O(N * log(N)) where N is the number of
      * points.
      * Average space complexity: O(3 * N).
@@ -167,6 +269,9 @@ namespace hull::algorithms {
         if (N <= 1) {
             return std::copy(first, last, first2);
         }
+        if (N <= static_cast<decltype(N)>(details::small::max_size)) {
+            return details::small::small_hull(first, last, first2);
+        }
         
         return details::monotone_chain_impl(first, last, first2);
     }
@@ -209,6 +314,33 @@ namespace hull {
         return algorithms::monotone_chain(first, last, first2);
     }
     
+    /**
+     * Same as compute_convex_hull for Monotone Chain, which also returns
+     * the metrics of the convex hull, accumulated during the scan.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull, and its metrics.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    hull_result<RandomIt2> compute_convex_hull_with_metrics(monotone_chain_t policy, RandomIt1 first, RandomIt1 last, RandomIt2 first2) {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        const auto N = static_cast<std::size_t>(std::distance(first, last));
+        // The stack is the output.
+        details::metrics::accumulator metrics([first2](std::size_t k) { return *(first2 + k); });
+        if (N <= 1) {
+            if (N == 1) {
+                metrics.push(0, *first);
+            }
+            return {std::copy(first, last, first2), metrics.result(N)};
+        }
+        
+        const auto last2 = algorithms::details::monotone_chain_impl(first, last, first2, metrics);
+        return {last2, metrics.result(static_cast<std::size_t>(std::distance(first2, last2)))};
+    }
+    
     namespace convex {
         /**
          * Overload of container-based convex hull computation for Monotone Chain.
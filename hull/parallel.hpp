@@ -0,0 +1,226 @@
+/**
+ * Tiny fork-join facility on top of std::thread.
+ * The algorithms of this library are mono-threaded. The helpers
+ * below only split an index range into contiguous chunks and run
+ * one chunk per thread, which is all the batch and I/O facilities
+ * need. The bounded single-producer single-consumer queue joins
+ * the stages of a pipeline.
+ */
+
+#ifndef parallel_h
+#define parallel_h
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hull::parallel {
+    /**
+     * @return - the number of hardware threads (at least 1).
+     */
+    inline std::size_t hardware_threads() {
+        const auto n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : static_cast<std::size_t>(n);
+    }
+    
+    /**
+     * Normalize a requested number of threads: 0 means "all the
+     * hardware threads", and there is no point in having more
+     * threads than work items.
+     * @param threads - the requested number of threads.
+     * @param count - the number of work items.
+     * @return - the number of threads to use (at least 1).
+     */
+    inline std::size_t thread_count(std::size_t threads, std::size_t count) {
+        if (threads == 0) {
+            threads = hardware_threads();
+        }
+        return std::max<std::size_t>(1, std::min(threads, count));
+    }
+    
+    /**
+     * Split [0 ; count) into contiguous chunks of nearly equal size
+     * and call f(chunk, first, last) for each chunk, each one in its
+     * own thread. The calling thread processes the first chunk.
+     * If a call throws, the first exception is rethrown once all the
+     * threads are joined.
+     * @param count - the number of work items.
+     * @param threads - the number of chunks (0 for all hardware threads).
+     * @param f - the function object called for each chunk.
+     * @return - the number of chunks actually used.
+     */
+    template <typename F>
+    std::size_t for_each_chunk(std::size_t count, std::size_t threads, F f) {
+        const auto chunks = thread_count(threads, count);
+        std::vector<std::exception_ptr> errors(chunks);
+        
+        auto run = [&f, &errors, count, chunks](std::size_t i) {
+            try {
+                f(i, count * i / chunks, count * (i + 1) / chunks);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (std::size_t i{1}; i < chunks; i++) {
+            workers.emplace_back(run, i);
+        }
+        run(0);
+        
+        for (auto& worker: workers) {
+            worker.join();
+        }
+        
+        for (const auto& error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        
+        return chunks;
+    }
+    
+    /**
+     * Wait a little bit before trying again, in a polling loop: spin for
+     * the first attempts, then yield, then sleep.
+     * @param attempt - the number of failed attempts so far.
+     */
+    inline void backoff(std::size_t attempt) {
+        if (attempt < 16) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_ia32_pause();
+#endif
+        }
+        else if (attempt < 64) {
+            std::this_thread::yield();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    
+    /**
+     * Bounded lock-free queue between exactly one producer thread and
+     * one consumer thread. The blocking operations poll with backoff:
+     * they are meant for coarse items (chunks of points), not for
+     * fine-grained messages.
+     * The producer closes the queue once it is done. Either side may
+     * cancel it, which makes all the pending and future operations fail
+     * (this is how an error in one stage stops the whole pipeline).
+     */
+    template <typename T>
+    class spsc_queue {
+    public:
+        /**
+         * @param capacity - the maximum number of items in the queue (at least 1).
+         */
+        explicit spsc_queue(std::size_t capacity) : slots_(std::max<std::size_t>(1, capacity) + 1) {}
+        
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+        
+        /**
+         * Push an item if the queue is not full (producer side).
+         * @param value - the item; it is moved from only on success.
+         * @return - true if the item was pushed.
+         */
+        bool try_push(T& value) {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            const auto next = increment(tail);
+            if (next == head_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            slots_[tail] = std::move(value);
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+        
+        /**
+         * Pop an item if the queue is not empty (consumer side).
+         * @param value - the popped item.
+         * @return - true if an item was popped.
+         */
+        bool try_pop(T& value) {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = std::move(slots_[head]);
+            head_.store(increment(head), std::memory_order_release);
+            return true;
+        }
+        
+        /**
+         * Push an item, waiting while the queue is full (producer side).
+         * @param value - the item.
+         * @return - false if the queue was cancelled.
+         */
+        bool push(T value) {
+            for (std::size_t attempt{}; !try_push(value); attempt++) {
+                if (cancelled()) {
+                    return false;
+                }
+                backoff(attempt);
+            }
+            return true;
+        }
+        
+        /**
+         * Pop an item, waiting while the queue is empty (consumer side).
+         * @param value - the popped item.
+         * @return - false if the queue is closed and drained, or cancelled.
+         */
+        bool pop(T& value) {
+            for (std::size_t attempt{}; !try_pop(value); attempt++) {
+                if (cancelled()) {
+                    return false;
+                }
+                if (closed_.load(std::memory_order_acquire)) {
+                    // The last items may have been pushed just before closing.
+                    return try_pop(value);
+                }
+                backoff(attempt);
+            }
+            return true;
+        }
+        
+        /**
+         * Tell the consumer that no more items will be pushed (producer side).
+         */
+        void close() noexcept {
+            closed_.store(true, std::memory_order_release);
+        }
+        
+        /**
+         * Make all the pending and future operations fail (either side).
+         */
+        void cancel() noexcept {
+            cancelled_.store(true, std::memory_order_release);
+        }
+        
+        bool cancelled() const noexcept {
+            return cancelled_.load(std::memory_order_acquire);
+        }
+    
+    private:
+        std::size_t increment(std::size_t i) const noexcept {
+            return (i + 1 == slots_.size()) ? 0 : i + 1;
+        }
+        
+        std::vector<T> slots_;
+        alignas(64) std::atomic<std::size_t> head_{};
+        alignas(64) std::atomic<std::size_t> tail_{};
+        std::atomic<bool> closed_{};
+        std::atomic<bool> cancelled_{};
+    };
+}
+
+#endif
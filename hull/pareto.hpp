@@ -0,0 +1,247 @@
+/**
+ * Pareto front (skyline) of a set of points: the points which are not
+ * dominated by another one, a point dominating another one if it is at
+ * least as good along both axes and better along one of them. The
+ * directions tell whether each coordinate is maximized or minimized.
+ * Once the points are sorted with lexicographic_less, the front is a
+ * single scan, as with Monotone Chain: the points are visited from the
+ * best x-coordinate to the worst one, and a point is on the front if its
+ * y-coordinate is better than the ones of all the points visited before.
+ * The convex Pareto front is the part of the convex hull within the
+ * dominating quadrant: the vertices of the hull which are on the front.
+ * It is one chain of the hull of the front (see half_hull.hpp): the upper
+ * one if y is maximized, the lower one otherwise.
+ * Both fronts are sorted by increasing x-coordinate.
+ * As with half_hull.hpp, each function has a presorted variant and a
+ * parallel variant: each thread computes the front of a contiguous chunk
+ * of the points, then a last scan runs on the concatenated fronts.
+ * Example:
+ *      <code>
+ *      std::vector<point> front(candidates.size());
+ *      front.erase(hull::pareto_front(std::begin(candidates), std::end(candidates), std::begin(front),
+ *                                     hull::pareto_directions{true, false}),
+ *                  std::end(front));
+ *      </code>
+ */
+
+#ifndef pareto_h
+#define pareto_h
+
+#include "angle.hpp"
+#include "half_hull.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace hull {
+    /**
+     * Directions of a Pareto front.
+     * @param maximize_x - true if the greatest x-coordinate is the best, false if it is the lowest.
+     * @param maximize_y - true if the greatest y-coordinate is the best, false if it is the lowest.
+     */
+    struct pareto_directions {
+        bool maximize_x{true};
+        bool maximize_y{true};
+    };
+}
+
+namespace hull::algorithms::details::pareto {
+    /**
+     * Compute the Pareto front of sorted points.
+     * Among points with the same x-coordinate, only the one with the best
+     * y-coordinate may be on the front, and duplicates are kept once.
+     * Time complexity: O(N) where N is the number of points.
+     * @param first - the random access iterator to the first point (sorted with lexicographic_less).
+     * @param last - the random access iterator to the one-past last point.
+     * @param first2 - the random access iterator to the first point of the front.
+     * @param directions - the directions of the front.
+     * @return - the number of points on the front, sorted by increasing x-coordinate.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    std::size_t front(RandomIt1 first, RandomIt1 last, RandomIt2 first2, const pareto_directions& directions) {
+        const auto N = static_cast<std::size_t>(std::distance(first, last));
+        auto at = [first](std::size_t i) -> decltype(*first) {
+            return *(first + static_cast<std::ptrdiff_t>(i));
+        };
+        
+        std::size_t k{};
+        auto visit = [&](std::size_t begin, std::size_t end) {
+            // The points of [begin ; end] have the same x-coordinate, by increasing y-coordinate.
+            const auto& p = at(directions.maximize_y ? end : begin);
+            if (k > 0) {
+                const auto& best = *(first2 + static_cast<std::ptrdiff_t>(k - 1));
+                if (directions.maximize_y ? !(y(best) < y(p)) : !(y(p) < y(best))) {
+                    return ;
+                }
+            }
+            *(first2 + static_cast<std::ptrdiff_t>(k)) = p;
+            k++;
+        };
+        
+        if (directions.maximize_x) {
+            for (auto end = N; end > 0; ) {
+                auto begin = end - 1;
+                for (; begin > 0 && hull::equals(x(at(begin - 1)), x(at(end - 1))); begin--) {}
+                visit(begin, end - 1);
+                end = begin;
+            }
+            std::reverse(first2, first2 + static_cast<std::ptrdiff_t>(k));
+        }
+        else {
+            for (std::size_t begin{}; begin < N; ) {
+                auto end = begin;
+                for (; end + 1 < N && hull::equals(x(at(end + 1)), x(at(begin))); end++) {}
+                visit(begin, end);
+                begin = end + 1;
+            }
+        }
+        return k;
+    }
+    
+    /**
+     * Compute the Pareto front, with the given number of threads.
+     * A point which is dominated within a subset is dominated within the
+     * whole set, so that the chunks may be scanned on their own.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @param directions - the directions of the front.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the number of points on the front.
+     */
+    template <bool Sorted, typename RandomIt1, typename RandomIt2>
+    std::size_t compute(RandomIt1 first, RandomIt1 last, RandomIt2 first2, const pareto_directions& directions,
+                        std::size_t threads)
+    {
+        return half_hull::chunked_scan<Sorted>(first, last, first2, threads,
+            [&directions](auto front_first, auto front_last, auto front_first2) {
+                return front(front_first, front_last, front_first2, directions);
+            });
+    }
+    
+    /**
+     * Restrict a Pareto front to the vertices of the convex hull, in place.
+     * @param first2 - the random access iterator to the first point of the front.
+     * @param size - the number of points on the front.
+     * @param directions - the directions of the front.
+     * @return - the iterator to the one-past last point of the convex front.
+     */
+    template <typename RandomIt>
+    RandomIt convex(RandomIt first2, std::size_t size, const pareto_directions& directions) {
+        const auto last = first2 + static_cast<std::ptrdiff_t>(size);
+        const auto k = directions.maximize_y ? half_hull::chain<true>(first2, last, first2)
+                                             : half_hull::chain<false>(first2, last, first2);
+        return first2 + static_cast<std::ptrdiff_t>(k);
+    }
+}
+
+namespace hull {
+    /**
+     * Compute the Pareto front of a container of points. The points are
+     * reordered in place, as with lower_hull (see half_hull.hpp).
+     * Average time complexity: O(N * log(N) / T) where N is the number of
+     * points and T the number of threads.
+     * Average space complexity: O(N).
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param directions - the directions of the front.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the front, sorted by increasing x-coordinate.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 pareto_front(RandomIt1 first, RandomIt1 last, RandomIt2 first2, const pareto_directions& directions = {},
+                           std::size_t threads = 1)
+    {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        const auto k = algorithms::details::pareto::compute<false>(first, last, first2, directions, threads);
+        return first2 + static_cast<std::ptrdiff_t>(k);
+    }
+    
+    /**
+     * Compute the Pareto front of points already sorted with lexicographic_less.
+     * The input is not modified.
+     * Average time complexity: O(N / T) where N is the number of points
+     * and T the number of threads.
+     * Average space complexity: O(F * T) where F is the number of points on the front.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param directions - the directions of the front.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the front, sorted by increasing x-coordinate.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 pareto_front(presorted_t, RandomIt1 first, RandomIt1 last, RandomIt2 first2,
+                           const pareto_directions& directions = {}, std::size_t threads = 1)
+    {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        const auto k = algorithms::details::pareto::compute<true>(first, last, first2, directions, threads);
+        return first2 + static_cast<std::ptrdiff_t>(k);
+    }
+    
+    /**
+     * Compute the convex Pareto front of a container of points: the vertices
+     * of the convex hull which are on the Pareto front. The points are
+     * reordered in place, as with lower_hull (see half_hull.hpp).
+     * Average time complexity: O(N * log(N) / T) where N is the number of
+     * points and T the number of threads.
+     * Average space complexity: O(N).
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param directions - the directions of the front.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the front, sorted by increasing x-coordinate.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 convex_pareto_front(RandomIt1 first, RandomIt1 last, RandomIt2 first2,
+                                  const pareto_directions& directions = {}, std::size_t threads = 1)
+    {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        const auto k = algorithms::details::pareto::compute<false>(first, last, first2, directions, threads);
+        return algorithms::details::pareto::convex(first2, k, directions);
+    }
+    
+    /**
+     * Compute the convex Pareto front of points already sorted with lexicographic_less.
+     * The input is not modified.
+     * Average time complexity: O(N / T) where N is the number of points
+     * and T the number of threads.
+     * Average space complexity: O(F * T) where F is the number of points on the Pareto front.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination
+     *                 container (N points at most are written).
+     * @param directions - the directions of the front.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @return - the iterator to the one-past last point of the front, sorted by increasing x-coordinate.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 convex_pareto_front(presorted_t, RandomIt1 first, RandomIt1 last, RandomIt2 first2,
+                                  const pareto_directions& directions = {}, std::size_t threads = 1)
+    {
+        static_assert_is_random_access_iterator_to_point<RandomIt1>();
+        static_assert_is_random_access_iterator_to_point<RandomIt2>();
+        
+        const auto k = algorithms::details::pareto::compute<true>(first, last, first2, directions, threads);
+        return algorithms::details::pareto::convex(first2, k, directions);
+    }
+}
+
+#endif
@@ -0,0 +1,531 @@
+/**
+ * Pipelined convex hull of a point file: the I/O overlaps with the
+ * computation instead of alternating with it.
+ * The work is split in 5 stages, each one running in its own thread
+ * and joined to the next one by a bounded lock-free queue:
+ * 1. read - read the file in chunks of raw bytes (cut at a line or point boundary);
+ * 2. parse - decode the chunk (text or little-endian binary) into points;
+ * 3. prefilter - discard the points inside the Akl-Toussaint octagon of the chunk;
+ * 4. partial hull - compute the convex hull of the survivors of the chunk;
+ * 5. merge - fold the partial hull into the running convex hull.
+ * While the disk reads chunk i + 1, the cores parse, filter and hull
+ * the previous chunks, so the total time tends to max(I/O, compute)
+ * instead of their sum. The queues are bounded: the memory used is
+ * O(D * C) where D is the depth of the queues and C the chunk size.
+ * Example:
+ *      <code>
+ *      std::vector<std::array<double, 2>> convex_hull;
+ *      hull::io::pipelined_convex_hull<double>("dump.bin", std::back_inserter(convex_hull));
+ *      </code>
+ */
+
+#ifndef pipeline_h
+#define pipeline_h
+
+#include "algorithms.hpp"
+#include "mapped_points.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "prefilter.hpp"
+#include "static_assert.hpp"
+#include "text_parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hull::io {
+    /**
+     * Format of the input of the pipeline.
+     * @param binary - interleaved little-endian coordinates (see mapped_points.hpp).
+     * @param text - one point per line (see text_parser.hpp).
+     */
+    enum class pipeline_input {
+        binary,
+        text
+    };
+    
+    /**
+     * Stages of the pipeline, used to index the statistics.
+     */
+    enum class pipeline_stage {
+        read,
+        parse,
+        prefilter,
+        partial_hull,
+        merge
+    };
+    
+    constexpr std::size_t pipeline_stage_count = 5;
+    
+    /**
+     * Options of the pipeline.
+     * @param input - the format of the file.
+     * @param chunk_size - the number of bytes read at once.
+     * @param queue_depth - the maximum number of chunks waiting between two stages.
+     * @param parse_threads - the number of threads used to parse a text chunk (0 for all hardware threads).
+     * @param prefilter - false to skip the Akl-Toussaint prefilter stage.
+     */
+    struct pipeline_options {
+        pipeline_input input{pipeline_input::binary};
+        std::size_t chunk_size{std::size_t{64} << 20};
+        std::size_t queue_depth{4};
+        std::size_t parse_threads{1};
+        bool prefilter{true};
+    };
+    
+    /**
+     * Statistics of a pipelined computation.
+     * @param points - the number of points read.
+     * @param chunks - the number of chunks read.
+     * @param survivors - the number of points which survived the prefilter.
+     * @param malformed - the number of malformed lines (text input only).
+     * @param busy - the time spent working by each stage, in seconds (waiting excluded).
+     * @param elapsed - the wall-clock time of the whole pipeline, in seconds.
+     */
+    struct pipeline_stats {
+        std::size_t points{};
+        std::size_t chunks{};
+        std::size_t survivors{};
+        std::size_t malformed{};
+        std::array<double, pipeline_stage_count> busy{};
+        double elapsed{};
+        
+        double busy_time(pipeline_stage stage) const noexcept {
+            return busy[static_cast<std::size_t>(stage)];
+        }
+    };
+}
+
+namespace hull::io::details::pipeline {
+    using stage_clock = std::chrono::steady_clock;
+    
+    inline double seconds_since(stage_clock::time_point start) {
+        // Qualified: hull::operator- (point_math_utils.hpp) would be ambiguous.
+        return std::chrono::duration<double>(std::chrono::operator-(stage_clock::now(), start)).count();
+    }
+    
+    /**
+     * Byte buffer of a chunk. Unlike std::vector<char>, growing it does
+     * not zero the new bytes: they are overwritten by read anyway, and
+     * zeroing a whole chunk would be one more pass over the memory.
+     */
+    class raw_buffer {
+    public:
+        raw_buffer() = default;
+        
+        raw_buffer(raw_buffer&& other) noexcept :
+            data_{std::move(other.data_)},
+            capacity_{std::exchange(other.capacity_, 0)},
+            size_{std::exchange(other.size_, 0)}
+        {
+        }
+        
+        raw_buffer& operator=(raw_buffer&& other) noexcept {
+            data_ = std::move(other.data_);
+            capacity_ = std::exchange(other.capacity_, 0);
+            size_ = std::exchange(other.size_, 0);
+            return *this;
+        }
+        
+        char* data() noexcept {
+            return data_.get();
+        }
+        
+        const char* data() const noexcept {
+            return data_.get();
+        }
+        
+        std::size_t size() const noexcept {
+            return size_;
+        }
+        
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+        
+        /**
+         * Change the size. The new bytes are left uninitialized.
+         * @param size - the new size.
+         */
+        void resize(std::size_t size) {
+            if (size > capacity_) {
+                const auto capacity = std::max(size, 2 * capacity_);
+                std::unique_ptr<char[]> grown(new char[capacity]);
+                std::copy(data(), data() + size_, grown.get());
+                data_ = std::move(grown);
+                capacity_ = capacity;
+            }
+            size_ = size;
+        }
+        
+        void append(const char* first, const char* last) {
+            const auto size = size_;
+            resize(size + static_cast<std::size_t>(last - first));
+            std::copy(first, last, data() + size);
+        }
+        
+        void assign(const char* first, const char* last) {
+            size_ = 0;
+            append(first, last);
+        }
+    
+    private:
+        std::unique_ptr<char[]> data_;
+        std::size_t capacity_{};
+        std::size_t size_{};
+    };
+    
+    /**
+     * Read the next chunk of the file. The bytes of a partial record
+     * (a line without '\n' or a partial point) at the end of the buffer
+     * are carried over to the next chunk.
+     */
+    class chunk_reader {
+    public:
+        chunk_reader(const std::string& path, std::size_t record_size) :
+            fd_{::open(path.c_str(), O_RDONLY | O_CLOEXEC)},
+            record_size_{record_size}
+        {
+            if (fd_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        }
+        
+        chunk_reader(const chunk_reader&) = delete;
+        chunk_reader& operator=(const chunk_reader&) = delete;
+        
+        ~chunk_reader() {
+            ::close(fd_);
+        }
+        
+        /**
+         * Fill a buffer with the next chunk.
+         * @param buffer - the buffer (recycled by the caller).
+         * @param chunk_size - the number of bytes to read at once.
+         * @return - false at the end of the file.
+         * @throw std::runtime_error - if a binary file ends with a partial point.
+         */
+        bool read(raw_buffer& buffer, std::size_t chunk_size) {
+            buffer.assign(carry_.data(), carry_.data() + carry_.size());
+            carry_.clear();
+            
+            while (!eof_) {
+                const auto size = buffer.size();
+                buffer.resize(size + chunk_size);
+                const auto n = ::read(fd_, buffer.data() + size, chunk_size);
+                if (n < 0) {
+                    buffer.resize(size);
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "cannot read point file");
+                }
+                buffer.resize(size + static_cast<std::size_t>(n));
+                eof_ = (n == 0);
+                
+                const auto usable = boundary(buffer);
+                if (usable != 0 || eof_) {
+                    carry_.assign(buffer.data() + usable, buffer.data() + buffer.size());
+                    buffer.resize(usable);
+                    break;
+                }
+                // Not even one whole record: read more.
+            }
+            
+            if (eof_ && !carry_.empty()) {
+                if (record_size_ != 0) {
+                    throw std::runtime_error("truncated point file");
+                }
+                // The last line of a text file may lack a '\n'.
+                buffer.append(carry_.data(), carry_.data() + carry_.size());
+                carry_.clear();
+            }
+            
+            return !buffer.empty();
+        }
+    
+    private:
+        /**
+         * @return - the number of bytes made of whole records.
+         */
+        std::size_t boundary(const raw_buffer& buffer) const {
+            if (record_size_ != 0) {
+                return buffer.size() - buffer.size() % record_size_;
+            }
+            for (auto i = buffer.size(); i > 0; i--) {
+                if (buffer.data()[i - 1] == '\n') {
+                    return i;
+                }
+            }
+            return 0;
+        }
+        
+        int fd_;
+        std::size_t record_size_;
+        std::vector<char> carry_{};
+        bool eof_{};
+    };
+    
+    /**
+     * State shared by the stages: the first error and the queues to
+     * cancel when it occurs.
+     */
+    class failure {
+    public:
+        template <typename... Queues>
+        void capture(Queues&... queues) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            (queues.cancel(), ...);
+        }
+        
+        void rethrow() const {
+            if (error_) {
+                std::rethrow_exception(error_);
+            }
+        }
+    
+    private:
+        std::mutex mutex_;
+        std::exception_ptr error_;
+    };
+}
+
+namespace hull::io {
+    /**
+     * Compute the convex hull of a point file with a pipeline of
+     * concurrent stages (see the description at the top of this file).
+     * The output is in the same order as monotone_chain.
+     * Average time complexity: O(N * log(N)) where N is the number of points,
+     * with a single sequential pass over the file.
+     * Average space complexity: O(D * C + H) where D is the depth of the
+     * queues, C the chunk size and H the number of points on the convex hull.
+     * @param path - the path to the file.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @param policy - the algorithm used to compute the partial hull of each chunk.
+     * @param options - the options of the pipeline.
+     * @param stats - if not null, filled with statistics about the computation.
+     * @return - the iterator to the one-past last point of the convex hull.
+     * @throw std::system_error - if the file cannot be read.
+     * @throw std::runtime_error - if a binary file ends with a partial point.
+     */
+    template <
+        typename T,
+        typename TPoint = std::array<T, 2>,
+        typename OutputIt,
+        typename Policy = monotone_chain_t
+    >
+    OutputIt pipelined_convex_hull(const std::string& path, OutputIt first2, Policy policy = choice::monotone_chain,
+                                   const pipeline_options& options = {}, pipeline_stats* stats = nullptr)
+    {
+        static_assert_is_point<TPoint>();
+        using namespace details::pipeline;
+        using points_type = std::vector<TPoint>;
+        
+        const auto start = stage_clock::now();
+        const auto chunk_size = std::max<std::size_t>(1, options.chunk_size);
+        const auto depth = std::max<std::size_t>(1, options.queue_depth);
+        
+        std::size_t record_size{};
+        if (options.input == pipeline_input::binary) {
+            static_assert(std::is_arithmetic<T>::value, "unsupported coordinate type");
+            if constexpr (details::is_binary_coordinate_v<T>()) {
+                record_size = 2 * sizeof(T);
+            }
+            else {
+                throw std::invalid_argument("unsupported on-disk coordinate type");
+            }
+        }
+        chunk_reader reader(path, record_size);
+        
+        parallel::spsc_queue<raw_buffer> raw(depth);
+        parallel::spsc_queue<raw_buffer> recycled(depth + 1);
+        parallel::spsc_queue<points_type> parsed(depth);
+        parallel::spsc_queue<points_type> filtered(depth);
+        parallel::spsc_queue<points_type> partial(depth);
+        failure failed;
+        
+        pipeline_stats local_stats;
+        auto busy = [&local_stats](pipeline_stage stage, stage_clock::time_point since) {
+            local_stats.busy[static_cast<std::size_t>(stage)] += seconds_since(since);
+        };
+        
+        // Each stage owns its counters: they are only read once all the threads are joined.
+        std::size_t chunks{};
+        std::size_t points{};
+        std::size_t malformed{};
+        std::size_t survivors{};
+        
+        std::thread read_stage([&] {
+            try {
+                for (;;) {
+                    raw_buffer buffer;
+                    recycled.try_pop(buffer);
+                    
+                    const auto since = stage_clock::now();
+                    const auto more = reader.read(buffer, chunk_size);
+                    busy(pipeline_stage::read, since);
+                    
+                    if (!more || !raw.push(std::move(buffer))) {
+                        break;
+                    }
+                    chunks++;
+                }
+                raw.close();
+            }
+            catch (...) {
+                failed.capture(raw, recycled, parsed, filtered, partial);
+            }
+        });
+        
+        std::thread parse_stage([&] {
+            try {
+                parse_options parse_options;
+                parse_options.threads = options.parse_threads;
+                
+                raw_buffer buffer;
+                while (raw.pop(buffer)) {
+                    const auto since = stage_clock::now();
+                    points_type chunk;
+                    if (record_size != 0) {
+                        if constexpr (details::is_binary_coordinate_v<T>()) {
+                            chunk.reserve(buffer.size() / record_size);
+                            const auto data = reinterpret_cast<const unsigned char*>(buffer.data());
+                            for (std::size_t offset{}; offset < buffer.size(); offset += record_size) {
+                                chunk.push_back(make_point<TPoint>(details::load_little_endian<T>(data + offset),
+                                                                   details::load_little_endian<T>(data + offset + sizeof(T))));
+                            }
+                        }
+                    }
+                    else {
+                        const auto report = parse_points(buffer.data(), buffer.data() + buffer.size(), chunk, parse_options);
+                        malformed += report.malformed;
+                    }
+                    points += chunk.size();
+                    busy(pipeline_stage::parse, since);
+                    
+                    recycled.try_push(buffer);
+                    if (!parsed.push(std::move(chunk))) {
+                        break;
+                    }
+                }
+                parsed.close();
+            }
+            catch (...) {
+                failed.capture(raw, recycled, parsed, filtered, partial);
+            }
+        });
+        
+        std::thread prefilter_stage([&] {
+            try {
+                points_type chunk;
+                while (parsed.pop(chunk)) {
+                    const auto since = stage_clock::now();
+                    if (options.prefilter) {
+                        points_type kept;
+                        algorithms::akl_toussaint(std::begin(chunk), std::end(chunk), std::back_inserter(kept));
+                        chunk = std::move(kept);
+                    }
+                    survivors += chunk.size();
+                    busy(pipeline_stage::prefilter, since);
+                    
+                    if (!filtered.push(std::move(chunk))) {
+                        break;
+                    }
+                }
+                filtered.close();
+            }
+            catch (...) {
+                failed.capture(raw, recycled, parsed, filtered, partial);
+            }
+        });
+        
+        std::thread partial_hull_stage([&] {
+            try {
+                points_type chunk;
+                while (filtered.pop(chunk)) {
+                    if (chunk.empty()) {
+                        continue;
+                    }
+                    
+                    const auto since = stage_clock::now();
+                    points_type chunk_hull;
+                    convex::compute(policy, chunk, chunk_hull);
+                    busy(pipeline_stage::partial_hull, since);
+                    
+                    if (!partial.push(std::move(chunk_hull))) {
+                        break;
+                    }
+                }
+                partial.close();
+            }
+            catch (...) {
+                failed.capture(raw, recycled, parsed, filtered, partial);
+            }
+        });
+        
+        // Merge stage, on the calling thread: the running hull is
+        // the convex hull of itself and of the partial hull.
+        points_type running;
+        try {
+            points_type chunk_hull;
+            points_type merged;
+            while (partial.pop(chunk_hull)) {
+                const auto since = stage_clock::now();
+                chunk_hull.insert(std::end(chunk_hull), std::begin(running), std::end(running));
+                merged.resize(2 * chunk_hull.size());
+                const auto merged_last = algorithms::monotone_chain(std::begin(chunk_hull), std::end(chunk_hull), std::begin(merged));
+                merged.erase(merged_last, std::end(merged));
+                std::swap(running, merged);
+                busy(pipeline_stage::merge, since);
+            }
+        }
+        catch (...) {
+            failed.capture(raw, recycled, parsed, filtered, partial);
+        }
+        
+        read_stage.join();
+        parse_stage.join();
+        prefilter_stage.join();
+        partial_hull_stage.join();
+        failed.rethrow();
+        
+        local_stats.chunks = chunks;
+        local_stats.points = points;
+        local_stats.malformed = malformed;
+        local_stats.survivors = survivors;
+        local_stats.elapsed = seconds_since(start);
+        if (stats != nullptr) {
+            *stats = local_stats;
+        }
+        
+        return std::copy(std::begin(running), std::end(running), first2);
+    }
+}
+
+#endif
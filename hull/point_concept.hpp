@@ -146,7 +146,7 @@ namespace hull {
      * @return - the x coordinate.
      */
     template <typename TPoint>
-    auto x(const TPoint& p) -> decltype(p.x) {
+    constexpr auto x(const TPoint& p) -> decltype(p.x) {
         return p.x;
     }
     
@@ -156,7 +156,7 @@ namespace hull {
      * @return - the X coordinate.
      */
     template <typename TPoint>
-    auto x(const TPoint& p) -> decltype(p.X) {
+    constexpr auto x(const TPoint& p) -> decltype(p.X) {
         return p.X;
     }
     
@@ -166,7 +166,7 @@ namespace hull {
      * @return - the x coordinate.
      */
     template <typename TPoint>
-    auto x(const TPoint& p) -> decltype(p.x()) {
+    constexpr auto x(const TPoint& p) -> decltype(p.x()) {
         return p.x();
     }
     
@@ -176,7 +176,7 @@ namespace hull {
      * @return - the X coordinate.
      */
     template <typename TPoint>
-    auto x(const TPoint& p) -> decltype(p.X()) {
+    constexpr auto x(const TPoint& p) -> decltype(p.X()) {
         return p.X();
     }
     
@@ -186,7 +186,7 @@ namespace hull {
      * @return - the x coordinate.
      */
     template <typename TPoint>
-    auto x(const TPoint& p) -> decltype(p[0]) {
+    constexpr auto x(const TPoint& p) -> decltype(p[0]) {
         return p[0];
     }
     
@@ -199,7 +199,7 @@ namespace hull {
         typename TPoint,
         typename = std::enable_if_t<!details::is_array_v<TPoint>()>
     >
-    auto x(const TPoint& p) -> decltype(std::get<0>(p)) {
+    constexpr auto x(const TPoint& p) -> decltype(std::get<0>(p)) {
         return std::get<0>(p);
     }
     
@@ -209,7 +209,7 @@ namespace hull {
      * @return - the y coordinate.
      */
     template <typename TPoint>
-    auto y(const TPoint& p) -> decltype(p.y) {
+    constexpr auto y(const TPoint& p) -> decltype(p.y) {
         return p.y;
     }
     
@@ -219,7 +219,7 @@ namespace hull {
      * @return - the Y coordinate.
      */
     template <typename TPoint>
-    auto y(const TPoint& p) -> decltype(p.Y) {
+    constexpr auto y(const TPoint& p) -> decltype(p.Y) {
         return p.Y;
     }
     
@@ -229,7 +229,7 @@ namespace hull {
      * @return - the y coordinate.
      */
     template <typename TPoint>
-    auto y(const TPoint& p) -> decltype(p.y()) {
+    constexpr auto y(const TPoint& p) -> decltype(p.y()) {
         return p.y();
     }
     
@@ -239,7 +239,7 @@ namespace hull {
      * @return - the Y coordinate.
      */
     template <typename TPoint>
-    auto y(const TPoint& p) -> decltype(p.Y()) {
+    constexpr auto y(const TPoint& p) -> decltype(p.Y()) {
         return p.Y();
     }
     
@@ -249,7 +249,7 @@ namespace hull {
      * @return - the y coordinate.
      */
     template <typename TPoint>
-    auto y(const TPoint& p) -> decltype(p[1]) {
+    constexpr auto y(const TPoint& p) -> decltype(p[1]) {
         return p[1];
     }
     
@@ -262,7 +262,7 @@ namespace hull {
         typename TPoint,
         typename = std::enable_if_t<!details::is_array_v<TPoint>()>
     >
-    auto y(const TPoint& p) -> decltype(std::get<1>(p)) {
+    constexpr auto y(const TPoint& p) -> decltype(std::get<1>(p)) {
         return std::get<1>(p);
     }
     
@@ -283,7 +283,7 @@ namespace hull {
         typename TPoint,
         typename = std::enable_if_t<!details::is_array_v<TPoint>()>
     >
-    auto make_point(coordinate_t<TPoint> x, coordinate_t<TPoint> y) -> decltype(TPoint{x, y}) {
+    constexpr auto make_point(coordinate_t<TPoint> x, coordinate_t<TPoint> y) -> decltype(TPoint{x, y}) {
         return TPoint{x, y};
     }
     
@@ -297,7 +297,7 @@ namespace hull {
         typename TPoint,
         typename = std::enable_if_t<details::is_array_v<TPoint>()>
     >
-    auto make_point(coordinate_t<TPoint> x, coordinate_t<TPoint> y) -> decltype(TPoint{{x, y}}) {
+    constexpr auto make_point(coordinate_t<TPoint> x, coordinate_t<TPoint> y) -> decltype(TPoint{{x, y}}) {
         return TPoint{{x, y}};
     }
 }
@@ -0,0 +1,79 @@
+/**
+ * Point location with respect to a convex polygon.
+ * These predicates are used to discard the points (or whole
+ * groups of points) that cannot be on the convex hull because
+ * they lie strictly inside a known convex subset of it.
+ */
+
+#ifndef point_in_hull_h
+#define point_in_hull_h
+
+#include "angle.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <iterator>
+
+namespace hull::algorithms {
+    /**
+     * Tell whether a point lies strictly inside a convex polygon.
+     * The polygon must be given counter-clockwise, without collinear
+     * consecutive vertices (which is what Monotone Chain returns).
+     * A polygon with less than 3 vertices has no interior.
+     * Average time complexity: O(log(H)) where H is the number of vertices.
+     * @param first - the random access iterator to the first vertex of the polygon.
+     * @param last - the random access iterator to the one-past last vertex of the polygon.
+     * @param p - the point to locate.
+     * @return - true if p is inside the polygon and not on its boundary.
+     */
+    template <typename RandomIt, typename TPoint>
+    bool is_strictly_inside(RandomIt first, RandomIt last, const TPoint& p) {
+        static_assert_is_random_access_iterator_to_point<RandomIt>();
+        
+        const auto n = std::distance(first, last);
+        if (n < 3) {
+            return false;
+        }
+        
+        const auto& origin = *first;
+        if (cross(origin, *(first + 1), p) <= 0 || cross(origin, *(first + (n - 1)), p) >= 0) {
+            return false;
+        }
+        
+        // Find the wedge (origin, first[lo], first[lo + 1]) containing p.
+        typename std::iterator_traits<RandomIt>::difference_type lo{1};
+        auto hi = n - 1;
+        while (hi - lo > 1) {
+            const auto mid = lo + (hi - lo) / 2;
+            if (cross(origin, *(first + mid), p) > 0) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        
+        return cross(*(first + lo), *(first + hi), p) > 0;
+    }
+    
+    /**
+     * Tell whether an axis-aligned box lies strictly inside a convex
+     * polygon. Since the polygon is convex, it is enough to check the
+     * 4 corners of the box.
+     * Average time complexity: O(log(H)) where H is the number of vertices.
+     * @param first - the random access iterator to the first vertex of the polygon.
+     * @param last - the random access iterator to the one-past last vertex of the polygon.
+     * @param min_corner - the bottom-left corner of the box.
+     * @param max_corner - the top-right corner of the box.
+     * @return - true if the whole box is inside the polygon and does not touch its boundary.
+     */
+    template <typename RandomIt, typename TPoint>
+    bool is_box_strictly_inside(RandomIt first, RandomIt last, const TPoint& min_corner, const TPoint& max_corner) {
+        return is_strictly_inside(first, last, min_corner) &&
+               is_strictly_inside(first, last, max_corner) &&
+               is_strictly_inside(first, last, make_point<TPoint>(x(max_corner), y(min_corner))) &&
+               is_strictly_inside(first, last, make_point<TPoint>(x(min_corner), y(max_corner)));
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * Akl-Toussaint heuristic: discard, in linear time, the points which
+ * cannot be on the convex hull.
+ * The 8 extreme points of the set in the directions x, y, x + y and
+ * x - y form a convex octagon which is a subset of the convex hull.
+ * Every point strictly inside this octagon can be discarded. On random
+ * inputs, this removes most of the points before running an
+ * O(N * log(N)) algorithm on the survivors.
+ * Reference: S. G. Akl and G. T. Toussaint, A fast convex hull algorithm, 1978.
+ */
+
+#ifndef prefilter_h
+#define prefilter_h
+
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "point_in_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <vector>
+
+namespace hull::algorithms::details::akl_toussaint {
+    /**
+     * Find the extreme points of a set of points in 8 directions and
+     * return them as a convex polygon (counter-clockwise, without
+     * duplicate or collinear vertices).
+     * Average time complexity: O(N) where N is the number of points.
+     * @param first - the forward iterator to the first point of the container.
+     * @param last - the forward iterator to the one-past last point of the container.
+     * @return - the vertices of the octagon (at most 8).
+     */
+    template <
+        typename ForwardIt,
+        typename TPoint = typename std::iterator_traits<ForwardIt>::value_type
+    >
+    std::vector<TPoint> octagon(ForwardIt first, ForwardIt last) {
+        if (first == last) {
+            return {};
+        }
+        
+        // min y, max x - y, max x, max x + y, max y, min x - y, min x, min x + y
+        std::array<TPoint, 8> extremes;
+        extremes.fill(*first);
+        
+        std::for_each(std::next(first), last, [&extremes](const auto& p) {
+            if (y(p) < y(extremes[0])) extremes[0] = p;
+            if (x(p) - y(p) > x(extremes[1]) - y(extremes[1])) extremes[1] = p;
+            if (x(p) > x(extremes[2])) extremes[2] = p;
+            if (x(p) + y(p) > x(extremes[3]) + y(extremes[3])) extremes[3] = p;
+            if (y(p) > y(extremes[4])) extremes[4] = p;
+            if (x(p) - y(p) < x(extremes[5]) - y(extremes[5])) extremes[5] = p;
+            if (x(p) < x(extremes[6])) extremes[6] = p;
+            if (x(p) + y(p) < x(extremes[7]) + y(extremes[7])) extremes[7] = p;
+        });
+        
+        // The extreme points may coincide or be collinear:
+        // Monotone Chain cleans them up.
+        std::vector<TPoint> polygon(2 * extremes.size());
+        const auto polygon_last = monotone_chain(std::begin(extremes), std::end(extremes), std::begin(polygon));
+        polygon.erase(polygon_last, std::end(polygon));
+        
+        return polygon;
+    }
+}
+
+namespace hull::algorithms {
+    /**
+     * Copy the points which may be on the convex hull, that is all the
+     * points except those strictly inside the Akl-Toussaint octagon.
+     * The input is not modified, so it may be a read-only range (for
+     * instance a memory-mapped file).
+     * Average time complexity: O(N) where N is the number of points.
+     * Average space complexity: O(N) in the worst case for the output.
+     * @param first - the forward iterator to the first point of the container.
+     * @param last - the forward iterator to the one-past last point of the container.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last copied point.
+     */
+    template <typename ForwardIt, typename OutputIt>
+    OutputIt akl_toussaint(ForwardIt first, ForwardIt last, OutputIt first2) {
+        static_assert_is_forward_iterator_to_point<ForwardIt>();
+        
+        const auto polygon = details::akl_toussaint::octagon(first, last);
+        
+        return std::copy_if(first, last, first2, [&polygon](const auto& p) {
+            return !is_strictly_inside(std::begin(polygon), std::end(polygon), p);
+        });
+    }
+}
+
+#endif
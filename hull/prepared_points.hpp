@@ -0,0 +1,213 @@
+/**
+ * Fixed set of points prepared for the convex hulls of many of its
+ * subsets (the points matching an attribute filter, for instance).
+ * Computing the hull of each subset sorts its points again, in
+ * O(N * log(N)). Instead, the points are sorted once with lexicographic_less
+ * and the permutation is kept: the points of any subset are then visited
+ * in sorted order by a walk along the sorted points, and fed to the
+ * Monotone Chain stack directly, in O(N) per subset without sorting.
+ * A subset is given either by a predicate on the indices of the points
+ * (in the order of the input), or by a bitmask. A bitmask in the order of
+ * the input is first permuted into the sorted order, one bit gathered per
+ * point. A bitmask already in the sorted order (for instance built once
+ * with permute_mask and combined with bitwise operations) is scanned 64
+ * sorted points at a time, and the words without any selected point are
+ * skipped at once.
+ * Example:
+ *      <code>
+ *      const hull::prepared_points<point> prepared(points);
+ *      const auto convex_hull = prepared.hull_of([&](std::size_t i) { return labels[i] == label; });
+ *      </code>
+ */
+
+#ifndef prepared_points_h
+#define prepared_points_h
+
+#include "bit_utils.hpp"
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace hull {
+    /**
+     * Points sorted once, for the convex hulls of their subsets.
+     */
+    template <typename TPoint>
+    class prepared_points {
+    public:
+        using point_type = TPoint;
+        
+        prepared_points() = default;
+        
+        /**
+         * Sort the points, in any order, and keep the permutation.
+         * Average time complexity: O(N * log(N)) where N is the number of points.
+         * Average space complexity: O(N).
+         * @param first - the forward iterator to the first point.
+         * @param last - the forward iterator to the one-past last point.
+         */
+        template <typename ForwardIt>
+        prepared_points(ForwardIt first, ForwardIt last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            
+            const std::vector<TPoint> points(first, last);
+            order_.resize(points.size());
+            std::iota(std::begin(order_), std::end(order_), std::size_t{});
+            const auto less = algorithms::details::monotone::lexicographic_less{};
+            std::sort(std::begin(order_), std::end(order_), [&points, less](std::size_t i, std::size_t j) {
+                return less(points[i], points[j]);
+            });
+            
+            sorted_.reserve(points.size());
+            for (const auto i: order_) {
+                sorted_.push_back(points[i]);
+            }
+        }
+        
+        /**
+         * Container-based constructor.
+         * @param points - the points.
+         */
+        template <typename TContainer>
+        explicit prepared_points(const TContainer& points) : prepared_points(std::begin(points), std::end(points)) {}
+        
+        /**
+         * Compute the convex hull of the points selected by a predicate.
+         * Average time complexity: O(N) where N is the number of points.
+         * @param predicate - called with the index of each point (in the order of the
+         *                    input), true if the point belongs to the subset.
+         * @return - the vertices of the convex hull, in the same order as monotone_chain.
+         */
+        template <typename Predicate>
+        std::vector<TPoint> hull_of(Predicate predicate) const {
+            algorithms::details::monotone::chain_builder<TPoint> chain;
+            for (std::size_t k{}; k < sorted_.size(); k++) {
+                if (predicate(order_[k])) {
+                    chain.push(sorted_[k]);
+                }
+            }
+            return copy(chain);
+        }
+        
+        /**
+         * Compute the convex hull of the points selected by a bitmask: the point
+         * of index i (in the order of the input) is selected if the bit (i % 64)
+         * of the word (i / 64) is set.
+         * Average time complexity: O(N) where N is the number of points.
+         * @param mask - the words of the bitmask.
+         * @return - the vertices of the convex hull, in the same order as monotone_chain.
+         * @throw std::invalid_argument - if the bitmask has less than (N + 63) / 64 words.
+         */
+        std::vector<TPoint> hull_of(const std::vector<std::uint64_t>& mask) const {
+            return hull_of_sorted(permute_mask(mask));
+        }
+        
+        /**
+         * Compute the convex hull of the points selected by a bitmask in the sorted
+         * order: the point sorted()[k] is selected if the bit (k % 64) of the word
+         * (k / 64) is set. The words equal to zero are skipped at once.
+         * Average time complexity: O(N / 64 + S) where N is the number of points
+         * and S the number of selected points.
+         * @param sorted_mask - the words of the bitmask.
+         * @return - the vertices of the convex hull, in the same order as monotone_chain.
+         * @throw std::invalid_argument - if the bitmask has less than (N + 63) / 64 words.
+         */
+        std::vector<TPoint> hull_of_sorted(const std::vector<std::uint64_t>& sorted_mask) const {
+            const auto N = sorted_.size();
+            check_mask(sorted_mask);
+            
+            algorithms::details::monotone::chain_builder<TPoint> chain;
+            for (std::size_t w{}; w < (N + 63) / 64; w++) {
+                auto word = sorted_mask[w];
+                if (w == N / 64) {
+                    // Ignore the bits past the last point.
+                    word &= (std::uint64_t{1} << (N % 64)) - 1;
+                }
+                for (; word != 0; word &= word - 1) {
+                    chain.push(sorted_[64 * w + hull::details::countr_zero(word)]);
+                }
+            }
+            return copy(chain);
+        }
+        
+        /**
+         * Permute a bitmask in the order of the input into the sorted order (see
+         * hull_of_sorted), one bit gathered per point.
+         * Average time complexity: O(N) where N is the number of points.
+         * @param mask - the words of the bitmask, in the order of the input.
+         * @return - the words of the bitmask, in the sorted order.
+         * @throw std::invalid_argument - if the bitmask has less than (N + 63) / 64 words.
+         */
+        std::vector<std::uint64_t> permute_mask(const std::vector<std::uint64_t>& mask) const {
+            const auto N = sorted_.size();
+            check_mask(mask);
+            
+            std::vector<std::uint64_t> sorted_mask((N + 63) / 64);
+            for (std::size_t base{}; base < N; base += 64) {
+                const auto count = std::min<std::size_t>(64, N - base);
+                std::uint64_t word{};
+                for (std::size_t b{}; b < count; b++) {
+                    const auto i = order_[base + b];
+                    word |= ((mask[i / 64] >> (i % 64)) & 1) << b;
+                }
+                sorted_mask[base / 64] = word;
+            }
+            return sorted_mask;
+        }
+        
+        /**
+         * @return - the points, sorted with lexicographic_less.
+         */
+        const std::vector<TPoint>& sorted() const noexcept {
+            return sorted_;
+        }
+        
+        /**
+         * @return - the permutation: order()[k] is the index (in the order of the
+         *           input) of the point sorted()[k].
+         */
+        const std::vector<std::size_t>& order() const noexcept {
+            return order_;
+        }
+        
+        /**
+         * @return - the number of points.
+         */
+        std::size_t size() const noexcept {
+            return sorted_.size();
+        }
+    
+    private:
+        /**
+         * @throw std::invalid_argument - if the bitmask has less than (N + 63) / 64 words.
+         */
+        void check_mask(const std::vector<std::uint64_t>& mask) const {
+            if (mask.size() < (sorted_.size() + 63) / 64) {
+                throw std::invalid_argument("the bitmask is too short for the prepared points");
+            }
+        }
+        
+        /**
+         * @return - the convex hull of the points pushed on the chain.
+         */
+        static std::vector<TPoint> copy(const algorithms::details::monotone::chain_builder<TPoint>& chain) {
+            std::vector<TPoint> convex_hull;
+            convex_hull.reserve(chain.size());
+            chain.copy(std::back_inserter(convex_hull));
+            return convex_hull;
+        }
+        
+        std::vector<TPoint> sorted_;
+        std::vector<std::size_t> order_;
+    };
+}
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * Convex hulls of the points whose x-coordinate (a time, for instance) is
+ * within a range, for many ranges over the same static set of points.
+ * Computing the convex hull of each slice again is O(N * log(N)) per
+ * query. Instead, the points are sorted once and a segment tree stores
+ * the convex hull of each node range:
+ * - the leaves are blocks of leaf_size consecutive points, their hulls
+ *   being computed with Monotone Chain;
+ * - the hull of an internal node is the linear-time merge of the hulls of
+ *   its children (see hull_merge.hpp), so that the tree is built in
+ *   O(N * log(N)).
+ * A query covers its range with O(log(N)) nodes, whose hulls are merged,
+ * plus at most 2 partial blocks at its ends, whose points are scanned.
+ * Example:
+ *      <code>
+ *      const hull::range_hull<point> index(std::begin(samples), std::end(samples));
+ *      const auto convex_hull = index.query(t0, t1);
+ *      </code>
+ */
+
+#ifndef range_hull_h
+#define range_hull_h
+
+#include "hull_merge.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace hull {
+    /**
+     * Static index answering convex hull queries over ranges of x-coordinates.
+     */
+    template <typename TPoint>
+    class range_hull {
+    public:
+        using point_type = TPoint;
+        using coordinate_type = std::decay_t<coordinate_t<TPoint>>;
+        
+        /**
+         * The number of points in a leaf of the tree.
+         */
+        static constexpr std::size_t leaf_size = 32;
+        
+        range_hull() = default;
+        
+        /**
+         * Build the index of a set of points, in any order.
+         * Average time complexity: O(N * log(N)) where N is the number of points.
+         * Average space complexity: O(N * log(N)) in the worst case, much less
+         * when the hulls are small compared to the ranges.
+         * @param first - the forward iterator to the first point.
+         * @param last - the forward iterator to the one-past last point.
+         * @param threads - the number of threads (0 for all hardware threads).
+         */
+        template <typename ForwardIt>
+        range_hull(ForwardIt first, ForwardIt last, std::size_t threads = 1) : points_(first, last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            
+            algorithms::details::monotone::sort(std::begin(points_), std::end(points_));
+            blocks_ = (points_.size() + leaf_size - 1) / leaf_size;
+            nodes_.resize(2 * blocks_);
+            
+            parallel::for_each_chunk(blocks_, threads, [this](std::size_t, std::size_t begin, std::size_t end) {
+                for (auto b = begin; b < end; b++) {
+                    nodes_[blocks_ + b] = scan(b * leaf_size, std::min(points_.size(), (b + 1) * leaf_size));
+                }
+            });
+            
+            // The children of the node i are the nodes 2 * i and 2 * i + 1: the
+            // nodes of [2^k ; 2^(k + 1)) only depend on the nodes after them.
+            std::size_t top{1};
+            for (; 2 * top < blocks_; top *= 2) {}
+            for (auto level = top; level >= 1; level /= 2) {
+                const auto level_end = std::min(2 * level, blocks_);
+                if (level_end <= level) {
+                    continue;
+                }
+                parallel::for_each_chunk(level_end - level, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (auto i = level + begin; i < level + end; i++) {
+                        const auto& a = nodes_[2 * i];
+                        const auto& b = nodes_[2 * i + 1];
+                        algorithms::merge_hulls(std::begin(a), std::end(a), std::begin(b), std::end(b),
+                                                std::back_inserter(nodes_[i]));
+                    }
+                });
+            }
+        }
+        
+        /**
+         * Container-based constructor.
+         * @param points - the points.
+         * @param threads - the number of threads (0 for all hardware threads).
+         */
+        template <typename TContainer>
+        explicit range_hull(const TContainer& points, std::size_t threads = 1) :
+            range_hull(std::begin(points), std::end(points), threads) {}
+        
+        /**
+         * Compute the convex hull of the points whose x-coordinate is within [x_min ; x_max].
+         * Average time complexity: O(H * log(N) + leaf_size) where H is the number
+         * of vertices of the convex hull and N the number of points.
+         * @param x_min - the lowest x-coordinate of the range.
+         * @param x_max - the greatest x-coordinate of the range.
+         * @return - the vertices of the convex hull, in the same order as monotone_chain
+         *           (empty if no point is within the range).
+         */
+        std::vector<TPoint> query(coordinate_type x_min, coordinate_type x_max) const {
+            const auto lo = std::partition_point(std::begin(points_), std::end(points_), [x_min](const TPoint& p) {
+                return x(p) < x_min;
+            });
+            const auto hi = std::partition_point(lo, std::end(points_), [x_max](const TPoint& p) {
+                return !(x_max < x(p));
+            });
+            return query_indices(static_cast<std::size_t>(lo - std::begin(points_)),
+                                 static_cast<std::size_t>(hi - std::begin(points_)));
+        }
+        
+        /**
+         * Compute the convex hull of the points of indices [begin ; end) in points().
+         * Average time complexity: O(H * log(N) + leaf_size) where H is the number
+         * of vertices of the convex hull and N the number of points.
+         * @param begin - the index of the first point.
+         * @param end - the index of the one-past last point.
+         * @return - the vertices of the convex hull, in the same order as monotone_chain.
+         */
+        std::vector<TPoint> query_indices(std::size_t begin, std::size_t end) const {
+            end = std::min(end, points_.size());
+            if (begin >= end) {
+                return {};
+            }
+            
+            // The full blocks of the range, and the points of the partial blocks at its ends.
+            const auto first_block = (begin + leaf_size - 1) / leaf_size;
+            const auto last_block = end / leaf_size;
+            if (first_block >= last_block) {
+                return scan(begin, end);
+            }
+            
+            auto result = scan(begin, first_block * leaf_size);
+            add(result, scan(last_block * leaf_size, end));
+            for (auto l = first_block + blocks_, r = last_block + blocks_; l < r; l /= 2, r /= 2) {
+                if (l % 2 == 1) {
+                    add(result, nodes_[l++]);
+                }
+                if (r % 2 == 1) {
+                    add(result, nodes_[--r]);
+                }
+            }
+            return result;
+        }
+        
+        /**
+         * @return - the points, sorted with lexicographic_less.
+         */
+        const std::vector<TPoint>& points() const noexcept {
+            return points_;
+        }
+        
+        /**
+         * @return - the number of points.
+         */
+        std::size_t size() const noexcept {
+            return points_.size();
+        }
+    
+    private:
+        /**
+         * @return - the convex hull of the points of indices [begin ; end).
+         */
+        std::vector<TPoint> scan(std::size_t begin, std::size_t end) const {
+            algorithms::details::monotone::chain_builder<TPoint> chain;
+            for (auto i = begin; i < end; i++) {
+                chain.push(points_[i]);
+            }
+            std::vector<TPoint> convex_hull;
+            chain.copy(std::back_inserter(convex_hull));
+            return convex_hull;
+        }
+        
+        /**
+         * Merge a convex polygon into the result of a query.
+         */
+        static void add(std::vector<TPoint>& result, const std::vector<TPoint>& polygon) {
+            if (polygon.empty()) {
+                return ;
+            }
+            std::vector<TPoint> merged;
+            algorithms::merge_hulls(std::begin(result), std::end(result), std::begin(polygon), std::end(polygon),
+                                    std::back_inserter(merged));
+            result.swap(merged);
+        }
+        
+        std::vector<TPoint> points_;
+        std::size_t blocks_{};
+        std::vector<std::vector<TPoint>> nodes_;
+    };
+}
+
+#endif
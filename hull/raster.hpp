@@ -0,0 +1,214 @@
+/**
+ * Convex hull of the set pixels of a mask (sprites, segmentation output...).
+ * Converting every set pixel to a point and sorting millions of them is
+ * wasteful: only the leftmost and rightmost set pixels of each row can be
+ * on the convex hull. Those extents are found by bit scanning, a whole
+ * word of 64 pixels at a time, and they come out sorted by row, so that
+ * the Monotone Chain scan runs on them directly, without sorting.
+ * Time complexity: O(P / 64 + R) for a bitmap of P pixels and R rows.
+ * Two input layouts are supported:
+ *      bitmap      each row is an array of 64-bit words, the pixel x of a
+ *                  row being the bit (x % 64) of its word (x / 64);
+ *      runs        the runs of set pixels (row, first column, length), sorted
+ *                  by row, such as a run-length encoded mask.
+ * The pixel (x, y) is the point of coordinates (x, y), and the convex hull
+ * is in the same order as monotone_chain.
+ * Example:
+ *      <code>
+ *      hull::io::bitmap_view mask{words.data(), width, height, stride};
+ *      std::vector<std::array<int, 2>> convex_hull;
+ *      hull::io::bitmap_convex_hull<std::array<int, 2>>(mask, std::back_inserter(convex_hull));
+ *      </code>
+ */
+
+#ifndef raster_h
+#define raster_h
+
+#include "bit_utils.hpp"
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace hull::io {
+    /**
+     * Read-only view of a bitmap.
+     * @param words - the words of the first row.
+     * @param width - the number of pixels in a row (the bits beyond it are ignored).
+     * @param height - the number of rows.
+     * @param stride - the number of words between 2 rows (at least (width + 63) / 64).
+     */
+    struct bitmap_view {
+        const std::uint64_t* words{};
+        std::size_t width{};
+        std::size_t height{};
+        std::size_t stride{};
+    };
+    
+    /**
+     * Run of set pixels in a row.
+     * @param y - the row.
+     * @param x - the first column of the run.
+     * @param length - the number of pixels of the run.
+     */
+    struct pixel_run {
+        std::size_t y{};
+        std::size_t x{};
+        std::size_t length{};
+    };
+}
+
+namespace hull::io::details::raster {
+    /**
+     * Find the leftmost and rightmost set pixels of a row of a bitmap.
+     * Only the words before the first set bit and after the last one are read.
+     * @param row - the words of the row.
+     * @param width - the number of pixels in the row.
+     * @param left - the column of the leftmost set pixel.
+     * @param right - the column of the rightmost set pixel.
+     * @return - false if the row has no set pixel.
+     */
+    inline bool row_extent(const std::uint64_t* row, std::size_t width, std::size_t& left, std::size_t& right) {
+        const auto words = (width + 63) / 64;
+        const auto tail = width % 64;
+        auto word = [row, words, tail](std::size_t w) {
+            return (w + 1 == words && tail != 0) ? row[w] & ((std::uint64_t{1} << tail) - 1) : row[w];
+        };
+        
+        std::size_t first{};
+        for (; first < words && word(first) == 0; first++) {}
+        if (first == words) {
+            return false;
+        }
+        
+        auto last = words - 1;
+        for (; word(last) == 0; last--) {}
+        
+        left = 64 * first + hull::details::countr_zero(word(first));
+        right = 64 * last + 63 - hull::details::countl_zero(word(last));
+        return true;
+    }
+    
+    /**
+     * Append the extents of a row to the points.
+     * @param extents - the points, sorted by row then by column.
+     * @param y - the row.
+     * @param left - the column of the leftmost set pixel.
+     * @param right - the column of the rightmost set pixel.
+     */
+    template <typename TPoint>
+    void add_extent(std::vector<TPoint>& extents, std::size_t y, std::size_t left, std::size_t right) {
+        using coordinate_type = std::decay_t<coordinate_t<TPoint>>;
+        extents.push_back(make_point<TPoint>(static_cast<coordinate_type>(left), static_cast<coordinate_type>(y)));
+        if (right != left) {
+            extents.push_back(make_point<TPoint>(static_cast<coordinate_type>(right), static_cast<coordinate_type>(y)));
+        }
+    }
+    
+    /**
+     * Compute the convex hull of the row extents, without sorting them.
+     * The Monotone Chain scan works along any direction: sorted by row,
+     * the lower hull is the right side of the convex hull and the upper
+     * hull is its left side, both counter-clockwise. The convex hull is then
+     * rotated so that it starts at the same point as with monotone_chain.
+     * @param extents - the points, sorted by row then by column.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the output iterator to the one-past last point of the convex hull.
+     */
+    template <typename TPoint, typename OutputIt>
+    OutputIt extents_hull(const std::vector<TPoint>& extents, OutputIt first2) {
+        if (extents.size() <= 1) {
+            return std::copy(std::begin(extents), std::end(extents), first2);
+        }
+        
+        std::vector<TPoint> convex_hull(2 * extents.size());
+        std::size_t k{};
+        algorithms::details::monotone::lower_hull(std::begin(extents), std::end(extents), std::begin(convex_hull), k);
+        algorithms::details::monotone::upper_hull(std::begin(extents), std::end(extents), std::begin(convex_hull), k);
+        
+        const auto last = std::begin(convex_hull) + static_cast<std::ptrdiff_t>(k - 1);
+        const auto lowest = std::min_element(std::begin(convex_hull), last, algorithms::details::monotone::lexicographic_less{});
+        return std::rotate_copy(std::begin(convex_hull), lowest, last, first2);
+    }
+}
+
+namespace hull::io {
+    /**
+     * Compute the convex hull of the set pixels of a bitmap.
+     * Time complexity: O(P / 64 + R) where P is the number of pixels and R the number of rows.
+     * Space complexity: O(R).
+     * @param bitmap - the bitmap.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the output iterator to the one-past last point of the convex hull.
+     */
+    template <typename TPoint, typename OutputIt>
+    OutputIt bitmap_convex_hull(const bitmap_view& bitmap, OutputIt first2) {
+        static_assert_is_point<TPoint>();
+        
+        std::vector<TPoint> extents;
+        for (std::size_t y{}; y < bitmap.height; y++) {
+            std::size_t left{};
+            std::size_t right{};
+            if (details::raster::row_extent(bitmap.words + y * bitmap.stride, bitmap.width, left, right)) {
+                details::raster::add_extent(extents, y, left, right);
+            }
+        }
+        return details::raster::extents_hull(extents, first2);
+    }
+    
+    /**
+     * Compute the convex hull of the set pixels of a run-length encoded mask.
+     * Time complexity: O(N) where N is the number of runs.
+     * Space complexity: O(R) where R is the number of rows.
+     * @param first - the forward iterator to the first run (see pixel_run).
+     * @param last - the forward iterator to the one-past last run.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @return - the output iterator to the one-past last point of the convex hull.
+     * @throw std::invalid_argument - if the runs are not sorted by row.
+     */
+    template <typename TPoint, typename ForwardIt, typename OutputIt>
+    OutputIt rle_convex_hull(ForwardIt first, ForwardIt last, OutputIt first2) {
+        static_assert_is_point<TPoint>();
+        
+        std::vector<TPoint> extents;
+        bool pending{};
+        std::size_t y{};
+        std::size_t left{};
+        std::size_t right{};
+        for (; first != last; ++first) {
+            const pixel_run& run = *first;
+            if (run.length == 0) {
+                continue;
+            }
+            if (pending && run.y < y) {
+                throw std::invalid_argument("the runs of a mask must be sorted by row");
+            }
+            
+            if (pending && run.y == y) {
+                left = std::min(left, run.x);
+                right = std::max(right, run.x + run.length - 1);
+                continue;
+            }
+            if (pending) {
+                details::raster::add_extent(extents, y, left, right);
+            }
+            pending = true;
+            y = run.y;
+            left = run.x;
+            right = run.x + run.length - 1;
+        }
+        if (pending) {
+            details::raster::add_extent(extents, y, left, right);
+        }
+        return details::raster::extents_hull(extents, first2);
+    }
+}
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * Convex hull of a stream of points, maintained incrementally.
+ * The points arrive in batches. The points of a batch which lie strictly
+ * inside the current hull are discarded in O(log(H)) each, and only the
+ * few survivors are merged with the current hull. On a long stream, almost
+ * every point is discarded by this test, so that the cost per point tends
+ * to a single point location.
+ */
+
+#ifndef running_hull_h
+#define running_hull_h
+
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "point_in_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace hull::algorithms {
+    /**
+     * Incremental convex hull. The hull is kept in the same order as
+     * monotone_chain.
+     */
+    template <typename TPoint>
+    class running_hull {
+    public:
+        /**
+         * Add a batch of points. The batch is read only, so that it may
+         * live in read-only or shared memory.
+         * Average time complexity: O(N * log(H) + S * log(S)) where N is the
+         * number of points, H the number of points on the hull and S the
+         * number of points outside the current hull.
+         * @param first - the forward iterator to the first point of the batch.
+         * @param last - the forward iterator to the one-past last point of the batch.
+         * @return - true if the hull changed.
+         */
+        template <typename ForwardIt>
+        bool add(ForwardIt first, ForwardIt last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            
+            candidates_.clear();
+            const auto begin = std::begin(hull_);
+            const auto end = std::end(hull_);
+            std::copy_if(first, last, std::back_inserter(candidates_), [begin, end](const auto& p) {
+                return !is_strictly_inside(begin, end, p);
+            });
+            points_ += static_cast<std::size_t>(std::distance(first, last));
+            if (candidates_.empty()) {
+                return false;
+            }
+            
+            candidates_.insert(std::end(candidates_), std::begin(hull_), std::end(hull_));
+            merged_.resize(2 * candidates_.size());
+            merged_.erase(monotone_chain(std::begin(candidates_), std::end(candidates_), std::begin(merged_)), std::end(merged_));
+            
+            const auto changed = !std::equal(std::begin(merged_), std::end(merged_), std::begin(hull_), std::end(hull_),
+                                             [](const auto& p1, const auto& p2) { return hull::equals(p1, p2); });
+            std::swap(hull_, merged_);
+            return changed;
+        }
+        
+        /**
+         * @return - the current convex hull.
+         */
+        const std::vector<TPoint>& hull() const noexcept {
+            return hull_;
+        }
+        
+        /**
+         * @return - the number of points added so far.
+         */
+        std::size_t points() const noexcept {
+            return points_;
+        }
+        
+        void clear() noexcept {
+            hull_.clear();
+            points_ = 0;
+        }
+    
+    private:
+        std::vector<TPoint> hull_;
+        std::vector<TPoint> candidates_;
+        std::vector<TPoint> merged_;
+        std::size_t points_{};
+    };
+}
+
+#endif
@@ -0,0 +1,957 @@
+/**
+ * Long-running convex hull service over a Unix domain socket.
+ * Short-lived processes which compute a few small hulls pay for their
+ * startup and cold caches, and use a single core. Instead, they can send
+ * their points to a local server which keeps warm scratch buffers and
+ * runs the requests of all its clients in batches, on all the cores.
+ *
+ * Protocol (every integer is little-endian, every coordinate a float64):
+ *      request     u32 id, u8 policy, 3 reserved bytes, u32 N, then N times x y
+ *      response    u32 id, u8 status, 3 reserved bytes, u32 H, then H times x y
+ * The policy is a policy_code, or stats_request to get the counters of
+ * the server: the response then holds H little-endian u64 counters
+ * instead of points (see server_stats). A client may send several
+ * requests without waiting: the responses of a connection come back in
+ * the order of its requests. A client may also shut down its writing
+ * side once its requests are sent: the responses are still sent before
+ * the connection is closed.
+ *
+ * The server is a single event loop (poll) which reads all the complete
+ * requests available on all the connections, runs them as one batch on a
+ * pool of worker threads, then writes the responses. The requests which
+ * arrive while a batch runs are coalesced into the next one.
+ * Example:
+ *      <code>
+ *      hull::service::server server({"/tmp/hull.sock"});
+ *      std::thread loop([&server] { server.run(); });
+ *      hull::service::client client("/tmp/hull.sock");
+ *      client.compute(hull::choice::monotone_chain, points, convex_hull);
+ *      server.stop();
+ *      loop.join();
+ *      </code>
+ */
+
+#ifndef service_h
+#define service_h
+
+#include "chan_algorithm.hpp"
+#include "graham_scan.hpp"
+#include "jarvis_march.hpp"
+#include "mapped_points.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hull::service {
+    /**
+     * Algorithms available through the service.
+     */
+    enum class policy_code : std::uint8_t {
+        graham_scan = 0,
+        monotone_chain = 1,
+        jarvis_march = 2,
+        chan = 3
+    };
+    
+    constexpr std::size_t policy_count = 4;
+    
+    /**
+     * Policy byte of a request for the counters of the server.
+     */
+    constexpr std::uint8_t stats_request = 0xff;
+    
+    /**
+     * Status of a response.
+     * @param ok - the response holds the convex hull (or the counters).
+     * @param bad_request - the policy is unknown or there are too many points (in
+     *                      this case, the stream cannot be resynchronized and the
+     *                      connection is closed once the response is sent).
+     */
+    enum class status_code : std::uint8_t {
+        ok = 0,
+        bad_request = 1
+    };
+    
+    constexpr policy_code policy_of(graham_scan_t) { return policy_code::graham_scan; }
+    constexpr policy_code policy_of(monotone_chain_t) { return policy_code::monotone_chain; }
+    constexpr policy_code policy_of(jarvis_march_t) { return policy_code::jarvis_march; }
+    constexpr policy_code policy_of(chan_t) { return policy_code::chan; }
+    
+    /**
+     * Options of the server.
+     * @param path - the path of the Unix domain socket (an existing socket file is replaced).
+     * @param threads - the number of worker threads (0 for all hardware threads).
+     * @param max_points - the maximum number of points of a request.
+     * @param parallel_threshold - the minimum number of requests in a batch to use the workers.
+     */
+    struct server_options {
+        std::string path{};
+        std::size_t threads{};
+        std::size_t max_points{std::size_t{1} << 24};
+        std::size_t parallel_threshold{4};
+    };
+    
+    /**
+     * Counters of one policy.
+     * @param requests - the number of requests served.
+     * @param points_in - the total number of points received.
+     * @param points_out - the total number of points on the convex hulls sent.
+     * @param total_latency_ns - the sum of the latencies (from the reception of a
+     *                           whole request to its response being queued).
+     * @param max_latency_ns - the maximum latency.
+     */
+    struct policy_counters {
+        std::uint64_t requests{};
+        std::uint64_t points_in{};
+        std::uint64_t points_out{};
+        std::uint64_t total_latency_ns{};
+        std::uint64_t max_latency_ns{};
+        
+        double mean_latency_ns() const noexcept {
+            return requests == 0 ? 0. : static_cast<double>(total_latency_ns) / static_cast<double>(requests);
+        }
+    };
+    
+    /**
+     * Counters of the server.
+     * @param connections - the number of accepted connections.
+     * @param batches - the number of batches run.
+     * @param batched_requests - the number of requests run in those batches.
+     * @param policies - the counters of each policy, indexed by policy_code.
+     */
+    struct server_stats {
+        std::uint64_t connections{};
+        std::uint64_t batches{};
+        std::uint64_t batched_requests{};
+        std::array<policy_counters, policy_count> policies{};
+        
+        const policy_counters& operator[](policy_code policy) const noexcept {
+            return policies[static_cast<std::size_t>(policy)];
+        }
+    };
+}
+
+namespace hull::service::details {
+    using point_type = std::array<double, 2>;
+    using clock = std::chrono::steady_clock;
+    
+    constexpr std::size_t header_size = 12;
+    constexpr std::size_t point_size = 2 * sizeof(double);
+    constexpr std::size_t stats_fields = 3 + 5 * policy_count;
+    
+    inline void put_u32(std::uint32_t value, unsigned char* p) {
+        io::details::store_little_endian(value, p);
+    }
+    
+    inline std::uint32_t get_u32(const unsigned char* p) {
+        return io::details::load_little_endian<std::uint32_t>(p);
+    }
+    
+    /**
+     * Append a message header.
+     */
+    inline void put_header(std::vector<unsigned char>& out, std::uint32_t id, std::uint8_t code, std::uint32_t count) {
+        const auto size = out.size();
+        out.resize(size + header_size);
+        put_u32(id, out.data() + size);
+        out[size + 4] = code;
+        put_u32(count, out.data() + size + 8);
+    }
+    
+    /**
+     * Append points to a message.
+     */
+    template <typename ForwardIt>
+    void put_points(std::vector<unsigned char>& out, ForwardIt first, ForwardIt last) {
+        auto size = out.size();
+        out.resize(size + static_cast<std::size_t>(std::distance(first, last)) * point_size);
+        for (; first != last; ++first) {
+            io::details::store_little_endian(static_cast<double>(x(*first)), out.data() + size);
+            io::details::store_little_endian(static_cast<double>(y(*first)), out.data() + size + sizeof(double));
+            size += point_size;
+        }
+    }
+    
+    /**
+     * Flatten the counters for a stats response.
+     */
+    inline std::vector<std::uint64_t> flatten(const server_stats& stats) {
+        std::vector<std::uint64_t> fields{stats.connections, stats.batches, stats.batched_requests};
+        for (const auto& counters: stats.policies) {
+            fields.insert(std::end(fields), {counters.requests, counters.points_in, counters.points_out,
+                                             counters.total_latency_ns, counters.max_latency_ns});
+        }
+        return fields;
+    }
+    
+    inline server_stats unflatten(const std::vector<std::uint64_t>& fields) {
+        server_stats stats;
+        stats.connections = fields[0];
+        stats.batches = fields[1];
+        stats.batched_requests = fields[2];
+        for (std::size_t i{}; i < policy_count; i++) {
+            auto& counters = stats.policies[i];
+            const auto field = std::begin(fields) + static_cast<std::ptrdiff_t>(3 + 5 * i);
+            counters.requests = field[0];
+            counters.points_in = field[1];
+            counters.points_out = field[2];
+            counters.total_latency_ns = field[3];
+            counters.max_latency_ns = field[4];
+        }
+        return stats;
+    }
+    
+    /**
+     * A request waiting in a batch.
+     */
+    struct job {
+        std::uint64_t connection{};
+        std::uint64_t slot{};
+        std::uint32_t id{};
+        std::uint8_t policy{};
+        std::vector<unsigned char> payload{};
+        std::vector<unsigned char> response{};
+        std::size_t points_in{};
+        std::size_t points_out{};
+        clock::time_point received{};
+    };
+    
+    /**
+     * Scratch buffers of a worker, kept warm from one job to the next.
+     */
+    struct scratch {
+        std::vector<point_type> input;
+        std::vector<point_type> output;
+    };
+    
+    /**
+     * Compute the convex hull of a job and build its response.
+     */
+    inline void run_job(job& j, scratch& s) {
+        const auto n = j.payload.size() / point_size;
+        s.input.resize(n);
+        for (std::size_t i{}; i < n; i++) {
+            const auto p = j.payload.data() + i * point_size;
+            s.input[i] = {{io::details::load_little_endian<double>(p),
+                           io::details::load_little_endian<double>(p + sizeof(double))}};
+        }
+        
+        auto first = std::begin(s.input);
+        auto last = std::end(s.input);
+        auto policy = static_cast<policy_code>(j.policy);
+        if (n < 3) {
+            // The degenerate cases are handled by Monotone Chain only.
+            policy = policy_code::monotone_chain;
+        }
+        
+        switch (policy) {
+            case policy_code::graham_scan:
+                s.output.assign(first, algorithms::graham_scan(first, last));
+                break;
+            case policy_code::monotone_chain:
+                s.output.resize(2 * n);
+                s.output.erase(algorithms::monotone_chain(first, last, std::begin(s.output)), std::end(s.output));
+                break;
+            case policy_code::jarvis_march:
+                s.output.resize(n);
+                s.output.erase(algorithms::jarvis_march(first, last, std::begin(s.output)), std::end(s.output));
+                break;
+            case policy_code::chan:
+                s.output.clear();
+                algorithms::chan(first, last, std::back_inserter(s.output));
+                break;
+        }
+        
+        j.points_out = s.output.size();
+        j.response.clear();
+        put_header(j.response, j.id, static_cast<std::uint8_t>(status_code::ok), static_cast<std::uint32_t>(s.output.size()));
+        put_points(j.response, std::begin(s.output), std::end(s.output));
+        
+        std::vector<unsigned char>().swap(j.payload);
+    }
+    
+    /**
+     * Persistent pool of worker threads running the items of a batch
+     * (the calling thread takes part in the work).
+     */
+    class worker_pool {
+    public:
+        explicit worker_pool(std::size_t threads) {
+            for (std::size_t i{1}; i < threads; i++) {
+                workers_.emplace_back([this, i] { loop(i); });
+            }
+        }
+        
+        worker_pool(const worker_pool&) = delete;
+        worker_pool& operator=(const worker_pool&) = delete;
+        
+        ~worker_pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            start_.notify_all();
+            for (auto& worker: workers_) {
+                worker.join();
+            }
+        }
+        
+        std::size_t size() const noexcept {
+            return workers_.size() + 1;
+        }
+        
+        /**
+         * Call task(worker, item) for each item of [0 ; count), the items
+         * being shared dynamically between the workers.
+         */
+        void run(std::size_t count, std::function<void(std::size_t, std::size_t)> task) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task_ = std::move(task);
+                count_ = count;
+                next_.store(0);
+                active_ = workers_.size();
+                generation_++;
+            }
+            start_.notify_all();
+            
+            work(0);
+            
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this] { return active_ == 0; });
+        }
+    
+    private:
+        void work(std::size_t worker) {
+            for (auto item = next_.fetch_add(1); item < count_; item = next_.fetch_add(1)) {
+                task_(worker, item);
+            }
+        }
+        
+        void loop(std::size_t worker) {
+            std::uint64_t seen{};
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+                    if (stopping_) {
+                        return ;
+                    }
+                    seen = generation_;
+                }
+                
+                work(worker);
+                
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--active_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+        
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable start_;
+        std::condition_variable done_;
+        std::function<void(std::size_t, std::size_t)> task_;
+        std::size_t count_{};
+        std::atomic<std::size_t> next_{};
+        std::size_t active_{};
+        std::uint64_t generation_{};
+        bool stopping_{};
+    };
+    
+    /**
+     * Build the address of a Unix domain socket.
+     * @throw std::invalid_argument - if the path is too long.
+     */
+    inline sockaddr_un socket_address(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("invalid socket path: " + path);
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+    
+    /**
+     * Remove the socket left at the path by a server which did not
+     * exit cleanly. Anything else at the path is kept.
+     * @throw std::system_error - if the path is not a socket, or if a
+     *                            server still listens on it.
+     */
+    inline void remove_stale_socket(const std::string& path, const sockaddr_un& address) {
+        struct stat status{};
+        if (::lstat(path.c_str(), &status) != 0) {
+            if (errno == ENOENT) {
+                return ;
+            }
+            throw std::system_error(errno, std::generic_category(), "cannot inspect " + path);
+        }
+        if (!S_ISSOCK(status.st_mode)) {
+            throw std::system_error(EEXIST, std::generic_category(), path + " is not a socket");
+        }
+        
+        const auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "cannot create the socket");
+        }
+        const auto connected = ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        const auto error = errno;
+        ::close(fd);
+        if (connected == 0) {
+            throw std::system_error(EADDRINUSE, std::generic_category(), "a server already listens on " + path);
+        }
+        if (error != ECONNREFUSED) {
+            throw std::system_error(error, std::generic_category(), "cannot check the socket " + path);
+        }
+        ::unlink(path.c_str());
+    }
+}
+
+namespace hull::service {
+    /**
+     * The convex hull server (see the description at the top of this file).
+     */
+    class server {
+    public:
+        /**
+         * Create the socket and start listening. The requests are only
+         * served once run is called.
+         * @param options - the options of the server.
+         * @throw std::system_error - if the socket cannot be created, if the path
+         *                            is not a socket, or if a server already listens on it.
+         */
+        explicit server(const server_options& options) :
+            options_{options},
+            pool_{parallel::thread_count(options.threads, parallel::hardware_threads())},
+            scratch_(pool_.size())
+        {
+            const auto address = details::socket_address(options_.path);
+            details::remove_stale_socket(options_.path, address);
+            
+            if (::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) != 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot create the wake-up pipe");
+            }
+            
+            listener_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+            if (listener_ < 0) {
+                const auto error = errno;
+                close_all();
+                throw std::system_error(error, std::generic_category(), "cannot create the socket");
+            }
+            
+            if (::bind(listener_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+                ::listen(listener_, SOMAXCONN) != 0)
+            {
+                const auto error = errno;
+                close_all();
+                throw std::system_error(error, std::generic_category(), "cannot listen on " + options_.path);
+            }
+        }
+        
+        server(const server&) = delete;
+        server& operator=(const server&) = delete;
+        
+        ~server() {
+            close_all();
+            ::unlink(options_.path.c_str());
+        }
+        
+        /**
+         * Serve the requests until stop is called.
+         * @throw std::system_error - if the event loop fails.
+         */
+        void run() {
+            std::vector<pollfd> fds;
+            std::vector<std::uint64_t> ids;
+            std::vector<details::job> batch;
+            
+            while (!stopping_.load()) {
+                fds.assign({pollfd{wake_[0], POLLIN, 0}, pollfd{listener_, POLLIN, 0}});
+                ids.clear();
+                for (const auto& [id, c]: connections_) {
+                    const short events = (c.closing ? 0 : POLLIN) | (c.out.size() > c.written ? POLLOUT : 0);
+                    fds.push_back(pollfd{c.fd, events, 0});
+                    ids.push_back(id);
+                }
+                
+                if (::poll(fds.data(), fds.size(), -1) < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "poll failed");
+                }
+                
+                if (fds[0].revents != 0) {
+                    char drain[64];
+                    while (::read(wake_[0], drain, sizeof(drain)) > 0) {
+                    }
+                }
+                if (fds[1].revents & POLLIN) {
+                    accept_all();
+                }
+                
+                // Gather all the complete requests of all the connections.
+                for (std::size_t i{}; i < ids.size(); i++) {
+                    const auto it = connections_.find(ids[i]);
+                    if (!it->second.closing && (fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR))) {
+                        if (!receive(it->first, it->second, batch)) {
+                            ::close(it->second.fd);
+                            connections_.erase(it);
+                        }
+                    }
+                }
+                
+                run_batch(batch);
+                
+                for (auto it = std::begin(connections_); it != std::end(connections_);) {
+                    auto& c = it->second;
+                    if (!send(c) || (c.closing && c.slots.empty() && c.out.empty())) {
+                        ::close(c.fd);
+                        it = connections_.erase(it);
+                    }
+                    else {
+                        ++it;
+                    }
+                }
+            }
+        }
+        
+        /**
+         * Ask run to return. It may be called from any thread, and from
+         * a signal handler.
+         */
+        void stop() noexcept {
+            stopping_.store(true);
+            const char byte{};
+            [[maybe_unused]] const auto n = ::write(wake_[1], &byte, 1);
+        }
+        
+        /**
+         * @return - a snapshot of the counters.
+         */
+        server_stats stats() const {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            return stats_;
+        }
+        
+        const std::string& path() const noexcept {
+            return options_.path;
+        }
+    
+    private:
+        /**
+         * Response slot of a request: the responses are queued in the order
+         * of the requests, and sent once all the responses before them are ready.
+         */
+        struct slot {
+            bool ready{};
+            std::vector<unsigned char> response{};
+        };
+        
+        /**
+         * State of a connection.
+         * @param closing - the client shut down its writing side, or sent a request
+         *                  which cannot be read: nothing more is read, and the
+         *                  connection is closed once its responses are sent.
+         * @param first_slot - the sequence number of the first slot.
+         */
+        struct connection {
+            int fd{-1};
+            std::vector<unsigned char> in{};
+            std::vector<unsigned char> out{};
+            std::size_t written{};
+            std::deque<slot> slots{};
+            std::uint64_t first_slot{};
+            bool closing{};
+            
+            /**
+             * @return - the sequence number of a new slot at the end of the queue.
+             */
+            std::uint64_t open_slot() {
+                slots.emplace_back();
+                return first_slot + slots.size() - 1;
+            }
+            
+            /**
+             * Fill a slot, and move the ready responses at the front of the queue to the output.
+             */
+            void fill(std::uint64_t sequence, std::vector<unsigned char> response) {
+                auto& s = slots[static_cast<std::size_t>(sequence - first_slot)];
+                s.ready = true;
+                s.response = std::move(response);
+                for (; !slots.empty() && slots.front().ready; first_slot++) {
+                    out.insert(std::end(out), std::begin(slots.front().response), std::end(slots.front().response));
+                    slots.pop_front();
+                }
+            }
+        };
+        
+        void close_all() noexcept {
+            for (const auto& entry: connections_) {
+                ::close(entry.second.fd);
+            }
+            connections_.clear();
+            for (auto fd: {listener_, wake_[0], wake_[1]}) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+            listener_ = wake_[0] = wake_[1] = -1;
+        }
+        
+        void accept_all() {
+            for (;;) {
+                const auto fd = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+                if (fd < 0) {
+                    return ;
+                }
+                connections_[next_connection_++].fd = fd;
+                
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.connections++;
+            }
+        }
+        
+        /**
+         * Read what is available on a connection and move its complete
+         * requests to the batch. Each request gets a response slot, filled
+         * here for the stats and bad requests, or by run_batch.
+         * At the end of the stream, the connection is only marked as closing.
+         * @return - false if the connection must be closed at once.
+         */
+        bool receive(std::uint64_t id, connection& c, std::vector<details::job>& batch) {
+            unsigned char buffer[1 << 16];
+            for (;;) {
+                const auto n = ::read(c.fd, buffer, sizeof(buffer));
+                if (n > 0) {
+                    c.in.insert(std::end(c.in), buffer, buffer + n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n == 0) {
+                    c.closing = true;
+                }
+                else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    return false;
+                }
+                break;
+            }
+            
+            std::size_t offset{};
+            while (c.in.size() - offset >= details::header_size) {
+                const auto header = c.in.data() + offset;
+                const auto request_id = details::get_u32(header);
+                const auto policy = header[4];
+                const auto count = static_cast<std::size_t>(details::get_u32(header + 8));
+                
+                if (count > options_.max_points) {
+                    // The stream cannot be resynchronized: answer, then close.
+                    std::vector<unsigned char> response;
+                    details::put_header(response, request_id, static_cast<std::uint8_t>(status_code::bad_request), 0);
+                    c.fill(c.open_slot(), std::move(response));
+                    c.closing = true;
+                    c.in.clear();
+                    return true;
+                }
+                const auto size = details::header_size + count * details::point_size;
+                if (c.in.size() - offset < size) {
+                    break;
+                }
+                
+                if (policy == stats_request) {
+                    const auto fields = details::flatten(stats());
+                    std::vector<unsigned char> response;
+                    details::put_header(response, request_id, static_cast<std::uint8_t>(status_code::ok),
+                                        static_cast<std::uint32_t>(fields.size()));
+                    for (const auto field: fields) {
+                        response.resize(response.size() + sizeof(field));
+                        io::details::store_little_endian(field, response.data() + response.size() - sizeof(field));
+                    }
+                    c.fill(c.open_slot(), std::move(response));
+                }
+                else if (policy >= policy_count) {
+                    std::vector<unsigned char> response;
+                    details::put_header(response, request_id, static_cast<std::uint8_t>(status_code::bad_request), 0);
+                    c.fill(c.open_slot(), std::move(response));
+                }
+                else {
+                    details::job j;
+                    j.connection = id;
+                    j.slot = c.open_slot();
+                    j.id = request_id;
+                    j.policy = policy;
+                    j.points_in = count;
+                    j.payload.assign(header + details::header_size, header + size);
+                    j.received = details::clock::now();
+                    batch.push_back(std::move(j));
+                }
+                offset += size;
+            }
+            c.in.erase(std::begin(c.in), std::begin(c.in) + static_cast<std::ptrdiff_t>(offset));
+            
+            return true;
+        }
+        
+        /**
+         * Run a batch of requests and queue their responses.
+         */
+        void run_batch(std::vector<details::job>& batch) {
+            if (batch.empty()) {
+                return ;
+            }
+            
+            if (batch.size() < options_.parallel_threshold || pool_.size() == 1) {
+                for (auto& j: batch) {
+                    details::run_job(j, scratch_[0]);
+                }
+            }
+            else {
+                pool_.run(batch.size(), [this, &batch](std::size_t worker, std::size_t item) {
+                    details::run_job(batch[item], scratch_[worker]);
+                });
+            }
+            
+            const auto now = details::clock::now();
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.batches++;
+            stats_.batched_requests += batch.size();
+            for (auto& j: batch) {
+                const auto latency = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::operator-(now, j.received)).count());
+                auto& counters = stats_.policies[j.policy];
+                counters.requests++;
+                counters.points_in += j.points_in;
+                counters.points_out += j.points_out;
+                counters.total_latency_ns += latency;
+                counters.max_latency_ns = std::max(counters.max_latency_ns, latency);
+                
+                const auto it = connections_.find(j.connection);
+                if (it != std::end(connections_)) {
+                    it->second.fill(j.slot, std::move(j.response));
+                }
+            }
+            batch.clear();
+        }
+        
+        /**
+         * Write the pending responses of a connection.
+         * @return - false if the connection must be closed.
+         */
+        bool send(connection& c) {
+            while (c.written < c.out.size()) {
+                const auto n = ::send(c.fd, c.out.data() + c.written, c.out.size() - c.written, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return errno == EAGAIN || errno == EWOULDBLOCK;
+                }
+                c.written += static_cast<std::size_t>(n);
+            }
+            c.out.clear();
+            c.written = 0;
+            return true;
+        }
+        
+        server_options options_;
+        details::worker_pool pool_;
+        std::vector<details::scratch> scratch_;
+        int listener_{-1};
+        int wake_[2]{-1, -1};
+        std::atomic<bool> stopping_{};
+        std::map<std::uint64_t, connection> connections_;
+        std::uint64_t next_connection_{};
+        mutable std::mutex stats_mutex_;
+        server_stats stats_;
+    };
+    
+    /**
+     * Blocking client of the convex hull server.
+     */
+    class client {
+    public:
+        /**
+         * Connect to a server.
+         * @param path - the path of the Unix domain socket.
+         * @throw std::system_error - if the server cannot be reached.
+         */
+        explicit client(const std::string& path) {
+            const auto address = details::socket_address(path);
+            fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot create the socket");
+            }
+            if (::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+                const auto error = errno;
+                ::close(fd_);
+                throw std::system_error(error, std::generic_category(), "cannot connect to " + path);
+            }
+        }
+        
+        client(const client&) = delete;
+        client& operator=(const client&) = delete;
+        
+        ~client() {
+            ::close(fd_);
+        }
+        
+        /**
+         * Send a request without waiting for its response.
+         * @param policy - the algorithm policy.
+         * @param c1 - the points.
+         * @return - the id of the request.
+         * @throw std::system_error - if the request cannot be sent.
+         */
+        template <typename Policy, typename TContainer>
+        std::uint32_t send(Policy policy, const TContainer& c1) {
+            std::vector<unsigned char> message;
+            const auto id = next_id_++;
+            details::put_header(message, id, static_cast<std::uint8_t>(policy_of(policy)),
+                                static_cast<std::uint32_t>(std::distance(std::begin(c1), std::end(c1))));
+            details::put_points(message, std::begin(c1), std::end(c1));
+            write_all(message);
+            return id;
+        }
+        
+        /**
+         * Receive the next response. The points are appended to c2.
+         * @param c2 - the container of the convex hull.
+         * @return - the id of the request.
+         * @throw std::runtime_error - if the server rejected the request.
+         */
+        template <typename TContainer>
+        std::uint32_t receive(TContainer& c2) {
+            using point_type = typename TContainer::value_type;
+            using coordinate_type = std::decay_t<coordinate_t<point_type>>;
+            
+            std::uint8_t status{};
+            std::uint32_t count{};
+            const auto id = read_header(status, count);
+            
+            std::vector<unsigned char> bytes(count * details::point_size);
+            read_all(bytes.data(), bytes.size());
+            if (status != static_cast<std::uint8_t>(status_code::ok)) {
+                throw std::runtime_error("the hull server rejected the request");
+            }
+            
+            for (std::size_t i{}; i < count; i++) {
+                const auto p = bytes.data() + i * details::point_size;
+                c2.push_back(make_point<point_type>(
+                    static_cast<coordinate_type>(io::details::load_little_endian<double>(p)),
+                    static_cast<coordinate_type>(io::details::load_little_endian<double>(p + sizeof(double)))));
+            }
+            return id;
+        }
+        
+        /**
+         * Compute a convex hull on the server (round trip).
+         * @param policy - the algorithm policy.
+         * @param c1 - the points.
+         * @param c2 - the container of the convex hull (cleared first).
+         */
+        template <typename Policy, typename TContainer1, typename TContainer2>
+        void compute(Policy policy, const TContainer1& c1, TContainer2& c2) {
+            send(policy, c1);
+            c2.clear();
+            receive(c2);
+        }
+        
+        /**
+         * @return - the counters of the server.
+         */
+        server_stats stats() {
+            std::vector<unsigned char> message;
+            details::put_header(message, next_id_++, stats_request, 0);
+            write_all(message);
+            
+            std::uint8_t status{};
+            std::uint32_t count{};
+            read_header(status, count);
+            std::vector<unsigned char> bytes(count * sizeof(std::uint64_t));
+            read_all(bytes.data(), bytes.size());
+            if (count != details::stats_fields) {
+                throw std::runtime_error("unexpected counters from the hull server");
+            }
+            
+            std::vector<std::uint64_t> fields(count);
+            for (std::size_t i{}; i < count; i++) {
+                fields[i] = io::details::load_little_endian<std::uint64_t>(bytes.data() + i * sizeof(std::uint64_t));
+            }
+            return details::unflatten(fields);
+        }
+    
+    private:
+        void write_all(const std::vector<unsigned char>& message) {
+            std::size_t written{};
+            while (written < message.size()) {
+                const auto n = ::send(fd_, message.data() + written, message.size() - written, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "cannot send a request");
+                }
+                written += static_cast<std::size_t>(n);
+            }
+        }
+        
+        void read_all(unsigned char* p, std::size_t size) {
+            while (size != 0) {
+                const auto n = ::read(fd_, p, size);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    throw std::system_error(n == 0 ? ECONNRESET : errno, std::generic_category(), "cannot read a response");
+                }
+                p += n;
+                size -= static_cast<std::size_t>(n);
+            }
+        }
+        
+        std::uint32_t read_header(std::uint8_t& status, std::uint32_t& count) {
+            unsigned char header[details::header_size];
+            read_all(header, sizeof(header));
+            status = header[4];
+            count = details::get_u32(header + 8);
+            return details::get_u32(header);
+        }
+        
+        int fd_{-1};
+        std::uint32_t next_id_{};
+    };
+}
+
+#endif
@@ -0,0 +1,296 @@
+/**
+ * Multi-process convex hull of a flat binary point file (see
+ * mapped_points.hpp for the file layout).
+ * The file is mapped once, then N worker processes are forked. Each
+ * worker computes the convex hull of a contiguous range of points and
+ * sends it back to the parent through a pipe. The parent merges the
+ * partial hulls with a reduction tree (see hull_merge.hpp).
+ * The only thing exchanged between the processes is a partial hull,
+ * serialized as a self-contained message (a point count followed by the
+ * coordinates): the same messages can be carried over shared memory or
+ * a network transport (MPI and the like) when the shards run on
+ * several nodes.
+ * Since the workers are forked, this driver should be called before
+ * the program starts other threads.
+ */
+
+#ifndef sharded_hull_h
+#define sharded_hull_h
+
+#include "algorithms.hpp"
+#include "hull_merge.hpp"
+#include "mapped_points.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "prefilter.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace hull::io {
+    /**
+     * Options of the sharded convex hull.
+     * @param processes - the number of worker processes (0 for one per hardware thread).
+     * @param merge_threads - the number of threads of the final reduction tree (0 for all).
+     */
+    struct shard_options {
+        std::size_t processes{};
+        std::size_t merge_threads{};
+    };
+    
+    /**
+     * Statistics of a sharded computation.
+     * @param processes - the number of worker processes actually used.
+     * @param points - the number of points in the file.
+     * @param partial_points - the total number of vertices of the partial hulls.
+     */
+    struct shard_stats {
+        std::size_t processes{};
+        std::size_t points{};
+        std::size_t partial_points{};
+    };
+}
+
+namespace hull::io::details::sharded {
+    /**
+     * Write a whole buffer to a file descriptor.
+     * @return - false on error.
+     */
+    inline bool write_all(int fd, const void* data, std::size_t size) {
+        auto p = static_cast<const char*>(data);
+        while (size != 0) {
+            const auto n = ::write(fd, p, size);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            p += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+    
+    /**
+     * Read a whole buffer from a file descriptor.
+     * @return - false on error or if the stream ends before the buffer is full.
+     */
+    inline bool read_all(int fd, void* data, std::size_t size) {
+        auto p = static_cast<char*>(data);
+        while (size != 0) {
+            const auto n = ::read(fd, p, size);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (n == 0) {
+                return false;
+            }
+            p += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+    
+    /**
+     * Serialize a partial hull: a little-endian 64-bit count of
+     * points, followed by the interleaved little-endian coordinates.
+     */
+    template <typename T, typename TPoint>
+    std::vector<unsigned char> encode(const std::vector<TPoint>& points) {
+        std::vector<unsigned char> message(sizeof(std::uint64_t) + points.size() * 2 * sizeof(T));
+        store_little_endian(static_cast<std::uint64_t>(points.size()), message.data());
+        auto p = message.data() + sizeof(std::uint64_t);
+        for (const auto& point: points) {
+            store_little_endian<T>(x(point), p);
+            store_little_endian<T>(y(point), p + sizeof(T));
+            p += 2 * sizeof(T);
+        }
+        return message;
+    }
+    
+    /**
+     * Receive a partial hull (see encode).
+     * @throw std::runtime_error - if the message is incomplete.
+     */
+    template <typename T, typename TPoint>
+    std::vector<TPoint> receive(int fd) {
+        unsigned char header[sizeof(std::uint64_t)];
+        if (!read_all(fd, header, sizeof(header))) {
+            throw std::runtime_error("incomplete partial hull from a worker process");
+        }
+        const auto count = static_cast<std::size_t>(load_little_endian<std::uint64_t>(header));
+        
+        std::vector<unsigned char> bytes(count * 2 * sizeof(T));
+        if (!read_all(fd, bytes.data(), bytes.size())) {
+            throw std::runtime_error("incomplete partial hull from a worker process");
+        }
+        
+        std::vector<TPoint> points;
+        points.reserve(count);
+        for (std::size_t i{}; i < count; i++) {
+            const auto p = bytes.data() + 2 * i * sizeof(T);
+            points.push_back(make_point<TPoint>(load_little_endian<T>(p), load_little_endian<T>(p + sizeof(T))));
+        }
+        return points;
+    }
+    
+    /**
+     * Body of a worker process: compute the convex hull of a range of
+     * points and send it. Never returns.
+     */
+    template <typename T, typename TPoint, typename Policy>
+    [[noreturn]] void work(const mapped_points<T, TPoint>& points, std::size_t begin, std::size_t end,
+                           Policy policy, int fd) noexcept
+    {
+        auto status = 1;
+        try {
+            const auto first = std::begin(points) + static_cast<std::ptrdiff_t>(begin);
+            const auto last = std::begin(points) + static_cast<std::ptrdiff_t>(end);
+            points.advise(access_pattern::sequential, begin, end - begin);
+            
+            std::vector<TPoint> survivors;
+            algorithms::akl_toussaint(first, last, std::back_inserter(survivors));
+            std::vector<TPoint> partial;
+            if (!survivors.empty()) {
+                convex::compute(policy, survivors, partial);
+            }
+            
+            const auto message = encode<T>(partial);
+            status = write_all(fd, message.data(), message.size()) ? 0 : 1;
+        }
+        catch (...) {
+        }
+        // _exit: the worker must not run the atexit handlers
+        // nor flush the stdio buffers inherited from the parent.
+        ::_exit(status);
+    }
+}
+
+namespace hull::io {
+    /**
+     * Compute the convex hull of a flat binary point file with several
+     * worker processes (see the description at the top of this file).
+     * The output is in the same order as monotone_chain.
+     * Average time complexity: O(N * log(N) / P) where N is the number of
+     * points and P the number of processes.
+     * @param path - the path to the file.
+     * @param first2 - the output iterator to the first point of the destination container.
+     * @param policy - the algorithm used by the workers.
+     * @param options - the options of the computation.
+     * @param stats - if not null, filled with statistics about the computation.
+     * @return - the iterator to the one-past last point of the convex hull.
+     * @throw std::system_error - if the file cannot be mapped or a worker cannot be started.
+     * @throw std::runtime_error - if a worker fails.
+     */
+    template <
+        typename T,
+        typename TPoint = std::array<T, 2>,
+        typename OutputIt,
+        typename Policy = monotone_chain_t
+    >
+    OutputIt sharded_convex_hull(const std::string& path, OutputIt first2, Policy policy = choice::monotone_chain,
+                                 const shard_options& options = {}, shard_stats* stats = nullptr)
+    {
+        static_assert_is_point<TPoint>();
+        
+        const mapped_points<T, TPoint> points(path);
+        const auto n = points.size();
+        const auto processes = parallel::thread_count(options.processes, n);
+        
+        struct worker {
+            pid_t pid{-1};
+            int fd{-1};
+        };
+        std::vector<worker> workers;
+        workers.reserve(processes);
+        
+        // Reap all the started workers, whatever happens.
+        auto wait_all = [&workers] {
+            auto ok = true;
+            for (auto& w: workers) {
+                if (w.fd >= 0) {
+                    ::close(w.fd);
+                    w.fd = -1;
+                }
+                auto status = 0;
+                while (::waitpid(w.pid, &status, 0) < 0 && errno == EINTR) {
+                }
+                ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            }
+            workers.clear();
+            return ok;
+        };
+        
+        std::vector<std::vector<TPoint>> partial_hulls(processes);
+        try {
+            for (std::size_t i{}; i < processes; i++) {
+                int fds[2];
+                if (::pipe(fds) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "cannot create a pipe");
+                }
+                
+                const auto pid = ::fork();
+                if (pid < 0) {
+                    const auto error = errno;
+                    ::close(fds[0]);
+                    ::close(fds[1]);
+                    throw std::system_error(error, std::generic_category(), "cannot start a worker process");
+                }
+                if (pid == 0) {
+                    ::close(fds[0]);
+                    for (const auto& w: workers) {
+                        ::close(w.fd);
+                    }
+                    details::sharded::work(points, n * i / processes, n * (i + 1) / processes, policy, fds[1]);
+                }
+                
+                ::close(fds[1]);
+                workers.push_back(worker{pid, fds[0]});
+            }
+            
+            for (std::size_t i{}; i < processes; i++) {
+                partial_hulls[i] = details::sharded::receive<T, TPoint>(workers[i].fd);
+            }
+        }
+        catch (...) {
+            wait_all();
+            throw;
+        }
+        
+        if (!wait_all()) {
+            throw std::runtime_error("a worker process failed");
+        }
+        
+        const auto convex_hull = algorithms::merge_hull_tree(std::begin(partial_hulls), std::end(partial_hulls),
+                                                             options.merge_threads);
+        
+        if (stats != nullptr) {
+            stats->processes = processes;
+            stats->points = n;
+            stats->partial_points = 0;
+            for (const auto& partial: partial_hulls) {
+                stats->partial_points += partial.size();
+            }
+        }
+        
+        return std::copy(std::begin(convex_hull), std::end(convex_hull), first2);
+    }
+}
+
+#endif
@@ -0,0 +1,550 @@
+/**
+ * Zero-copy point feeds between processes through shared memory.
+ * A producer process (for instance a sensor-fusion process) writes batches
+ * of points into a single-producer single-consumer ring living in a POSIX
+ * shared memory segment. The consumer process maintains the convex hull of
+ * the stream straight from the ring memory (the batches are never copied)
+ * and publishes the latest hull into a second shared segment, which any
+ * number of readers may poll.
+ * Layout of the ring segment (host byte order, the processes share a machine):
+ *      header      magic "HULLRNG1", coordinate size, slot count and slot size,
+ *                  then the head and tail counters on their own cache lines
+ *      slots       slot count times: u64 number of points, then the interleaved
+ *                  coordinates x0 y0 x1 y1 ... (at most slot_points points)
+ * Layout of the hull segment:
+ *      header      magic "HULLPUB1", coordinate size, capacity, then a sequence
+ *                  counter (seqlock: odd while the hull is being written)
+ *      hull        u64 number of vertices, then the interleaved coordinates
+ * Example:
+ *      <code>
+ *      // Producer process
+ *      auto ring = hull::io::point_ring_producer<float>::create("/points", 64, 4096);
+ *      ring.push(std::begin(batch), std::end(batch));
+ *      // Consumer process
+ *      auto ring = hull::io::point_ring_consumer<float>::open("/points");
+ *      auto hull = hull::io::hull_publisher<float>::create("/hull", 4096);
+ *      hull::io::follow_ring(ring, hull);
+ *      </code>
+ */
+
+#ifndef shm_ring_h
+#define shm_ring_h
+
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "running_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hull::io {
+    /**
+     * RAII read-write mapping of a POSIX shared memory segment.
+     */
+    class shared_memory {
+    public:
+        shared_memory() = default;
+        
+        /**
+         * Create (or replace) a segment of the given size.
+         * @param name - the name of the segment ("/name").
+         * @param size - the size in bytes.
+         * @throw std::system_error - if the segment cannot be created.
+         */
+        static shared_memory create(const std::string& name, std::size_t size) {
+            ::shm_unlink(name.c_str());
+            const auto fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot create shared memory " + name);
+            }
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                const auto error = errno;
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                throw std::system_error(error, std::generic_category(), "cannot size shared memory " + name);
+            }
+            return shared_memory(fd, size, name, true);
+        }
+        
+        /**
+         * Map an existing segment.
+         * @param name - the name of the segment ("/name").
+         * @throw std::system_error - if the segment cannot be opened.
+         */
+        static shared_memory open(const std::string& name) {
+            const auto fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot open shared memory " + name);
+            }
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                const auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "cannot stat shared memory " + name);
+            }
+            return shared_memory(fd, static_cast<std::size_t>(st.st_size), name, false);
+        }
+        
+        shared_memory(const shared_memory&) = delete;
+        shared_memory& operator=(const shared_memory&) = delete;
+        
+        shared_memory(shared_memory&& other) noexcept {
+            swap(other);
+        }
+        
+        shared_memory& operator=(shared_memory&& other) noexcept {
+            shared_memory(std::move(other)).swap(*this);
+            return *this;
+        }
+        
+        /**
+         * Unmap the segment. The creator also removes its name.
+         */
+        ~shared_memory() {
+            if (data_ != nullptr) {
+                ::munmap(data_, size_);
+            }
+            if (owner_) {
+                ::shm_unlink(name_.c_str());
+            }
+        }
+        
+        void swap(shared_memory& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(name_, other.name_);
+            std::swap(owner_, other.owner_);
+        }
+        
+        unsigned char* data() const noexcept {
+            return data_;
+        }
+        
+        std::size_t size() const noexcept {
+            return size_;
+        }
+    
+    private:
+        shared_memory(int fd, std::size_t size, const std::string& name, bool owner) : size_{size}, name_{name}, owner_{owner} {
+            const auto address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            const auto error = errno;
+            ::close(fd);
+            if (address == MAP_FAILED) {
+                if (owner) {
+                    ::shm_unlink(name.c_str());
+                }
+                throw std::system_error(error, std::generic_category(), "cannot map shared memory " + name);
+            }
+            data_ = static_cast<unsigned char*>(address);
+        }
+        
+        unsigned char* data_{};
+        std::size_t size_{};
+        std::string name_{};
+        bool owner_{};
+    };
+}
+
+namespace hull::io::details::shm {
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the shared counters must be lock-free");
+    
+    constexpr std::size_t cache_line = 64;
+    
+    constexpr std::size_t round_up(std::size_t size) {
+        return (size + cache_line - 1) / cache_line * cache_line;
+    }
+    
+    struct ring_header {
+        char magic[8];
+        std::uint64_t coordinate_size;
+        std::uint64_t slots;
+        std::uint64_t slot_points;
+        alignas(cache_line) std::atomic<std::uint64_t> head;
+        alignas(cache_line) std::atomic<std::uint64_t> tail;
+        alignas(cache_line) std::atomic<std::uint64_t> closed;
+    };
+    
+    struct publication_header {
+        char magic[8];
+        std::uint64_t coordinate_size;
+        std::uint64_t capacity;
+        alignas(cache_line) std::atomic<std::uint64_t> sequence;
+        alignas(cache_line) std::uint64_t count;
+    };
+    
+    /**
+     * The points of the slots are stored as std::array<T, 2>, so that
+     * a batch is a plain array of points for the algorithms.
+     */
+    template <typename T>
+    using slot_point = std::array<T, 2>;
+    
+    template <typename T>
+    constexpr std::size_t slot_stride(std::size_t slot_points) {
+        static_assert(sizeof(slot_point<T>) == 2 * sizeof(T), "points must be tightly packed");
+        return round_up(sizeof(std::uint64_t) + slot_points * sizeof(slot_point<T>));
+    }
+    
+    inline void check_magic(const char* magic, const char* expected, std::uint64_t coordinate_size, std::size_t size) {
+        if (std::memcmp(magic, expected, 8) != 0 || coordinate_size != size) {
+            throw std::runtime_error("unexpected shared memory segment");
+        }
+    }
+}
+
+namespace hull::io {
+    /**
+     * A batch of points read in place from the ring.
+     */
+    template <typename T>
+    struct point_batch {
+        const std::array<T, 2>* first{};
+        const std::array<T, 2>* last{};
+        
+        const std::array<T, 2>* begin() const noexcept { return first; }
+        const std::array<T, 2>* end() const noexcept { return last; }
+        std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+    };
+    
+    /**
+     * Producer side of a shared memory ring of point batches.
+     */
+    template <typename T>
+    class point_ring_producer {
+    public:
+        /**
+         * Create the ring.
+         * @param name - the name of the shared memory segment.
+         * @param slots - the number of batches the ring can hold.
+         * @param slot_points - the maximum number of points of a batch.
+         * @throw std::system_error - if the segment cannot be created.
+         */
+        static point_ring_producer create(const std::string& name, std::size_t slots, std::size_t slot_points) {
+            using namespace details::shm;
+            slots = std::max<std::size_t>(1, slots);
+            slot_points = std::max<std::size_t>(1, slot_points);
+            
+            auto memory = shared_memory::create(name, round_up(sizeof(ring_header)) + slots * slot_stride<T>(slot_points));
+            auto header = new (memory.data()) ring_header{};
+            std::memcpy(header->magic, "HULLRNG1", 8);
+            header->coordinate_size = sizeof(T);
+            header->slots = slots;
+            header->slot_points = slot_points;
+            return point_ring_producer(std::move(memory));
+        }
+        
+        /**
+         * Reserve the next slot, waiting while the ring is full.
+         * Fill it through the returned pointer, then call commit.
+         * @return - the first point of the slot (room for slot_points() points).
+         */
+        std::array<T, 2>* acquire() {
+            const auto tail = header()->tail.load(std::memory_order_relaxed);
+            for (std::size_t attempt{}; tail - header()->head.load(std::memory_order_acquire) >= header()->slots; attempt++) {
+                parallel::backoff(attempt);
+            }
+            return points(tail);
+        }
+        
+        /**
+         * Publish the slot reserved by acquire.
+         * @param count - the number of points written in the slot.
+         */
+        void commit(std::size_t count) {
+            const auto tail = header()->tail.load(std::memory_order_relaxed);
+            *count_of(tail) = std::min<std::uint64_t>(count, header()->slot_points);
+            header()->tail.store(tail + 1, std::memory_order_release);
+        }
+        
+        /**
+         * Copy points into the ring, as many batches as needed.
+         * @param first - the forward iterator to the first point.
+         * @param last - the forward iterator to the one-past last point.
+         */
+        template <typename ForwardIt>
+        void push(ForwardIt first, ForwardIt last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            while (first != last) {
+                auto slot = acquire();
+                std::size_t count{};
+                for (; first != last && count < slot_points(); ++first, ++count) {
+                    slot[count] = {{static_cast<T>(x(*first)), static_cast<T>(y(*first))}};
+                }
+                commit(count);
+            }
+        }
+        
+        /**
+         * Tell the consumer that the feed is over.
+         */
+        void close() noexcept {
+            header()->closed.store(1, std::memory_order_release);
+        }
+        
+        std::size_t slot_points() const noexcept {
+            return static_cast<std::size_t>(header()->slot_points);
+        }
+    
+    private:
+        explicit point_ring_producer(shared_memory memory) : memory_{std::move(memory)} {}
+        
+        details::shm::ring_header* header() const noexcept {
+            return reinterpret_cast<details::shm::ring_header*>(memory_.data());
+        }
+        
+        unsigned char* slot(std::uint64_t index) const noexcept {
+            using namespace details::shm;
+            return memory_.data() + round_up(sizeof(ring_header)) + (index % header()->slots) * slot_stride<T>(header()->slot_points);
+        }
+        
+        std::uint64_t* count_of(std::uint64_t index) const noexcept {
+            return reinterpret_cast<std::uint64_t*>(slot(index));
+        }
+        
+        std::array<T, 2>* points(std::uint64_t index) const noexcept {
+            return reinterpret_cast<std::array<T, 2>*>(slot(index) + sizeof(std::uint64_t));
+        }
+        
+        shared_memory memory_;
+    };
+    
+    /**
+     * Consumer side of a shared memory ring of point batches.
+     */
+    template <typename T>
+    class point_ring_consumer {
+    public:
+        /**
+         * Open a ring created by a producer.
+         * @param name - the name of the shared memory segment.
+         * @throw std::system_error - if the segment cannot be opened.
+         * @throw std::runtime_error - if the segment is not a ring of this coordinate type.
+         */
+        static point_ring_consumer open(const std::string& name) {
+            auto memory = shared_memory::open(name);
+            if (memory.size() < sizeof(details::shm::ring_header)) {
+                throw std::runtime_error("unexpected shared memory segment");
+            }
+            const auto header = reinterpret_cast<const details::shm::ring_header*>(memory.data());
+            details::shm::check_magic(header->magic, "HULLRNG1", header->coordinate_size, sizeof(T));
+            return point_ring_consumer(std::move(memory));
+        }
+        
+        /**
+         * Look at the oldest batch without waiting. The batch stays valid
+         * (and its slot reserved) until release is called.
+         * @param batch - the batch, in place in the ring.
+         * @return - false if the ring is empty.
+         */
+        bool try_peek(point_batch<T>& batch) const noexcept {
+            const auto head = header()->head.load(std::memory_order_relaxed);
+            if (head == header()->tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            const auto slot = this->slot(head);
+            const auto count = std::min(*reinterpret_cast<const std::uint64_t*>(slot), header()->slot_points);
+            batch.first = reinterpret_cast<const std::array<T, 2>*>(slot + sizeof(std::uint64_t));
+            batch.last = batch.first + count;
+            return true;
+        }
+        
+        /**
+         * Wait for the oldest batch.
+         * @param batch - the batch, in place in the ring.
+         * @return - false once the producer has closed the ring and it is drained.
+         */
+        bool peek(point_batch<T>& batch) const {
+            for (std::size_t attempt{}; !try_peek(batch); attempt++) {
+                if (header()->closed.load(std::memory_order_acquire) != 0) {
+                    // The last batches may have been committed just before closing.
+                    return try_peek(batch);
+                }
+                parallel::backoff(attempt);
+            }
+            return true;
+        }
+        
+        /**
+         * Give the slot of the oldest batch back to the producer.
+         */
+        void release() noexcept {
+            header()->head.fetch_add(1, std::memory_order_release);
+        }
+    
+    private:
+        explicit point_ring_consumer(shared_memory memory) : memory_{std::move(memory)} {}
+        
+        details::shm::ring_header* header() const noexcept {
+            return reinterpret_cast<details::shm::ring_header*>(memory_.data());
+        }
+        
+        const unsigned char* slot(std::uint64_t index) const noexcept {
+            using namespace details::shm;
+            return memory_.data() + round_up(sizeof(ring_header)) + (index % header()->slots) * slot_stride<T>(header()->slot_points);
+        }
+        
+        shared_memory memory_;
+    };
+    
+    /**
+     * Writer of the latest convex hull into a shared memory segment.
+     * Readers never block the writer: a seqlock tells them whether they
+     * read a consistent hull.
+     */
+    template <typename T>
+    class hull_publisher {
+    public:
+        /**
+         * Create the segment.
+         * @param name - the name of the shared memory segment.
+         * @param capacity - the maximum number of vertices of a published hull.
+         * @throw std::system_error - if the segment cannot be created.
+         */
+        static hull_publisher create(const std::string& name, std::size_t capacity) {
+            using namespace details::shm;
+            auto memory = shared_memory::create(name, round_up(sizeof(publication_header)) + capacity * sizeof(slot_point<T>));
+            auto header = new (memory.data()) publication_header{};
+            std::memcpy(header->magic, "HULLPUB1", 8);
+            header->coordinate_size = sizeof(T);
+            header->capacity = capacity;
+            return hull_publisher(std::move(memory));
+        }
+        
+        /**
+         * Publish a hull.
+         * @param first - the forward iterator to the first vertex.
+         * @param last - the forward iterator to the one-past last vertex.
+         * @throw std::length_error - if the hull has more vertices than the capacity.
+         */
+        template <typename ForwardIt>
+        void publish(ForwardIt first, ForwardIt last) {
+            static_assert_is_forward_iterator_to_point<ForwardIt>();
+            auto header = reinterpret_cast<details::shm::publication_header*>(memory_.data());
+            const auto count = static_cast<std::uint64_t>(std::distance(first, last));
+            if (count > header->capacity) {
+                throw std::length_error("the hull does not fit in the publication segment");
+            }
+            
+            const auto sequence = header->sequence.load(std::memory_order_relaxed);
+            header->sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            
+            header->count = count;
+            auto vertex = reinterpret_cast<std::array<T, 2>*>(memory_.data() + details::shm::round_up(sizeof(*header)));
+            for (; first != last; ++first) {
+                *vertex++ = {{static_cast<T>(x(*first)), static_cast<T>(y(*first))}};
+            }
+            
+            header->sequence.store(sequence + 2, std::memory_order_release);
+        }
+    
+    private:
+        explicit hull_publisher(shared_memory memory) : memory_{std::move(memory)} {}
+        
+        shared_memory memory_;
+    };
+    
+    /**
+     * Reader of the hull published by a hull_publisher.
+     */
+    template <typename T>
+    class hull_subscriber {
+    public:
+        /**
+         * @param name - the name of the shared memory segment.
+         * @throw std::system_error - if the segment cannot be opened.
+         * @throw std::runtime_error - if the segment is not a hull of this coordinate type.
+         */
+        explicit hull_subscriber(const std::string& name) : memory_{shared_memory::open(name)} {
+            if (memory_.size() < sizeof(details::shm::publication_header)) {
+                throw std::runtime_error("unexpected shared memory segment");
+            }
+            details::shm::check_magic(header()->magic, "HULLPUB1", header()->coordinate_size, sizeof(T));
+        }
+        
+        /**
+         * @return - the number of hulls published so far.
+         */
+        std::uint64_t version() const noexcept {
+            return header()->sequence.load(std::memory_order_acquire) / 2;
+        }
+        
+        /**
+         * Copy the latest published hull, retrying while it is being written.
+         * @param c - the container of the vertices (cleared first).
+         * @return - the version of the hull read.
+         */
+        template <typename TContainer>
+        std::uint64_t read(TContainer& c) const {
+            using point_type = typename TContainer::value_type;
+            const auto vertices = reinterpret_cast<const std::array<T, 2>*>(memory_.data() + details::shm::round_up(sizeof(*header())));
+            
+            for (std::size_t attempt{};; attempt++) {
+                const auto before = header()->sequence.load(std::memory_order_acquire);
+                if (before % 2 == 0) {
+                    const auto count = std::min(header()->count, header()->capacity);
+                    c.clear();
+                    for (std::size_t i{}; i < count; i++) {
+                        c.push_back(make_point<point_type>(vertices[i][0], vertices[i][1]));
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (header()->sequence.load(std::memory_order_relaxed) == before) {
+                        return before / 2;
+                    }
+                }
+                parallel::backoff(attempt);
+            }
+        }
+    
+    private:
+        const details::shm::publication_header* header() const noexcept {
+            return reinterpret_cast<const details::shm::publication_header*>(memory_.data());
+        }
+        
+        shared_memory memory_;
+    };
+    
+    /**
+     * Maintain the convex hull of the points of a ring, straight from the
+     * ring memory, and publish it whenever it changes, until the producer
+     * closes the ring.
+     * Average time complexity: O(log(H)) per point where H is the number
+     * of points on the convex hull, for a long stream.
+     * @param ring - the ring of point batches.
+     * @param publisher - the segment the hull is published to.
+     * @return - the final convex hull, in the same order as monotone_chain.
+     */
+    template <typename T>
+    std::vector<std::array<T, 2>> follow_ring(point_ring_consumer<T>& ring, hull_publisher<T>& publisher) {
+        algorithms::running_hull<std::array<T, 2>> running;
+        point_batch<T> batch;
+        while (ring.peek(batch)) {
+            const auto changed = running.add(std::begin(batch), std::end(batch));
+            ring.release();
+            if (changed) {
+                publisher.publish(std::begin(running.hull()), std::end(running.hull()));
+            }
+        }
+        return running.hull();
+    }
+}
+
+#endif
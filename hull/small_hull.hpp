@@ -0,0 +1,236 @@
+/**
+ * Fixed-size kernels of Monotone Chain for very small inputs.
+ * Below a few dozens of points, the generic path is dominated by its
+ * setup (std::sort, iterator arithmetic, accessors). For N <= 16, a
+ * kernel specialized on N:
+ * 1. loads the coordinates into local arrays (registers, for the most part);
+ * 2. sorts them with a sorting network (Batcher's odd-even merge sort)
+ *    whose compare-exchanges are branch-free conditional moves;
+ * 3. runs the Monotone Chain scan over a compile-time number of points,
+ *    the pushes on the hull being unconditional stores.
+ * The result is exactly the one of monotone_chain, which selects these
+ * kernels by itself. The input points are not modified.
+ */
+
+#ifndef small_hull_h
+#define small_hull_h
+
+#include "math_utils.hpp"
+#include "point_concept.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace hull::algorithms::details::small {
+    /**
+     * The largest input handled by the fixed-size kernels.
+     */
+    constexpr std::size_t max_size = 16;
+    
+    /**
+     * A comparator of a sorting network.
+     */
+    struct comparator {
+        std::size_t i{};
+        std::size_t j{};
+    };
+    
+    /**
+     * Build Batcher's odd-even merge sort network for max_size inputs.
+     * The network of a smaller N is the same one without the comparators
+     * touching an index >= N (as if the missing inputs were +infinity).
+     * @return - the comparators (and their number in the last element).
+     */
+    constexpr std::array<comparator, 64> make_network() {
+        std::array<comparator, 64> network{};
+        std::size_t size{};
+        for (std::size_t p{1}; p < max_size; p <<= 1) {
+            for (std::size_t k{p}; k >= 1; k >>= 1) {
+                for (std::size_t j{k % p}; j + k < max_size; j += 2 * k) {
+                    for (std::size_t i{}; i < k && i + j + k < max_size; i++) {
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                            network[size++] = comparator{i + j, i + j + k};
+                        }
+                    }
+                }
+            }
+        }
+        network[63] = comparator{size, size};
+        return network;
+    }
+    
+    inline constexpr auto network = make_network();
+    inline constexpr auto network_size = network[63].i;
+    static_assert(network_size == 63, "Batcher's network for 16 inputs has 63 comparators");
+    
+    /**
+     * Coordinates of the points being sorted, with the index of each one
+     * in the input (so that the points themselves are copied to the output).
+     */
+    template <typename T, std::size_t N>
+    struct sorted_points {
+        T xs[N];
+        T ys[N];
+        std::uint32_t ids[N];
+    };
+    
+    template <std::size_t Size> struct bits_of;
+    template <> struct bits_of<4> { using type = std::uint32_t; };
+    template <> struct bits_of<8> { using type = std::uint64_t; };
+    
+    /**
+     * Branch-free choice between 2 values: compilers turn a ternary
+     * operator into a (badly predicted) branch as soon as there are
+     * several of them, so the choice is made on the bits.
+     * @return - a if c is true, b otherwise.
+     */
+    template <typename T>
+    T select(bool c, T a, T b) {
+        if constexpr (std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)) {
+            using U = typename bits_of<sizeof(T)>::type;
+            U ua;
+            U ub;
+            std::memcpy(&ua, &a, sizeof(T));
+            std::memcpy(&ub, &b, sizeof(T));
+            const auto r = ub ^ ((ua ^ ub) & (U{} - static_cast<U>(c)));
+            T t;
+            std::memcpy(&t, &r, sizeof(T));
+            return t;
+        }
+        else {
+            return c ? a : b;
+        }
+    }
+    
+    /**
+     * Same as hull::equals, without short-circuit.
+     */
+    template <typename T>
+    bool equals(T a, T b) {
+        if constexpr (std::is_floating_point<T>::value) {
+            constexpr const auto epsilon = std::numeric_limits<T>::epsilon();
+            return (b - epsilon <= a) & (a <= b + epsilon);
+        }
+        else {
+            return a == b;
+        }
+    }
+    
+    /**
+     * Branch-free compare-exchange: after it, the point at I is not
+     * greater than the point at J (see lexicographic_less).
+     */
+    template <std::size_t N, std::size_t I, std::size_t J, typename T>
+    void compare_exchange(sorted_points<T, N>& s) {
+        if constexpr (J < N) {
+            const auto xi = s.xs[I];
+            const auto xj = s.xs[J];
+            const auto yi = s.ys[I];
+            const auto yj = s.ys[J];
+            const auto ii = s.ids[I];
+            const auto ij = s.ids[J];
+            const bool swap = (xj < xi) | (equals(xj, xi) & (yj < yi));
+            s.xs[I] = select(swap, xj, xi);
+            s.xs[J] = select(swap, xi, xj);
+            s.ys[I] = select(swap, yj, yi);
+            s.ys[J] = select(swap, yi, yj);
+            s.ids[I] = select(swap, ij, ii);
+            s.ids[J] = select(swap, ii, ij);
+        }
+    }
+    
+    template <std::size_t N, typename T, std::size_t... K>
+    void sort(sorted_points<T, N>& s, std::index_sequence<K...>) {
+        (compare_exchange<N, network[K].i, network[K].j>(s), ...);
+    }
+    
+    /**
+     * Same as cross, on coordinates.
+     * The result has the promoted type, so narrow coordinates do not overflow.
+     */
+    template <typename T>
+    auto cross(T x1, T y1, T x2, T y2, T x3, T y3) {
+        return (x2 - x1) * (y3 - y1) - (y2 - y1) * (x3 - x1);
+    }
+    
+    /**
+     * Monotone Chain for exactly N points (2 <= N <= max_size).
+     * @param first - the random access iterator to the first point.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull.
+     */
+    template <std::size_t N, typename RandomIt1, typename RandomIt2>
+    RandomIt2 kernel(RandomIt1 first, RandomIt2 first2) {
+        using point_type = typename std::iterator_traits<RandomIt1>::value_type;
+        using coordinate_type = std::decay_t<coordinate_t<point_type>>;
+        
+        sorted_points<coordinate_type, N> s;
+        for (std::size_t i{}; i < N; i++) {
+            s.xs[i] = x(first[i]);
+            s.ys[i] = y(first[i]);
+            s.ids[i] = static_cast<std::uint32_t>(i);
+        }
+        sort(s, std::make_index_sequence<network_size>{});
+        
+        // The hull is a stack of coordinates, and of the indices of the input points.
+        coordinate_type hx[2 * N];
+        coordinate_type hy[2 * N];
+        std::uint32_t hi[2 * N];
+        std::size_t k{};
+        auto push = [&](std::size_t i) {
+            hx[k] = s.xs[i];
+            hy[k] = s.ys[i];
+            hi[k] = s.ids[i];
+            k++;
+        };
+        auto turns_left = [&](std::size_t i) {
+            return cross(hx[k - 2], hy[k - 2], hx[k - 1], hy[k - 1], s.xs[i], s.ys[i]) > 0;
+        };
+        for (std::size_t i{}; i < N; i++) {
+            while (k >= 2 && !turns_left(i)) {
+                k--;
+            }
+            push(i);
+        }
+        const auto t = k + 1;
+        for (std::size_t i{N - 1}; i-- > 0;) {
+            while (k >= t && !turns_left(i)) {
+                k--;
+            }
+            push(i);
+        }
+        
+        for (std::size_t i{}; i + 1 < k; i++) {
+            first2[i] = first[hi[i]];
+        }
+        return first2 + (k - 1);
+    }
+    
+    template <typename RandomIt1, typename RandomIt2, std::size_t... N>
+    constexpr auto make_kernels(std::index_sequence<N...>) {
+        using kernel_type = RandomIt2 (*)(RandomIt1, RandomIt2);
+        return std::array<kernel_type, sizeof...(N)>{{&kernel<N + 2, RandomIt1, RandomIt2>...}};
+    }
+    
+    /**
+     * Compute the convex hull of 2 to max_size points with the kernel
+     * specialized on their number.
+     * @param first - the random access iterator to the first point of the container.
+     * @param last - the random access iterator to the one-past last point of the container.
+     * @param first2 - the random access iterator to the first point of the destination container.
+     * @return - the iterator to the one-past last point of the convex hull.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 small_hull(RandomIt1 first, RandomIt1 last, RandomIt2 first2) {
+        static constexpr auto kernels = make_kernels<RandomIt1, RandomIt2>(std::make_index_sequence<max_size - 1>{});
+        return kernels[static_cast<std::size_t>(std::distance(first, last)) - 2](first, first2);
+    }
+}
+
+#endif
@@ -0,0 +1,246 @@
+/**
+ * Convex hull of a soup of objects (polygons, polylines, segments...),
+ * each one given as its own container of vertices.
+ * Flattening all the vertices into a single container throws away the
+ * structure of the input: an object whose bounding box lies strictly
+ * inside the hull known so far cannot contribute to the convex hull,
+ * whatever its number of vertices. Hence:
+ * 1. the bounding box of each object is computed, in parallel;
+ * 2. the objects holding the extreme bounding boxes (leftmost, rightmost,
+ *    lowest and highest) give the seed hull;
+ * 3. the other objects are split into contiguous chunks, one per thread.
+ *    Each thread culls the objects whose bounding box is strictly inside
+ *    the seed hull in O(log(H)), computes the hull of the other ones and
+ *    reduces them with a tree of linear-time merges (see hull_merge.hpp);
+ * 4. the hulls of the threads and the seed hull are merged with a
+ *    reduction tree.
+ * The hull of an object is computed with Monotone Chain, unless the
+ * objects are declared convex, in which case their vertices are merged
+ * as they are.
+ * Example:
+ *      <code>
+ *      std::vector<std::vector<point>> footprints = ...;
+ *      auto convex_hull = hull::algorithms::soup_convex_hull(std::begin(footprints), std::end(footprints));
+ *      </code>
+ */
+
+#ifndef soup_hull_h
+#define soup_hull_h
+
+#include "hull_merge.hpp"
+#include "monotone_chain.hpp"
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "point_in_hull.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace hull::algorithms {
+    /**
+     * Options of the convex hull of a soup of objects.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @param convex_objects - true if the vertices of each object already form
+     *                         a convex polygon (in any order of this library), so
+     *                         that their hull is not computed again.
+     */
+    struct soup_options {
+        std::size_t threads{};
+        bool convex_objects{};
+    };
+    
+    /**
+     * Statistics of the convex hull of a soup of objects.
+     * @param objects - the number of objects.
+     * @param culled - the number of objects discarded by their bounding box.
+     */
+    struct soup_stats {
+        std::size_t objects{};
+        std::size_t culled{};
+    };
+}
+
+namespace hull::algorithms::details::soup {
+    /**
+     * Bounding box of an object (empty if the object has no vertex).
+     */
+    template <typename TPoint>
+    struct box {
+        TPoint min_corner{};
+        TPoint max_corner{};
+        bool empty{true};
+    };
+    
+    /**
+     * Compute the bounding box of an object.
+     * @param object - the container of vertices.
+     * @return - the bounding box of the vertices.
+     */
+    template <typename TContainer, typename TPoint = typename TContainer::value_type>
+    box<TPoint> bounds(const TContainer& object) {
+        box<TPoint> b;
+        auto min_x = coordinate_t<TPoint>{};
+        auto min_y = coordinate_t<TPoint>{};
+        auto max_x = coordinate_t<TPoint>{};
+        auto max_y = coordinate_t<TPoint>{};
+        for (const auto& p: object) {
+            if (b.empty) {
+                min_x = max_x = x(p);
+                min_y = max_y = y(p);
+                b.empty = false;
+                continue;
+            }
+            min_x = std::min(min_x, x(p));
+            max_x = std::max(max_x, x(p));
+            min_y = std::min(min_y, y(p));
+            max_y = std::max(max_y, y(p));
+        }
+        b.min_corner = make_point<TPoint>(min_x, min_y);
+        b.max_corner = make_point<TPoint>(max_x, max_y);
+        return b;
+    }
+    
+    /**
+     * Compute the hull of an object.
+     * @param object - the container of vertices.
+     * @param convex - true if the vertices already form a convex polygon.
+     * @return - the vertices of the hull of the object.
+     */
+    template <typename TContainer, typename TPoint = typename TContainer::value_type>
+    std::vector<TPoint> object_hull(const TContainer& object, bool convex) {
+        if (convex) {
+            return std::vector<TPoint>(std::begin(object), std::end(object));
+        }
+        std::vector<TPoint> points(std::begin(object), std::end(object));
+        std::vector<TPoint> convex_hull(2 * points.size());
+        convex_hull.erase(monotone_chain(std::begin(points), std::end(points), std::begin(convex_hull)), std::end(convex_hull));
+        return convex_hull;
+    }
+}
+
+namespace hull::algorithms {
+    /**
+     * Compute the convex hull of a soup of objects, each one being a
+     * container of vertices. The objects are only read.
+     * Average time complexity: O(V / T + W * log(S)) where V is the total number
+     * of vertices of the objects, S the number of objects which are not culled,
+     * W the total number of vertices of their hulls and T the number of threads.
+     * Average space complexity: O(K + V) where K is the number of objects.
+     * @param first - the forward iterator to the first object.
+     * @param last - the forward iterator to the one-past last object.
+     * @param options - the number of threads, and whether the objects are convex.
+     * @param stats - if not null, receives the statistics of the computation.
+     * @return - the vertices of the convex hull, in the same order as monotone_chain.
+     */
+    template <
+        typename ForwardIt,
+        typename TContainer = typename std::iterator_traits<ForwardIt>::value_type,
+        typename TPoint = typename TContainer::value_type
+    >
+    std::vector<TPoint> soup_convex_hull(ForwardIt first, ForwardIt last, const soup_options& options = {},
+                                         soup_stats* stats = nullptr)
+    {
+        static_assert_is_point<TPoint>();
+        
+        std::vector<const TContainer*> objects;
+        std::for_each(first, last, [&objects](const TContainer& object) {
+            objects.push_back(&object);
+        });
+        const auto K = objects.size();
+        if (stats != nullptr) {
+            *stats = soup_stats{K, 0};
+        }
+        
+        // Phase 1: the bounding boxes.
+        std::vector<details::soup::box<TPoint>> boxes(K);
+        parallel::for_each_chunk(K, options.threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                boxes[i] = details::soup::bounds(*objects[i]);
+            }
+        });
+        
+        // Phase 2: the objects with the extreme bounding boxes give the seed hull.
+        std::vector<std::size_t> seeds;
+        std::vector<TPoint> seed_hull;
+        {
+            std::vector<std::size_t> candidates;
+            for (std::size_t i{}; i < K; i++) {
+                if (!boxes[i].empty) {
+                    candidates.push_back(i);
+                }
+            }
+            if (candidates.empty()) {
+                return {};
+            }
+            
+            auto extreme = [&candidates, &boxes](auto before) {
+                return *std::min_element(std::begin(candidates), std::end(candidates), [&boxes, before](auto i, auto j) {
+                    return before(boxes[i], boxes[j]);
+                });
+            };
+            seeds = {
+                extreme([](const auto& a, const auto& b) { return x(a.min_corner) < x(b.min_corner); }),
+                extreme([](const auto& a, const auto& b) { return x(a.max_corner) > x(b.max_corner); }),
+                extreme([](const auto& a, const auto& b) { return y(a.min_corner) < y(b.min_corner); }),
+                extreme([](const auto& a, const auto& b) { return y(a.max_corner) > y(b.max_corner); })
+            };
+            std::sort(std::begin(seeds), std::end(seeds));
+            seeds.erase(std::unique(std::begin(seeds), std::end(seeds)), std::end(seeds));
+            
+            std::vector<std::vector<TPoint>> seed_hulls;
+            for (const auto i: seeds) {
+                seed_hulls.push_back(details::soup::object_hull(*objects[i], options.convex_objects));
+            }
+            seed_hull = merge_hull_tree(std::begin(seed_hulls), std::end(seed_hulls), 1);
+        }
+        
+        // Phase 3: each thread culls the objects of its chunk and reduces the others.
+        std::vector<std::size_t> others;
+        for (std::size_t i{}; i < K; i++) {
+            if (!boxes[i].empty && !std::binary_search(std::begin(seeds), std::end(seeds), i)) {
+                others.push_back(i);
+            }
+        }
+        const auto threads = parallel::thread_count(options.threads, others.size());
+        std::vector<std::vector<TPoint>> hulls(threads);
+        std::vector<std::size_t> culled(threads);
+        parallel::for_each_chunk(others.size(), threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::vector<std::vector<TPoint>> survivors;
+            for (auto k = begin; k < end; k++) {
+                const auto i = others[k];
+                if (is_box_strictly_inside(std::begin(seed_hull), std::end(seed_hull), boxes[i].min_corner, boxes[i].max_corner)) {
+                    culled[chunk]++;
+                    continue;
+                }
+                survivors.push_back(details::soup::object_hull(*objects[i], options.convex_objects));
+            }
+            hulls[chunk] = merge_hull_tree(std::begin(survivors), std::end(survivors), 1);
+        });
+        if (stats != nullptr) {
+            stats->culled = std::accumulate(std::begin(culled), std::end(culled), std::size_t{});
+        }
+        
+        // Phase 4: the hulls of the threads and the seed hull are merged.
+        hulls.erase(std::remove_if(std::begin(hulls), std::end(hulls), [](const auto& h) { return h.empty(); }), std::end(hulls));
+        hulls.push_back(std::move(seed_hull));
+        return merge_hull_tree(std::begin(hulls), std::end(hulls), options.threads);
+    }
+    
+    /**
+     * Container-based version of soup_convex_hull.
+     * @param objects - the container of objects.
+     * @param options - the number of threads, and whether the objects are convex.
+     * @param stats - if not null, receives the statistics of the computation.
+     * @return - the vertices of the convex hull, in the same order as monotone_chain.
+     */
+    template <typename TObjects>
+    auto soup_convex_hull(const TObjects& objects, const soup_options& options = {}, soup_stats* stats = nullptr) {
+        return soup_convex_hull(std::begin(objects), std::end(objects), options, stats);
+    }
+}
+
+#endif
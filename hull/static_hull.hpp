@@ -0,0 +1,87 @@
+/**
+ * Convex hull of a point set known at compile time.
+ * Collision shapes, calibration polygons and the like are often
+ * literals of the program: their hull does not need to be computed
+ * at startup. static_hull runs Monotone Chain (insertion sort, then
+ * the lower and upper hulls of monotone_chain.hpp) in a constant
+ * expression, so that the hull is embedded in the binary.
+ * Example:
+ *      <code>
+ *      constexpr std::array<std::array<int, 2>, 5> points{{{{0, 0}}, {{4, 0}}, {{2, 1}}, {{4, 4}}, {{0, 4}}}};
+ *      constexpr auto convex_hull = hull::static_hull(points);
+ *      static_assert(convex_hull.size == 4);
+ *      </code>
+ * The point type must be a literal type (std::array, or a structure
+ * with x and y data members, for instance).
+ */
+
+#ifndef static_hull_h
+#define static_hull_h
+
+#include "monotone_chain.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace hull {
+    /**
+     * Convex hull of N points, in a fixed-capacity array.
+     * @param points - the points of the convex hull, in the first size elements.
+     * @param size - the number of points on the convex hull.
+     */
+    template <typename TPoint, std::size_t N>
+    struct static_convex_hull {
+        std::array<TPoint, N> points{};
+        std::size_t size{};
+        
+        constexpr auto begin() const {
+            return points.begin();
+        }
+        
+        constexpr auto end() const {
+            return points.begin() + size;
+        }
+        
+        constexpr const TPoint& operator[](std::size_t i) const {
+            return points[i];
+        }
+    };
+    
+    /**
+     * Compute the convex hull of N points, in a constant expression if
+     * the points are. The hull is the one of monotone_chain.
+     * Time complexity: O(N^2) (insertion sort), which is spent by the compiler.
+     * Space complexity: O(N).
+     * @param points - the points.
+     * @return - the convex hull of the points.
+     */
+    template <typename TPoint, std::size_t N>
+    constexpr static_convex_hull<TPoint, N> static_hull(const std::array<TPoint, N>& points) {
+        static_assert_is_point<TPoint>();
+        
+        static_convex_hull<TPoint, N> result{};
+        if constexpr (N <= 1) {
+            result.points = points;
+            result.size = N;
+        }
+        else {
+            auto sorted = points;
+            algorithms::details::monotone::insertion_sort(sorted.begin(), sorted.end());
+            
+            std::array<TPoint, 2 * N> stack{};
+            std::size_t k{};
+            algorithms::details::monotone::lower_hull(sorted.begin(), sorted.end(), stack.begin(), k);
+            algorithms::details::monotone::upper_hull(sorted.begin(), sorted.end(), stack.begin(), k);
+            
+            result.size = k - 1;
+            for (std::size_t i{}; i < result.size; i++) {
+                result.points[i] = stack[i];
+            }
+        }
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,324 @@
+/**
+ * Parallel parser for text files of points.
+ * Each line holds one point: an x and a y coordinate separated by a
+ * comma, a semicolon and/or blanks ("x,y", "x y", "x; y"). Empty lines
+ * and lines starting with '#' are skipped. Any other line is malformed:
+ * it is reported (with its line number) and skipped, but it does not
+ * abort the parse.
+ * Non-finite coordinates ("nan", "inf") are malformed too.
+ * The input buffer is split at line boundaries and each part is parsed
+ * in its own thread with std::from_chars, into uninitialized slots (one
+ * per line). The points of each part are then appended in order to the
+ * destination container, either as points (AoS) or as two columns of
+ * coordinates (SoA): the destination is never zero-filled beforehand.
+ */
+
+#ifndef text_parser_h
+#define text_parser_h
+
+#include "parallel.hpp"
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace hull::io {
+    /**
+     * A malformed line.
+     * @param line - the line number (starting at 1).
+     * @param offset - the offset of the first character of the line in the buffer.
+     */
+    struct parse_error {
+        std::size_t line{};
+        std::size_t offset{};
+    };
+    
+    /**
+     * Summary of a parse.
+     * @param points - the number of points appended to the destination.
+     * @param lines - the number of lines in the buffer.
+     * @param malformed - the number of malformed lines.
+     * @param errors - the first malformed lines, in order (at most max_errors of them).
+     */
+    struct parse_report {
+        std::size_t points{};
+        std::size_t lines{};
+        std::size_t malformed{};
+        std::vector<parse_error> errors{};
+        
+        bool ok() const noexcept {
+            return malformed == 0;
+        }
+    };
+    
+    /**
+     * Options of the parser.
+     * @param threads - the number of threads (0 for all hardware threads).
+     * @param min_chunk_size - the minimum number of bytes handed to a thread.
+     * @param max_errors - the maximum number of malformed lines kept in the report.
+     */
+    struct parse_options {
+        std::size_t threads{};
+        std::size_t min_chunk_size{1 << 20};
+        std::size_t max_errors{100};
+    };
+}
+
+namespace hull::io::details::text {
+    inline bool is_blank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+    
+    inline const char* skip_blanks(const char* p, const char* last) {
+        while (p != last && is_blank(*p)) {
+            p++;
+        }
+        return p;
+    }
+    
+    /**
+     * Parse one coordinate. Unlike std::from_chars, a leading '+' is accepted,
+     * and "nan" and "inf" are rejected.
+     * @param p - the first character; it is moved past the coordinate on success.
+     * @param last - the end of the line.
+     * @param value - the parsed coordinate.
+     * @return - true on success.
+     */
+    template <typename T>
+    bool parse_coordinate(const char*& p, const char* last, T& value) {
+        if (p != last && *p == '+') {
+            p++;
+        }
+        const auto [end, error] = std::from_chars(p, last, value);
+        if (error != std::errc{}) {
+            return false;
+        }
+        if constexpr (std::is_floating_point<T>::value) {
+            if (!std::isfinite(value)) {
+                return false;
+            }
+        }
+        p = end;
+        return true;
+    }
+    
+    /**
+     * Outcome of the parse of a line.
+     */
+    enum class line_kind { point, skipped, malformed };
+    
+    /**
+     * Parse a line made of an x and a y coordinate.
+     * @param p - the first character of the line.
+     * @param eol - the end of the line (excluding '\n').
+     * @param x - the parsed x coordinate.
+     * @param y - the parsed y coordinate.
+     * @return - the kind of line.
+     */
+    template <typename T>
+    line_kind parse_line(const char* p, const char* eol, T& x, T& y) {
+        p = skip_blanks(p, eol);
+        if (p == eol || *p == '#') {
+            return line_kind::skipped;
+        }
+        
+        if (!parse_coordinate(p, eol, x)) {
+            return line_kind::malformed;
+        }
+        
+        const auto before_separator = p;
+        p = skip_blanks(p, eol);
+        if (p != eol && (*p == ',' || *p == ';')) {
+            p = skip_blanks(p + 1, eol);
+        }
+        else if (p == before_separator) {
+            return line_kind::malformed;
+        }
+        
+        if (!parse_coordinate(p, eol, y)) {
+            return line_kind::malformed;
+        }
+        
+        return skip_blanks(p, eol) == eol ? line_kind::point : line_kind::malformed;
+    }
+    
+    /**
+     * Move a position forward to the beginning of the next line
+     * (or keep it if it is already at the beginning of a line).
+     */
+    inline const char* line_boundary(const char* first, const char* position, const char* last) {
+        if (position == first || position == last || *(position - 1) == '\n') {
+            return position;
+        }
+        const auto eol = static_cast<const char*>(std::memchr(position, '\n', static_cast<std::size_t>(last - position)));
+        return eol == nullptr ? last : eol + 1;
+    }
+    
+    /**
+     * Count the lines of [first ; last), including a last line
+     * without '\n'.
+     */
+    inline std::size_t count_lines(const char* first, const char* last) {
+        const auto newlines = static_cast<std::size_t>(std::count(first, last, '\n'));
+        return newlines + ((first != last && *(last - 1) != '\n') ? 1 : 0);
+    }
+    
+    /**
+     * Parse the whole buffer in parallel. reserve(count) is called once
+     * with the number of lines. The sink is called as sink(index, x, y)
+     * for each point, where index is the position of the point in an
+     * array of one slot per line. The slots of the lines which are not
+     * points are left untouched: append is then called as append(source,
+     * count) for the points of each chunk, in order.
+     * @return - the report of the parse.
+     */
+    template <typename T, typename Reserve, typename Sink, typename Append>
+    parse_report parse(const char* first, const char* last, const parse_options& options,
+                       Reserve reserve, Sink sink, Append append)
+    {
+        const auto size = static_cast<std::size_t>(last - first);
+        const auto chunks = parallel::thread_count(options.threads, size / std::max<std::size_t>(1, options.min_chunk_size) + 1);
+        
+        // Chunk boundaries at the beginning of lines.
+        std::vector<const char*> bounds(chunks + 1);
+        for (std::size_t i{}; i <= chunks; i++) {
+            bounds[i] = line_boundary(first, first + size * i / chunks, last);
+        }
+        
+        // 1st pass: count the lines so that each chunk knows where to write.
+        std::vector<std::size_t> lines(chunks + 1);
+        parallel::for_each_chunk(chunks, chunks, [&](std::size_t, std::size_t i, std::size_t) {
+            lines[i + 1] = count_lines(bounds[i], bounds[i + 1]);
+        });
+        std::partial_sum(std::begin(lines), std::end(lines), std::begin(lines));
+        
+        reserve(lines[chunks]);
+        
+        // 2nd pass: parse into the slots.
+        std::vector<std::size_t> written(chunks);
+        std::vector<std::size_t> malformed(chunks);
+        std::vector<std::vector<parse_error>> errors(chunks);
+        
+        parallel::for_each_chunk(chunks, chunks, [&](std::size_t, std::size_t i, std::size_t) {
+            auto slot = lines[i];
+            auto line = lines[i];
+            for (auto p = bounds[i]; p < bounds[i + 1]; line++) {
+                auto eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(bounds[i + 1] - p)));
+                eol = (eol == nullptr) ? bounds[i + 1] : eol;
+                
+                T x{};
+                T y{};
+                switch (parse_line(p, eol, x, y)) {
+                    case line_kind::point:
+                        sink(slot++, x, y);
+                        break;
+                    case line_kind::malformed:
+                        if (errors[i].size() < options.max_errors) {
+                            errors[i].push_back(parse_error{line + 1, static_cast<std::size_t>(p - first)});
+                        }
+                        malformed[i]++;
+                        break;
+                    case line_kind::skipped:
+                        break;
+                }
+                
+                p = eol + 1;
+            }
+            written[i] = slot - lines[i];
+        });
+        
+        // Skip the gaps left by the skipped and malformed lines.
+        parse_report report;
+        for (std::size_t i{}; i < chunks; i++) {
+            append(lines[i], written[i]);
+            report.points += written[i];
+            report.malformed += malformed[i];
+            
+            const auto room = options.max_errors - report.errors.size();
+            const auto kept = std::min(room, errors[i].size());
+            report.errors.insert(std::end(report.errors), std::begin(errors[i]), std::begin(errors[i]) + kept);
+        }
+        report.lines = lines[chunks];
+        
+        return report;
+    }
+}
+
+namespace hull::io {
+    /**
+     * Parse a buffer of text and append the points to a vector.
+     * Average time complexity: O(N / T) where N is the size of the buffer
+     * and T the number of threads.
+     * @param first - the first character of the buffer.
+     * @param last - the one-past last character of the buffer.
+     * @param points - the points are appended to this vector.
+     * @param options - the options of the parser.
+     * @return - the report of the parse.
+     */
+    template <typename TPoint>
+    parse_report parse_points(const char* first, const char* last, std::vector<TPoint>& points,
+                              const parse_options& options = {})
+    {
+        static_assert_is_point<TPoint>();
+        using coordinate_type = std::decay_t<coordinate_t<TPoint>>;
+        
+        std::unique_ptr<TPoint[]> slots;
+        
+        return details::text::parse<coordinate_type>(first, last, options,
+            [&points, &slots](std::size_t n) {
+                slots.reset(new TPoint[n]);
+                points.reserve(points.size() + n);
+            },
+            [&slots](std::size_t i, coordinate_type x, coordinate_type y) {
+                slots[i] = make_point<TPoint>(x, y);
+            },
+            [&points, &slots](std::size_t source, std::size_t n) {
+                points.insert(std::end(points), slots.get() + source, slots.get() + source + n);
+            });
+    }
+    
+    /**
+     * Same as above, but the coordinates are appended to two separate
+     * columns (structure of arrays).
+     * @param first - the first character of the buffer.
+     * @param last - the one-past last character of the buffer.
+     * @param xs - the x coordinates are appended to this vector.
+     * @param ys - the y coordinates are appended to this vector.
+     * @param options - the options of the parser.
+     * @return - the report of the parse.
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+    parse_report parse_points(const char* first, const char* last, std::vector<T>& xs, std::vector<T>& ys,
+                              const parse_options& options = {})
+    {
+        ys.resize(xs.size());
+        std::unique_ptr<T[]> x_slots;
+        std::unique_ptr<T[]> y_slots;
+        
+        return details::text::parse<T>(first, last, options,
+            [&xs, &ys, &x_slots, &y_slots](std::size_t n) {
+                x_slots.reset(new T[n]);
+                y_slots.reset(new T[n]);
+                xs.reserve(xs.size() + n);
+                ys.reserve(ys.size() + n);
+            },
+            [&x_slots, &y_slots](std::size_t i, T x, T y) {
+                x_slots[i] = x;
+                y_slots[i] = y;
+            },
+            [&xs, &ys, &x_slots, &y_slots](std::size_t source, std::size_t n) {
+                xs.insert(std::end(xs), x_slots.get() + source, x_slots.get() + source + n);
+                ys.insert(std::end(ys), y_slots.get() + source, y_slots.get() + source + n);
+            });
+    }
+}
+
+#endif
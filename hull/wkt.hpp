@@ -0,0 +1,79 @@
+/**
+ * Well-known text (WKT) output of a convex hull.
+ * A polygon ring needs at least 4 positions (the first one being
+ * repeated at the end), so that a degenerate hull is written as the
+ * geometry it really is:
+ *      0 vertex    POLYGON EMPTY
+ *      1 vertex    POINT(x y)
+ *      2 vertices  LINESTRING(x0 y0, x1 y1)
+ *      3 or more   POLYGON((x0 y0, x1 y1, ..., x0 y0))
+ * The precision of the coordinates is the one of the stream.
+ */
+
+#ifndef wkt_h
+#define wkt_h
+
+#include "point_concept.hpp"
+#include "static_assert.hpp"
+
+#include <iterator>
+#include <ostream>
+
+namespace hull::io::details::wkt {
+    template <typename TPoint>
+    void write_position(std::ostream& out, const TPoint& p) {
+        out << x(p) << " " << y(p);
+    }
+
+    /**
+     * Write the positions of [first ; last), separated by commas.
+     */
+    template <typename ForwardIt>
+    void write_positions(std::ostream& out, ForwardIt first, ForwardIt last) {
+        for (auto it = first; it != last; ++it) {
+            if (it != first) {
+                out << ", ";
+            }
+            write_position(out, *it);
+        }
+    }
+}
+
+namespace hull::io {
+    /**
+     * Write a convex hull as a WKT geometry, followed by a new line.
+     * @param out - the output stream.
+     * @param first - the forward iterator to the first vertex of the hull.
+     * @param last - the forward iterator to the one-past last vertex of the hull.
+     */
+    template <typename ForwardIt>
+    void write_wkt(std::ostream& out, ForwardIt first, ForwardIt last) {
+        static_assert_is_point<typename std::iterator_traits<ForwardIt>::value_type>();
+
+        switch (std::distance(first, last)) {
+            case 0:
+                out << "POLYGON EMPTY";
+                break;
+            case 1:
+                out << "POINT(";
+                details::wkt::write_position(out, *first);
+                out << ")";
+                break;
+            case 2:
+                out << "LINESTRING(";
+                details::wkt::write_positions(out, first, last);
+                out << ")";
+                break;
+            default:
+                out << "POLYGON((";
+                details::wkt::write_positions(out, first, last);
+                out << ", ";
+                details::wkt::write_position(out, *first);
+                out << "))";
+                break;
+        }
+        out << "\n";
+    }
+}
+
+#endif
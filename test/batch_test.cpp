@@ -0,0 +1,102 @@
+/**
+ * Unit tests for the batched convex hull computation.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/batch.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @return - the convex hull of the points of a set, with Monotone Chain.
+ */
+static std::vector<std::array<double, 2>> expected_hull(const std::vector<std::array<double, 2>>& points,
+                                                        std::size_t begin, std::size_t end)
+{
+    std::vector<std::array<double, 2>> set(std::begin(points) + begin, std::begin(points) + end);
+    std::vector<std::array<double, 2>> convex_hull;
+    hull::convex::compute(hull::choice::monotone_chain, set, convex_hull);
+    return convex_hull;
+}
+
+static auto test_batch_many_sets = add_test([] {
+    // Arrange
+    // Sets of every engine: empty, single point, tiny, medium and large.
+    std::mt19937 generator(21);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    std::uniform_int_distribution<std::size_t> sizes(5, 500);
+    std::vector<std::size_t> offsets{0};
+    for (std::size_t i{}; i < 2000; i++) {
+        const auto size = (i % 100 == 0) ? 5000 : (i % 37 == 0) ? i % 2 : sizes(generator);
+        offsets.push_back(offsets.back() + size);
+    }
+    std::vector<std::array<double, 2>> points(offsets.back());
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    const auto copy = points;
+    hull::algorithms::batch_result<std::array<double, 2>> result;
+    
+    // Act
+    hull::algorithms::batch_convex_hull(points, offsets, result, {4, 32, 1000});
+    
+    // Assert
+    assert(points == copy);
+    assert(result.offsets.size() == offsets.size());
+    assert(result.offsets.back() == result.points.size());
+    for (std::size_t i{}; i + 1 < offsets.size(); i++) {
+        const std::vector<std::array<double, 2>> target(std::begin(result.points) + result.offsets[i],
+                                                        std::begin(result.points) + result.offsets[i + 1]);
+        assert(target == expected_hull(points, offsets[i], offsets[i + 1]));
+    }
+});
+
+static auto test_batch_reuse_result = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> points{
+        {{0, 0}}, {{4, 0}}, {{4, 4}}, {{0, 4}}, {{2, 2}},
+        {{1, 1}}, {{2, 2}}, {{3, 3}}
+    };
+    const std::vector<int> offsets{0, 5, 8};
+    const std::vector<std::array<int, 2>> expected{
+        {{0, 0}}, {{4, 0}}, {{4, 4}}, {{0, 4}},
+        {{1, 1}}, {{3, 3}}
+    };
+    hull::algorithms::batch_result<std::array<int, 2>> result;
+    
+    // Act
+    hull::algorithms::batch_convex_hull(points, offsets, result);
+    hull::algorithms::batch_convex_hull(points, offsets, result, {1});
+    
+    // Assert
+    assert(result.points == expected);
+    assert((result.offsets == std::vector<std::size_t>{0, 4, 6}));
+});
+
+static auto test_batch_invalid_offsets = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> points{{{0, 0}}, {{1, 0}}, {{0, 1}}};
+    const std::vector<std::size_t> decreasing{0, 2, 1};
+    const std::vector<std::size_t> too_large{0, 4};
+    hull::algorithms::batch_result<std::array<int, 2>> result;
+    
+    // Act
+    auto thrown = 0;
+    for (const auto& offsets: {decreasing, too_large}) {
+        try {
+            hull::algorithms::batch_convex_hull(points, offsets, result);
+        }
+        catch (const std::invalid_argument&) {
+            thrown++;
+        }
+    }
+    
+    // Assert
+    assert(thrown == 2);
+});
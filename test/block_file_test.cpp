@@ -0,0 +1,143 @@
+/**
+ * Unit tests for the block-indexed columnar point files.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/block_file.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/**
+ * @return - the path to a new empty temporary file.
+ */
+static std::string make_temporary_block_file() {
+    char path[] = "/tmp/hull_block_file_XXXXXX";
+    const auto fd = ::mkstemp(path);
+    assert(fd >= 0);
+    ::close(fd);
+    return path;
+}
+
+static auto test_block_file_round_trip = add_test([] {
+    // Arrange
+    const auto path = make_temporary_block_file();
+    using point_type = std::array<double, 2>;
+    const auto points = std::vector<point_type>{{
+        {{1.5, 2.}}, {{-3., 4.}}, {{5., -6.}}, {{7., 8.}}, {{0., 0.}}
+    }};
+    
+    // Act
+    {
+        hull::io::block_file_writer<double> writer(path, 2);
+        writer.write(std::begin(points), std::end(points));
+    }
+    hull::io::block_file<double> file(path);
+    std::vector<point_type> read;
+    for (std::size_t i{}; i < file.blocks().size(); i++) {
+        file.read_block(i, read);
+    }
+    
+    // Assert
+    assert(file.size() == points.size());
+    assert(file.blocks().size() == 3);
+    assert(file.blocks()[0].count == 2 && file.blocks()[2].count == 1);
+    assert(file.blocks()[1].min_x == 5. && file.blocks()[1].max_y == 8.);
+    assert(read == points);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_block_file_rejects_other_files = add_test([] {
+    // Arrange
+    const auto path = make_temporary_block_file();
+    {
+        hull::io::block_file_writer<float> writer(path);
+        writer.write(1.f, 2.f);
+    }
+    auto thrown = false;
+    
+    // Act
+    try {
+        hull::io::block_file<double> file(path);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_block_file_convex_hull_skips_inner_blocks = add_test([] {
+    // Arrange
+    // A 64x64 grid written tile by tile (8x8 tiles of 8x8 points):
+    // the 36 inner tiles cannot contribute to the convex hull.
+    const auto path = make_temporary_block_file();
+    using point_type = std::array<std::int32_t, 2>;
+    std::vector<point_type> points;
+    for (int tx{}; tx < 8; tx++) {
+        for (int ty{}; ty < 8; ty++) {
+            for (int i{}; i < 64; i++) {
+                points.push_back({{8 * tx + i % 8, 8 * ty + i / 8}});
+            }
+        }
+    }
+    {
+        hull::io::block_file_writer<std::int32_t> writer(path, 64);
+        writer.write(std::begin(points), std::end(points));
+    }
+    const auto expected = std::vector<point_type>{{
+        {{0, 0}}, {{63, 0}}, {{63, 63}}, {{0, 63}}
+    }};
+    hull::io::block_file<std::int32_t> file(path);
+    std::vector<point_type> target;
+    
+    // Act
+    const auto stats = file.convex_hull(target);
+    
+    // Assert
+    assert(target == expected);
+    assert(stats.blocks == 64);
+    assert(stats.blocks_read == 28);
+    assert(stats.points_read == 28 * 64);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_block_file_convex_hull_matches_full_computation = add_test([] {
+    // Arrange
+    const auto path = make_temporary_block_file();
+    using point_type = std::array<double, 2>;
+    std::vector<point_type> points;
+    for (int i{}; i < 5000; i++) {
+        const auto a = 0.001 * i * i;
+        const auto r = 1. + 0.3 * ((i * 7919) % 101) / 101.;
+        points.push_back({{r * std::cos(a), r * std::sin(a)}});
+    }
+    {
+        hull::io::block_file_writer<double> writer(path, 100);
+        writer.write(std::begin(points), std::end(points));
+    }
+    std::vector<point_type> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    hull::io::block_file<double> file(path);
+    std::vector<point_type> target;
+    
+    // Act
+    file.convex_hull(hull::choice::monotone_chain, target);
+    
+    // Assert
+    assert(target == expected);
+    
+    std::remove(path.c_str());
+});
@@ -0,0 +1,151 @@
+/**
+ * Unit tests for the out-of-core convex hull.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/external_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/**
+ * Write the given points as a flat little-endian file
+ * in a new temporary file.
+ * @param points - the points.
+ * @return - the path to the temporary file.
+ */
+static std::string write_temporary_external_file(const std::vector<std::array<double, 2>>& points) {
+    char path[] = "/tmp/hull_external_XXXXXX";
+    const auto fd = ::mkstemp(path);
+    assert(fd >= 0);
+    
+    std::vector<unsigned char> bytes(points.size() * 2 * sizeof(double));
+    for (std::size_t i{}; i < points.size(); i++) {
+        hull::io::details::store_little_endian(points[i][0], bytes.data() + 2 * i * sizeof(double));
+        hull::io::details::store_little_endian(points[i][1], bytes.data() + (2 * i + 1) * sizeof(double));
+    }
+    
+    const auto written = ::write(fd, bytes.data(), bytes.size());
+    assert(written == static_cast<ssize_t>(bytes.size()));
+    ::close(fd);
+    
+    return path;
+}
+
+static auto test_streaming_monotone_chain = add_test([] {
+    // Arrange
+    auto points = std::array<std::array<int, 2>, 13>{{
+        {{0, 10}},
+        {{-5, 5}}, {{-2, 5}}, {{2, 4}}, {{6, 5}},
+        {{-5, 1}}, {{-2, 3}}, {{1, 3}}, {{4, 2}}, {{7, 2}},
+        {{-3, 0}}, {{0, 0}}, {{3, 0}}
+    }};
+    std::vector<std::array<int, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    hull::algorithms::details::monotone::sort(std::begin(points), std::end(points));
+    hull::algorithms::details::monotone::chain_builder<std::array<int, 2>> chain;
+    std::vector<std::array<int, 2>> target;
+    
+    // Act
+    for (const auto& p: points) {
+        chain.push(p);
+    }
+    chain.copy(std::back_inserter(target));
+    
+    // Assert
+    assert(chain.size() == expected.size());
+    assert(target == expected);
+});
+
+static auto test_external_convex_hull_in_chunks = add_test([] {
+    // Arrange
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    std::vector<std::array<double, 2>> points(20000);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    const auto path = write_temporary_external_file(points);
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    hull::io::external_options options;
+    options.memory_budget = 64 * 1024;
+    hull::io::external_stats stats;
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::io::external_convex_hull<double>(path, std::back_inserter(target), options, &stats);
+    
+    // Assert
+    assert(target == expected);
+    assert(stats.points == points.size());
+    assert(stats.chunks == 20);
+    assert(stats.survivors < points.size() / 2);
+    assert(stats.runs == 0);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_external_convex_hull_with_spilled_runs = add_test([] {
+    // Arrange
+    // All the points are on the convex hull, so that the
+    // candidate hull cannot fit in the memory budget.
+    std::vector<std::array<double, 2>> points;
+    for (int i{}; i < 5000; i++) {
+        points.push_back({{static_cast<double>(i), static_cast<double>(i) * i}});
+    }
+    std::shuffle(std::begin(points), std::end(points), std::mt19937(7));
+    const auto path = write_temporary_external_file(points);
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    hull::io::external_options options;
+    options.memory_budget = 32 * 1024;
+    hull::io::external_stats stats;
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::io::external_convex_hull<double>(path, std::back_inserter(target), options, &stats);
+    
+    // Assert
+    assert(stats.runs > 1);
+    assert(stats.merge_passes == 1);
+    assert(target == expected);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_external_convex_hull_with_merge_passes = add_test([] {
+    // Arrange
+    // More runs than the fan-in: they are merged in several passes.
+    std::vector<std::array<double, 2>> points;
+    for (int i{}; i < 40000; i++) {
+        points.push_back({{static_cast<double>(i), static_cast<double>(i) * i}});
+    }
+    std::shuffle(std::begin(points), std::end(points), std::mt19937(55));
+    const auto path = write_temporary_external_file(points);
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    hull::io::external_options options;
+    options.memory_budget = 32 * 1024;
+    options.max_fan_in = 4;
+    hull::io::external_stats stats;
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::io::external_convex_hull<double>(path, std::back_inserter(target), options, &stats);
+    
+    // Assert
+    assert(stats.runs > 16);
+    assert(stats.merge_passes > 2);
+    assert(target == expected);
+    
+    std::remove(path.c_str());
+});
@@ -0,0 +1,73 @@
+/**
+ * Unit tests for the group-by convex hull.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/group_by.hpp"
+
+#include <array>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+static auto test_group_by_unsorted_keys = add_test([] {
+    // Arrange
+    std::mt19937 generator(31);
+    std::uniform_int_distribution<int> keys_distribution(0, 99);
+    std::uniform_int_distribution<int> distribution(-10000, 10000);
+    std::vector<int> keys(100000);
+    std::vector<std::array<int, 2>> points(keys.size());
+    std::map<int, std::vector<std::array<int, 2>>> groups;
+    for (std::size_t i{}; i < keys.size(); i++) {
+        keys[i] = keys_distribution(generator);
+        // Each key has its own region, so that the hulls differ.
+        points[i] = {{distribution(generator) / (1 + keys[i] % 7) + keys[i], distribution(generator)}};
+        groups[keys[i]].push_back(points[i]);
+    }
+    
+    // Act
+    const auto hulls = hull::algorithms::group_convex_hull(std::begin(keys), std::end(keys), std::begin(points), {3, 8});
+    
+    // Assert
+    assert(hulls.size() == groups.size());
+    for (const auto& [key, group]: groups) {
+        std::vector<std::array<int, 2>> expected;
+        hull::convex::compute(hull::choice::monotone_chain, group, expected);
+        assert(hulls.at(key) == expected);
+    }
+});
+
+static auto test_group_by_string_keys = add_test([] {
+    // Arrange
+    const std::vector<std::string> keys{"a", "b", "a", "a", "c", "a", "b", "b", "a"};
+    const std::vector<std::array<double, 2>> points{
+        {{0., 0.}}, {{5., 5.}}, {{2., 0.}}, {{2., 2.}}, {{7., 7.}}, {{1., 0.5}}, {{6., 5.}}, {{5., 6.}}, {{0., 2.}}
+    };
+    const std::vector<std::array<double, 2>> expected_a{{{0., 0.}}, {{2., 0.}}, {{2., 2.}}, {{0., 2.}}};
+    const std::vector<std::array<double, 2>> expected_b{{{5., 5.}}, {{6., 5.}}, {{5., 6.}}};
+    const std::vector<std::array<double, 2>> expected_c{{{7., 7.}}};
+    
+    // Act
+    const auto hulls = hull::algorithms::group_convex_hull(std::begin(keys), std::end(keys), std::begin(points), {2});
+    
+    // Assert
+    assert(hulls.size() == 3);
+    assert(hulls.at("a") == expected_a);
+    assert(hulls.at("b") == expected_b);
+    assert(hulls.at("c") == expected_c);
+});
+
+static auto test_group_by_empty = add_test([] {
+    // Arrange
+    const std::vector<int> keys;
+    const std::vector<std::array<int, 2>> points;
+    
+    // Act
+    const auto hulls = hull::algorithms::group_convex_hull(std::begin(keys), std::end(keys), std::begin(points));
+    
+    // Assert
+    assert(hulls.empty());
+});
@@ -0,0 +1,126 @@
+/**
+ * Unit tests for the lower and upper hulls.
+ */
+
+#include "test_main.hpp"
+#include "../hull/half_hull.hpp"
+#include "../hull/monotone_chain.hpp"
+#include "point2d.hpp"
+#include "reference_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * @return - the lower and upper hulls, computed with the given number of threads.
+ */
+template <typename TPoint>
+static std::array<std::vector<TPoint>, 2> half_hulls(std::vector<TPoint> points, std::size_t threads) {
+    auto copy = points;
+    std::vector<TPoint> lower(points.size());
+    std::vector<TPoint> upper(points.size());
+    lower.erase(hull::lower_hull(std::begin(points), std::end(points), std::begin(lower), threads), std::end(lower));
+    upper.erase(hull::upper_hull(std::begin(copy), std::end(copy), std::begin(upper), threads), std::end(upper));
+    return {{lower, upper}};
+}
+
+/**
+ * @return - the convex hull of monotone_chain, rebuilt from the lower and upper hulls.
+ */
+template <typename TPoint>
+static std::vector<TPoint> join(const std::vector<TPoint>& lower, const std::vector<TPoint>& upper) {
+    auto convex_hull = lower;
+    if (upper.size() > 2) {
+        convex_hull.insert(std::end(convex_hull), std::next(std::rbegin(upper)), std::prev(std::rend(upper)));
+    }
+    return convex_hull;
+}
+
+static auto test_half_hulls = add_test([] {
+    // Arrange
+    const std::vector<point2d> points{{0, 0}, {2, -1}, {4, 0}, {3, 3}, {1, 2}, {2, 1}, {4, 0}};
+    const std::vector<point2d> expected_lower{{0, 0}, {2, -1}, {4, 0}};
+    const std::vector<point2d> expected_upper{{0, 0}, {1, 2}, {3, 3}, {4, 0}};
+    
+    // Act
+    const auto [lower, upper] = half_hulls(points, 1);
+    
+    // Assert
+    assert(lower == expected_lower);
+    assert(upper == expected_upper);
+});
+
+static auto test_half_hulls_same_as_monotone_chain = add_test([] {
+    // Arrange
+    std::mt19937 generator(69);
+    std::uniform_int_distribution<int> grid(-30, 30);
+    std::uniform_real_distribution<double> distribution(-1000., 1000.);
+    
+    for (const std::size_t size: {1, 2, 3, 10, 1000, 30000}) {
+        for (const std::size_t threads: {1, 3}) {
+            std::vector<point> points(size);
+            for (auto& p: points) {
+                p = {{grid(generator), grid(generator)}};
+            }
+            std::vector<std::array<double, 2>> real_points(size);
+            for (auto& p: real_points) {
+                p = {{distribution(generator), distribution(generator)}};
+            }
+            
+            // Act
+            const auto [lower, upper] = half_hulls(points, threads);
+            const auto [real_lower, real_upper] = half_hulls(real_points, threads);
+            
+            // Assert
+            if (size > 2) {
+                assert(join(lower, upper) == reference_hull(points));
+                assert(join(real_lower, real_upper) == reference_hull(real_points));
+            }
+            assert(std::is_sorted(std::begin(upper), std::end(upper), hull::algorithms::details::monotone::lexicographic_less{}));
+        }
+    }
+});
+
+static auto test_half_hulls_presorted = add_test([] {
+    // Arrange
+    // A time series: sorted by x, never modified.
+    std::mt19937 generator(690);
+    std::uniform_int_distribution<int> value(-500, 500);
+    std::vector<point> series(50000);
+    for (std::size_t i{}; i < series.size(); i++) {
+        series[i] = {{static_cast<int>(i), value(generator)}};
+    }
+    const auto copy = series;
+    const auto [expected_lower, expected_upper] = half_hulls(series, 1);
+    
+    for (const std::size_t threads: {1, 4}) {
+        // Act
+        std::vector<point> lower(series.size());
+        std::vector<point> upper(series.size());
+        lower.erase(hull::lower_hull(hull::presorted, std::begin(series), std::end(series), std::begin(lower), threads), std::end(lower));
+        upper.erase(hull::upper_hull(hull::presorted, std::begin(series), std::end(series), std::begin(upper), threads), std::end(upper));
+        
+        // Assert
+        assert(series == copy);
+        assert(lower == expected_lower);
+        assert(upper == expected_upper);
+    }
+});
+
+static auto test_half_hulls_duplicates = add_test([] {
+    // Arrange
+    const std::vector<point> points(5, point{{1, 1}});
+    const std::vector<point> expected{{{1, 1}}};
+    
+    // Act
+    const auto [lower, upper] = half_hulls(points, 1);
+    
+    // Assert
+    assert(lower == expected);
+    assert(upper == expected);
+});
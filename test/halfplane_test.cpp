@@ -0,0 +1,270 @@
+/**
+ * Unit tests for the intersection of half-planes.
+ */
+
+#include "test_main.hpp"
+#include "../hull/halfplane.hpp"
+#include "../hull/monotone_chain.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using point = std::array<double, 2>;
+
+/**
+ * @return - the area of a polygon.
+ */
+static double area(const std::vector<point>& polygon) {
+    double twice{};
+    for (std::size_t i{}; i < polygon.size(); i++) {
+        const auto& p = polygon[i];
+        const auto& q = polygon[(i + 1) % polygon.size()];
+        twice += p[0] * q[1] - q[0] * p[1];
+    }
+    return twice / 2;
+}
+
+/**
+ * @return - true if the point satisfies all the half-planes, with a tolerance.
+ */
+static bool satisfies(const std::vector<hull::halfplane>& halfplanes, const point& p) {
+    for (const auto& h: halfplanes) {
+        if (h.a * p[0] + h.b * p[1] > h.c + 1e-6) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @return - the intersection polygon, by brute force: the hull of the
+ *           feasible intersections of the boundary lines.
+ */
+static std::vector<point> brute_intersection(const std::vector<hull::halfplane>& halfplanes) {
+    std::vector<point> vertices;
+    for (std::size_t i{}; i < halfplanes.size(); i++) {
+        for (auto j = i + 1; j < halfplanes.size(); j++) {
+            const auto& h1 = halfplanes[i];
+            const auto& h2 = halfplanes[j];
+            const auto det = h1.a * h2.b - h2.a * h1.b;
+            if (std::abs(det) < 1e-12) {
+                continue;
+            }
+            const point p{{(h1.c * h2.b - h2.c * h1.b) / det, (h1.a * h2.c - h2.a * h1.c) / det}};
+            if (satisfies(halfplanes, p)) {
+                vertices.push_back(p);
+            }
+        }
+    }
+    std::vector<point> polygon(2 * vertices.size());
+    polygon.erase(hull::algorithms::monotone_chain(std::begin(vertices), std::end(vertices), std::begin(polygon)),
+                  std::end(polygon));
+    return polygon;
+}
+
+/**
+ * @return - the half-planes tangent to a jittered circle, which surround the origin.
+ */
+static std::vector<hull::halfplane> random_halfplanes(std::mt19937& generator, std::size_t size) {
+    std::uniform_real_distribution<double> jitter(0.4, 0.6);
+    std::uniform_real_distribution<double> distance(1, 2);
+    const auto pi = std::acos(-1.);
+    std::vector<hull::halfplane> halfplanes;
+    for (std::size_t i{}; i < size; i++) {
+        const auto angle = 2 * pi * (static_cast<double>(i) + jitter(generator)) / static_cast<double>(size);
+        halfplanes.push_back({std::cos(angle), std::sin(angle), distance(generator)});
+    }
+    std::shuffle(std::begin(halfplanes), std::end(halfplanes), generator);
+    return halfplanes;
+}
+
+static auto test_halfplane_intersection_rectangle = add_test([] {
+    // Arrange
+    // 0 <= x <= 4, 0 <= y <= 3 and the redundant x + y <= 10.
+    const std::vector<hull::halfplane> halfplanes{{1, 0, 4}, {-1, 0, 0}, {0, 1, 3}, {0, -1, 0}, {1, 1, 10}};
+    
+    // Act
+    const auto result = hull::halfplane_intersection<point>(halfplanes);
+    
+    // Assert
+    const std::vector<point> expected{{{0, 0}}, {{4, 0}}, {{4, 3}}, {{0, 3}}};
+    assert(result.status == hull::halfplane_status::bounded);
+    assert(result.polygon == expected);
+});
+
+static auto test_halfplane_intersection_triangle = add_test([] {
+    // Arrange
+    // y >= 0, y <= x and y <= 2 - x.
+    const std::vector<hull::halfplane> halfplanes{{0, -1, 0}, {-1, 1, 0}, {1, 1, 2}};
+    // A slanted triangle, whose vertices are met up to rounding.
+    const std::vector<hull::halfplane> slanted{{3, 1, 15}, {0, 1, -1}, {-1, -3, 1}};
+    
+    // Act
+    const auto result = hull::halfplane_intersection<point>(halfplanes);
+    const auto result_slanted = hull::halfplane_intersection<point>(slanted);
+    
+    // Assert
+    const std::vector<point> expected{{{0, 0}}, {{2, 0}}, {{1, 1}}};
+    assert(result.status == hull::halfplane_status::bounded);
+    assert(result.polygon == expected);
+    assert(result_slanted.status == hull::halfplane_status::bounded);
+    assert(result_slanted.polygon.size() == 3);
+    for (const auto& p: result_slanted.polygon) {
+        assert(satisfies(slanted, p));
+    }
+});
+
+static auto test_halfplane_intersection_empty = add_test([] {
+    // Arrange
+    const std::vector<hull::halfplane> disjoint{{0, 1, 0}, {0, -1, -1}, {1, 0, 1}, {-1, 0, 1}};
+    const std::vector<hull::halfplane> crossing{{0, -1, 0}, {-1, 1, -3}, {1, 1, 2}};
+    const std::vector<hull::halfplane> impossible{{0, 0, -1}};
+    const std::vector<hull::halfplane> strip{{1, 0, 1}, {-1, 0, -2}};
+    
+    // Act
+    const auto result1 = hull::halfplane_intersection<point>(disjoint);
+    const auto result2 = hull::halfplane_intersection<point>(crossing);
+    const auto result3 = hull::halfplane_intersection<point>(impossible);
+    const auto result4 = hull::halfplane_intersection<point>(strip);
+    
+    // Assert
+    assert(result1.status == hull::halfplane_status::empty);
+    assert(result2.status == hull::halfplane_status::empty);
+    assert(result3.status == hull::halfplane_status::empty);
+    assert(result4.status == hull::halfplane_status::empty);
+    assert(result1.polygon.empty());
+});
+
+static auto test_halfplane_intersection_unbounded = add_test([] {
+    // Arrange
+    const std::vector<hull::halfplane> none;
+    const std::vector<hull::halfplane> quadrant{{-1, 0, 0}, {0, -1, 0}};
+    const std::vector<hull::halfplane> wedge{{-1, 1, 0}, {1, 1, 0}, {0, -1, 5}};
+    const std::vector<hull::halfplane> strip{{0, 1, 1}, {0, -1, 1}, {1, 0, 3}};
+    const std::vector<hull::halfplane> cone{{1, -1, 0}, {-1, -1, 0}};
+    
+    // Act
+    const auto result1 = hull::halfplane_intersection<point>(none);
+    const auto result2 = hull::halfplane_intersection<point>(quadrant);
+    const auto result3 = hull::halfplane_intersection<point>(wedge);
+    const auto result4 = hull::halfplane_intersection<point>(strip);
+    const auto result5 = hull::halfplane_intersection<point>(cone);
+    
+    // Assert
+    assert(result1.status == hull::halfplane_status::unbounded);
+    assert(result2.status == hull::halfplane_status::unbounded);
+    assert(result3.status == hull::halfplane_status::bounded);
+    assert(result4.status == hull::halfplane_status::unbounded);
+    assert(result5.status == hull::halfplane_status::unbounded);
+});
+
+static auto test_halfplane_intersection_degenerate = add_test([] {
+    // Arrange
+    // The segment x = 1, 0 <= y <= 1, and the point (1, 1), also as the
+    // intersection of slanted half-planes, met up to rounding.
+    const std::vector<hull::halfplane> segment{{1, 0, 1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 0}};
+    const std::vector<hull::halfplane> corner{{1, 0, 1}, {0, 1, 1}, {-1, -1, -2}};
+    const std::vector<hull::halfplane> slanted{{0, 1, 15}, {3, -1, 9}, {-2, -1, -3}, {-2, -3, 0}, {3, 1, 4}, {2, 3, 5}};
+    
+    // Act
+    const auto result1 = hull::halfplane_intersection<point>(segment);
+    const auto result2 = hull::halfplane_intersection<point>(corner);
+    const auto result3 = hull::halfplane_intersection<point>(slanted);
+    
+    // Assert
+    const std::vector<point> expected1{{{1, 0}}, {{1, 1}}};
+    const std::vector<point> expected2{{{1, 1}}};
+    assert(result1.status == hull::halfplane_status::bounded);
+    assert(result1.polygon == expected1);
+    assert(result2.status == hull::halfplane_status::bounded);
+    assert(result2.polygon == expected2);
+    assert(result3.status == hull::halfplane_status::bounded);
+    assert(result3.polygon.size() == 1);
+    assert(std::abs(result3.polygon.front()[0] - 1) < 1e-9);
+    assert(std::abs(result3.polygon.front()[1] - 1) < 1e-9);
+});
+
+static auto test_halfplane_intersection_random = add_test([] {
+    // Arrange
+    std::mt19937 generator(71);
+    
+    for (const std::size_t size: {3, 4, 10, 50}) {
+        for (int round{}; round < 20; round++) {
+            const auto halfplanes = random_halfplanes(generator, size);
+            
+            // Act
+            const auto result = hull::halfplane_intersection<point>(halfplanes);
+            
+            // Assert
+            assert(result.status == hull::halfplane_status::bounded);
+            for (const auto& p: result.polygon) {
+                assert(satisfies(halfplanes, p));
+            }
+            const auto expected = brute_intersection(halfplanes);
+            assert(std::abs(area(result.polygon) - area(expected)) < 1e-6);
+            assert(area(result.polygon) > 0);
+            assert(result.polygon.size() == expected.size());
+        }
+    }
+});
+
+static auto test_halfplane_intersections_batch = add_test([] {
+    // Arrange
+    std::mt19937 generator(710);
+    std::vector<hull::halfplane> halfplanes;
+    std::vector<std::size_t> offsets{0};
+    for (std::size_t i{}; i < 200; i++) {
+        const auto system = random_halfplanes(generator, 3 + i % 6);
+        halfplanes.insert(std::end(halfplanes), std::begin(system), std::end(system));
+        offsets.push_back(halfplanes.size());
+    }
+    halfplanes.push_back({0, 0, -1});
+    offsets.push_back(halfplanes.size());
+    
+    // Act
+    const auto results = hull::halfplane_intersections<point>(halfplanes, offsets, 4);
+    
+    // Assert
+    assert(results.size() == 201);
+    for (std::size_t i{}; i < 200; i++) {
+        const std::vector<hull::halfplane> system(std::begin(halfplanes) + static_cast<std::ptrdiff_t>(offsets[i]),
+                                                  std::begin(halfplanes) + static_cast<std::ptrdiff_t>(offsets[i + 1]));
+        const auto expected = hull::halfplane_intersection<point>(system);
+        assert(results[i].status == expected.status);
+        assert(results[i].polygon == expected.polygon);
+    }
+    assert(results.back().status == hull::halfplane_status::empty);
+});
+
+static auto test_halfplane_intersections_invalid = add_test([] {
+    // Arrange
+    const std::vector<hull::halfplane> halfplanes{{1, 0, 1}};
+    const std::vector<std::size_t> decreasing{1, 0};
+    const std::vector<std::size_t> overflowing{0, 2};
+    
+    // Act
+    bool thrown1{};
+    bool thrown2{};
+    try {
+        hull::halfplane_intersections<point>(halfplanes, decreasing);
+    }
+    catch (const std::invalid_argument&) {
+        thrown1 = true;
+    }
+    try {
+        hull::halfplane_intersections<point>(halfplanes, overflowing);
+    }
+    catch (const std::invalid_argument&) {
+        thrown2 = true;
+    }
+    
+    // Assert
+    assert(thrown1);
+    assert(thrown2);
+});
@@ -0,0 +1,190 @@
+/**
+ * Unit tests for the compact serialization of convex hulls.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/hull_codec.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+static auto test_encode_integral_hull = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> convex_hull{
+        {{-1000000, 5}}, {{-999990, -3}}, {{-999900, 40}}, {{-999995, 100}}
+    };
+    std::vector<unsigned char> bytes;
+    std::vector<std::array<int, 2>> target;
+    
+    // Act
+    const auto size = hull::io::encode_hull(std::begin(convex_hull), std::end(convex_hull), bytes);
+    hull::io::hull_reader<int> reader(bytes.data(), bytes.data() + bytes.size());
+    reader.read_into(target);
+    
+    // Assert
+    assert(size == bytes.size());
+    assert(size < convex_hull.size() * 2 * sizeof(int));
+    assert(target == convex_hull);
+    assert(reader.done());
+});
+
+static auto test_encode_floating_point_hulls = add_test([] {
+    // Arrange
+    // Many small hulls, one per object, as in a simulation.
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> centers(-1e4, 1e4);
+    std::uniform_real_distribution<double> offsets(-1., 1.);
+    std::vector<std::vector<std::array<double, 2>>> hulls(100);
+    std::size_t raw_size{};
+    for (auto& convex_hull: hulls) {
+        const auto cx = centers(generator);
+        const auto cy = centers(generator);
+        std::vector<std::array<double, 2>> points(50);
+        for (auto& p: points) {
+            p = {{cx + offsets(generator), cy + offsets(generator)}};
+        }
+        hull::convex::compute(hull::choice::monotone_chain, points, convex_hull);
+        raw_size += convex_hull.size() * 2 * sizeof(double);
+    }
+    hull::io::hull_codec_options options;
+    options.quantum = 1e-3;
+    std::vector<unsigned char> bytes;
+    
+    // Act
+    for (const auto& convex_hull: hulls) {
+        hull::io::encode_hull(std::begin(convex_hull), std::end(convex_hull), bytes, options);
+    }
+    hull::io::hull_reader<double> reader(bytes.data(), bytes.data() + bytes.size());
+    std::vector<std::array<double, 2>> decoded;
+    auto max_error = 0.;
+    std::size_t count{};
+    while (!reader.done()) {
+        reader.read_into(decoded);
+        assert(decoded.size() == hulls[count].size());
+        for (std::size_t i{}; i < decoded.size(); i++) {
+            max_error = std::max(max_error, std::abs(decoded[i][0] - hulls[count][i][0]));
+            max_error = std::max(max_error, std::abs(decoded[i][1] - hulls[count][i][1]));
+        }
+        count++;
+    }
+    
+    // Assert
+    assert(count == hulls.size());
+    assert(max_error <= 0.5e-3);
+    assert(3 * bytes.size() < raw_size);
+});
+
+static auto test_decode_relative_precision = add_test([] {
+    // Arrange
+    const std::vector<std::array<float, 2>> convex_hull{{{0.5f, 0.25f}}, {{1024.f, 0.f}}, {{512.f, 700.f}}};
+    std::vector<unsigned char> bytes;
+    hull::io::hull_codec_options options;
+    options.precision_bits = 20;
+    std::vector<std::array<float, 2>> target;
+    
+    // Act
+    hull::io::encode_hull(std::begin(convex_hull), std::end(convex_hull), bytes, options);
+    hull::io::hull_reader<float> reader(bytes.data(), bytes.data() + bytes.size());
+    reader.read(std::back_inserter(target));
+    
+    // Assert
+    // The scale is 2^-9 ~ 2e-3.
+    assert(target.size() == 3);
+    for (std::size_t i{}; i < 3; i++) {
+        assert(std::abs(target[i][0] - convex_hull[i][0]) <= 1e-3f);
+        assert(std::abs(target[i][1] - convex_hull[i][1]) <= 1e-3f);
+    }
+});
+
+static auto test_skip_and_empty_hull = add_test([] {
+    // Arrange
+    const std::vector<std::array<std::int64_t, 2>> first{{{1, 2}}, {{3, 4}}};
+    const std::vector<std::array<std::int64_t, 2>> empty;
+    const std::vector<std::array<std::int64_t, 2>> last{{{-7, 8}}};
+    std::vector<unsigned char> bytes;
+    hull::io::encode_hull(std::begin(first), std::end(first), bytes);
+    hull::io::encode_hull(std::begin(empty), std::end(empty), bytes);
+    hull::io::encode_hull(std::begin(last), std::end(last), bytes);
+    hull::io::hull_reader<std::int64_t> reader(bytes.data(), bytes.data() + bytes.size());
+    std::vector<std::array<std::int64_t, 2>> target{{{0, 0}}};
+    
+    // Act
+    const auto skipped = reader.skip();
+    reader.read_into(target);
+    const auto empty_decoded = target.empty();
+    reader.read_into(target);
+    
+    // Assert
+    assert(skipped == 2);
+    assert(empty_decoded);
+    assert(target == last);
+    assert(reader.done());
+});
+
+static auto test_truncated_hull_stream = add_test([] {
+    // Arrange
+    const std::vector<std::array<double, 2>> convex_hull{{{0., 0.}}, {{1., 0.}}, {{0., 1.}}};
+    std::vector<unsigned char> bytes;
+    hull::io::encode_hull(std::begin(convex_hull), std::end(convex_hull), bytes);
+    hull::io::hull_reader<double> reader(bytes.data(), bytes.data() + bytes.size() - 1);
+    std::vector<std::array<double, 2>> target;
+    auto thrown = false;
+    
+    // Act
+    try {
+        reader.read_into(target);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+});
+
+static auto test_hull_stream_of_another_coordinate_type = add_test([] {
+    // Arrange
+    const std::vector<std::array<std::int32_t, 2>> integral_hull{{{0, 0}}, {{10, 0}}, {{0, 10}}};
+    const std::vector<std::array<double, 2>> floating_point_hull{{{0., 0.}}, {{1., 0.}}, {{0., 1.}}};
+    std::vector<unsigned char> integral_bytes;
+    std::vector<unsigned char> floating_point_bytes;
+    hull::io::encode_hull(std::begin(integral_hull), std::end(integral_hull), integral_bytes);
+    hull::io::encode_hull(std::begin(floating_point_hull), std::end(floating_point_hull), floating_point_bytes);
+    hull::io::hull_reader<double> double_reader(integral_bytes.data(), integral_bytes.data() + integral_bytes.size());
+    hull::io::hull_reader<std::int32_t> int_reader(floating_point_bytes.data(),
+                                                   floating_point_bytes.data() + floating_point_bytes.size());
+    hull::io::hull_reader<std::int64_t> wider_reader(integral_bytes.data(), integral_bytes.data() + integral_bytes.size());
+    std::vector<std::array<double, 2>> double_target;
+    std::vector<std::array<std::int32_t, 2>> int_target;
+    std::vector<std::array<std::int64_t, 2>> wider_target;
+    auto thrown = 0;
+    
+    // Act
+    try {
+        double_reader.read_into(double_target);
+    }
+    catch (const std::runtime_error&) {
+        thrown++;
+    }
+    try {
+        int_reader.read_into(int_target);
+    }
+    catch (const std::runtime_error&) {
+        thrown++;
+    }
+    try {
+        wider_reader.skip();
+    }
+    catch (const std::runtime_error&) {
+        thrown++;
+    }
+    
+    // Assert
+    assert(thrown == 3);
+});
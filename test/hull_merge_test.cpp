@@ -0,0 +1,114 @@
+/**
+ * Unit tests for the linear-time merge of convex hulls.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/hull_merge.hpp"
+
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+/**
+ * @return - N random points in the square [x0 ; x0 + 1] x [y0 ; y0 + 1].
+ */
+static std::vector<std::array<double, 2>> random_merge_points(std::size_t N, double x0, double y0, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(0., 1.);
+    std::vector<std::array<double, 2>> points(N);
+    for (auto& p: points) {
+        p = {{x0 + distribution(generator), y0 + distribution(generator)}};
+    }
+    return points;
+}
+
+static auto test_merge_hulls_disjoint = add_test([] {
+    // Arrange
+    const auto points1 = random_merge_points(500, 0., 0., 1);
+    const auto points2 = random_merge_points(500, 3., 0.5, 2);
+    auto all = points1;
+    all.insert(std::end(all), std::begin(points2), std::end(points2));
+    std::vector<std::array<double, 2>> hull1;
+    std::vector<std::array<double, 2>> hull2;
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points1, hull1);
+    hull::convex::compute(hull::choice::monotone_chain, points2, hull2);
+    hull::convex::compute(hull::choice::monotone_chain, all, expected);
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::algorithms::merge_hulls(std::begin(hull1), std::end(hull1), std::begin(hull2), std::end(hull2),
+                                  std::back_inserter(target));
+    
+    // Assert
+    assert(target == expected);
+});
+
+static auto test_merge_hulls_any_orientation = add_test([] {
+    // Arrange
+    // Jarvis March is clockwise, Graham Scan starts at the lowest point.
+    const auto points1 = random_merge_points(300, 0., 0., 3);
+    const auto points2 = random_merge_points(300, 0.5, 0.5, 4);
+    auto all = points1;
+    all.insert(std::end(all), std::begin(points2), std::end(points2));
+    std::vector<std::array<double, 2>> hull1;
+    std::vector<std::array<double, 2>> hull2;
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::jarvis_march, points1, hull1);
+    hull::convex::compute(hull::choice::graham_scan, points2, hull2);
+    hull::convex::compute(hull::choice::monotone_chain, all, expected);
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::algorithms::merge_hulls(std::begin(hull1), std::end(hull1), std::begin(hull2), std::end(hull2),
+                                  std::back_inserter(target));
+    
+    // Assert
+    assert(target == expected);
+});
+
+static auto test_merge_hulls_nested_and_degenerate = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> outer{{{0, 0}}, {{10, 0}}, {{10, 10}}, {{0, 10}}};
+    const std::vector<std::array<int, 2>> inner{{{2, 2}}, {{8, 2}}, {{5, 7}}};
+    const std::vector<std::array<int, 2>> single{{{5, 20}}};
+    const std::vector<std::array<int, 2>> empty;
+    std::vector<std::array<int, 2>> nested;
+    std::vector<std::array<int, 2>> with_point;
+    std::vector<std::array<int, 2>> with_empty;
+    
+    // Act
+    hull::algorithms::merge_hulls(std::begin(outer), std::end(outer), std::begin(inner), std::end(inner),
+                                  std::back_inserter(nested));
+    hull::algorithms::merge_hulls(std::begin(outer), std::end(outer), std::begin(single), std::end(single),
+                                  std::back_inserter(with_point));
+    hull::algorithms::merge_hulls(std::begin(empty), std::end(empty), std::begin(single), std::end(single),
+                                  std::back_inserter(with_empty));
+    
+    // Assert
+    assert(nested == outer);
+    assert((with_point == std::vector<std::array<int, 2>>{{{0, 0}}, {{10, 0}}, {{10, 10}}, {{5, 20}}, {{0, 10}}}));
+    assert(with_empty == single);
+});
+
+static auto test_merge_hull_tree = add_test([] {
+    // Arrange
+    std::vector<std::vector<std::array<double, 2>>> hulls;
+    std::vector<std::array<double, 2>> all;
+    for (unsigned i{}; i < 7; i++) {
+        const auto points = random_merge_points(200, 0.7 * i, 0.3 * (i % 3), 10 + i);
+        all.insert(std::end(all), std::begin(points), std::end(points));
+        hulls.emplace_back();
+        hull::convex::compute(hull::choice::monotone_chain, points, hulls.back());
+    }
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, all, expected);
+    
+    // Act
+    const auto target = hull::algorithms::merge_hull_tree(std::begin(hulls), std::end(hulls), 3);
+    
+    // Assert
+    assert(target == expected);
+});
@@ -0,0 +1,107 @@
+/**
+ * Unit tests for the convex hull queries over axis-aligned rectangles.
+ */
+
+#include "test_main.hpp"
+#include "../hull/graham_scan.hpp"
+#include "../hull/kd_hull.hpp"
+#include "reference_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * @return - the convex hull of the points within the rectangle, by brute force.
+ */
+static std::vector<point> brute_query(const std::vector<point>& points, const point& min_corner, const point& max_corner) {
+    std::vector<point> inside;
+    std::copy_if(std::begin(points), std::end(points), std::back_inserter(inside), [&min_corner, &max_corner](const point& p) {
+        return p[0] >= min_corner[0] && p[0] <= max_corner[0] && p[1] >= min_corner[1] && p[1] <= max_corner[1];
+    });
+    return reference_hull(inside);
+}
+
+static auto test_kd_hull = add_test([] {
+    // Arrange
+    const std::vector<point> points{{0, 0}, {4, 0}, {4, 4}, {0, 4}, {2, 2}, {1, 3}, {3, 1}, {6, 6}};
+    
+    // Act
+    const hull::kd_hull<point> index(points);
+    const auto all = index.query({{0, 0}}, {{6, 6}});
+    const auto square = index.query({{0, 0}}, {{4, 4}});
+    const auto inner = index.query({{1, 1}}, {{3, 3}});
+    const auto single = index.query({{5, 5}}, {{7, 7}});
+    const auto none = index.query({{5, 0}}, {{7, 4}});
+    
+    // Assert
+    const std::vector<point> expected_all{{0, 0}, {4, 0}, {6, 6}, {0, 4}};
+    const std::vector<point> expected_square{{0, 0}, {4, 0}, {4, 4}, {0, 4}};
+    const std::vector<point> expected_inner{{1, 3}, {3, 1}};
+    const std::vector<point> expected_single{{6, 6}};
+    assert(index.size() == points.size());
+    assert(index.convex_hull() == expected_all);
+    assert(all == expected_all);
+    assert(square == expected_square);
+    assert(inner == expected_inner);
+    assert(single == expected_single);
+    assert(none.empty());
+});
+
+static auto test_kd_hull_same_as_brute_force = add_test([] {
+    // Arrange
+    std::mt19937 generator(74);
+    std::uniform_int_distribution<int> grid(-500, 500);
+    
+    for (const std::size_t size: {0, 1, 64, 65, 1000, 20000}) {
+        for (const std::size_t threads: {1, 4}) {
+            std::vector<point> points(size);
+            for (auto& p: points) {
+                p = {{grid(generator), grid(generator) / 4}};
+            }
+            
+            // Act
+            const hull::kd_hull<point> index(std::begin(points), std::end(points), threads);
+            
+            // Assert
+            for (int round{}; round < 30; round++) {
+                point min_corner{{grid(generator), grid(generator)}};
+                point max_corner{{grid(generator), grid(generator)}};
+                for (std::size_t i{}; i < 2; i++) {
+                    if (max_corner[i] < min_corner[i]) {
+                        std::swap(min_corner[i], max_corner[i]);
+                    }
+                }
+                const auto expected = brute_query(points, min_corner, max_corner);
+                const auto result = index.query(min_corner, max_corner);
+                assert(result == expected);
+            }
+        }
+    }
+});
+
+static auto test_kd_hull_policy = add_test([] {
+    // Arrange
+    std::mt19937 generator(740);
+    std::uniform_real_distribution<double> distribution(-1000., 1000.);
+    std::vector<std::array<double, 2>> points(5000);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    
+    // Act
+    const hull::kd_hull<std::array<double, 2>> monotone_index(points);
+    const hull::kd_hull<std::array<double, 2>, hull::graham_scan_t> graham_index(points, 0);
+    
+    // Assert
+    assert(graham_index.convex_hull() == monotone_index.convex_hull());
+    for (int round{}; round < 30; round++) {
+        std::array<double, 2> min_corner{{distribution(generator), distribution(generator)}};
+        std::array<double, 2> max_corner{{min_corner[0] + 500, min_corner[1] + 300}};
+        assert(graham_index.query(min_corner, max_corner) == monotone_index.query(min_corner, max_corner));
+    }
+});
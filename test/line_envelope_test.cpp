@@ -0,0 +1,133 @@
+/**
+ * Unit tests for the lower envelope of lines.
+ */
+
+#include "test_main.hpp"
+#include "../hull/line_envelope.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using line = std::array<long long, 2>;
+
+/**
+ * @return - the minimum of the lines at x, by brute force.
+ */
+static long long brute_minimum(const std::vector<line>& lines, long long x) {
+    auto best = lines.front()[0] * x + lines.front()[1];
+    for (const auto& l: lines) {
+        best = std::min(best, l[0] * x + l[1]);
+    }
+    return best;
+}
+
+static auto test_line_envelope = add_test([] {
+    // Arrange
+    // y = x, y = -x, y = 2 (never the lowest) and y = -1.
+    const std::vector<line> lines{{{1, 0}}, {{-1, 0}}, {{0, 2}}, {{0, -1}}};
+    
+    // Act
+    const hull::line_envelope<line> envelope(std::begin(lines), std::end(lines));
+    
+    // Assert
+    assert(envelope.lines().size() == 3);
+    assert(envelope.minimum(0) == -1);
+    assert(envelope.minimum(5) == -5);
+    assert(envelope.minimum(-5) == -5);
+    assert((envelope.line(-5) == line{{1, 0}}));
+});
+
+static auto test_line_envelope_queries = add_test([] {
+    // Arrange
+    std::mt19937 generator(70);
+    std::uniform_int_distribution<long long> slope(-20, 20);
+    std::uniform_int_distribution<long long> intercept(-1000, 1000);
+    std::uniform_int_distribution<long long> abscissa(-200, 200);
+    
+    for (const std::size_t size: {1, 2, 5, 100, 2000}) {
+        std::vector<line> lines(size);
+        for (auto& l: lines) {
+            l = {{slope(generator), intercept(generator)}};
+        }
+        std::vector<long long> xs(500);
+        for (auto& x: xs) {
+            x = abscissa(generator);
+        }
+        std::sort(std::begin(xs), std::end(xs));
+        
+        // Act
+        const hull::line_envelope<line> envelope(std::begin(lines), std::end(lines));
+        auto forward = envelope.walk();
+        auto backward = envelope.walk();
+        
+        // Assert
+        for (const auto x: xs) {
+            assert(envelope.minimum(x) == brute_minimum(lines, x));
+            assert(forward.minimum(x) == brute_minimum(lines, x));
+        }
+        for (auto it = std::rbegin(xs); it != std::rend(xs); ++it) {
+            assert(backward.minimum(*it) == brute_minimum(lines, *it));
+        }
+    }
+});
+
+static auto test_line_envelope_online = add_test([] {
+    // Arrange
+    std::mt19937 generator(700);
+    std::uniform_int_distribution<long long> slope(-50, 50);
+    std::uniform_int_distribution<long long> intercept(-1000, 1000);
+    std::vector<line> lines(3000);
+    for (auto& l: lines) {
+        l = {{slope(generator), intercept(generator)}};
+    }
+    std::sort(std::begin(lines), std::end(lines), [](const line& a, const line& b) { return a[0] < b[0]; });
+    
+    // Act
+    hull::line_envelope<line> online;
+    std::vector<line> added;
+    for (const auto& l: lines) {
+        online.add(l);
+        added.push_back(l);
+        
+        // Assert
+        if (added.size() % 500 == 0) {
+            for (long long x{-100}; x <= 100; x += 7) {
+                assert(online.minimum(x) == brute_minimum(added, x));
+            }
+        }
+    }
+    
+    // Assert
+    const hull::line_envelope<line> offline(std::begin(lines), std::end(lines));
+    assert(online.lines() == offline.lines());
+});
+
+static auto test_line_envelope_errors = add_test([] {
+    // Arrange
+    hull::line_envelope<line> envelope;
+    
+    // Act
+    bool empty{};
+    try {
+        envelope.minimum(0);
+    }
+    catch (const std::out_of_range&) {
+        empty = true;
+    }
+    envelope.add({{2, 0}});
+    bool unsorted{};
+    try {
+        envelope.add({{1, 0}});
+    }
+    catch (const std::invalid_argument&) {
+        unsorted = true;
+    }
+    
+    // Assert
+    assert(empty);
+    assert(unsorted);
+});
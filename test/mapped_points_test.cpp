@@ -0,0 +1,208 @@
+/**
+ * Unit tests for the memory-mapped point files.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/mapped_points.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/**
+ * Write the given coordinates as a flat little-endian file
+ * in a new temporary file.
+ * @param coordinates - the interleaved coordinates.
+ * @return - the path to the temporary file.
+ */
+template <typename T>
+static std::string write_temporary_point_file(const std::vector<T>& coordinates) {
+    char path[] = "/tmp/hull_mapped_points_XXXXXX";
+    const auto fd = ::mkstemp(path);
+    assert(fd >= 0);
+    
+    std::vector<unsigned char> bytes(coordinates.size() * sizeof(T));
+    for (std::size_t i{}; i < coordinates.size(); i++) {
+        hull::io::details::store_little_endian(coordinates[i], bytes.data() + i * sizeof(T));
+    }
+    
+    const auto written = ::write(fd, bytes.data(), bytes.size());
+    assert(written == static_cast<ssize_t>(bytes.size()));
+    ::close(fd);
+    
+    return path;
+}
+
+static auto test_mapped_points_random_access = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<double>({1., 2., 3., 4., 5., 6.});
+    
+    // Act
+    hull::io::mapped_points<double> points(path);
+    
+    // Assert
+    assert(points.size() == 3);
+    assert(std::distance(std::begin(points), std::end(points)) == 3);
+    assert(hull::x(points[1]) == 3. && hull::y(points[1]) == 4.);
+    assert(hull::x(*(std::end(points) - 1)) == 5.);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_empty_file = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<float>({});
+    
+    // Act
+    hull::io::mapped_points<float> points(path);
+    
+    // Assert
+    assert(points.empty());
+    assert(std::begin(points) == std::end(points));
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_truncated_file = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<float>({1.f, 2.f, 3.f});
+    auto thrown = false;
+    
+    // Act
+    try {
+        hull::io::mapped_points<float> points(path);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_jarvis_march_without_copy = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<std::int32_t>({
+        13, 5, 12, 8, 10, 3, 7, 7, 9, 6,
+        4, 0, 7, 1, 7, 4, 3, 3, 1, 1
+    });
+    using point_type = std::array<std::int32_t, 2>;
+    const auto expected = std::array<point_type, 6>{{
+        {{1, 1}}, {{7, 7}}, {{12, 8}},
+        {{13, 5}}, {{7, 1}}, {{4, 0}}
+    }};
+    hull::io::mapped_points<std::int32_t> points(path);
+    std::vector<point_type> target;
+    
+    // Act
+    hull::convex::compute(hull::choice::jarvis_march, points, target);
+    
+    // Assert
+    assert(target == std::vector<point_type>(std::begin(expected), std::end(expected)));
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_monotone_chain_on_working_set = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<std::int32_t>({
+        13, 5, 12, 8, 10, 3, 7, 7, 9, 6,
+        4, 0, 7, 1, 7, 4, 3, 3, 1, 1
+    });
+    using point_type = std::array<std::int32_t, 2>;
+    const auto expected = std::array<point_type, 6>{{
+        {{1, 1}}, {{4, 0}}, {{7, 1}},
+        {{13, 5}}, {{12, 8}}, {{7, 7}}
+    }};
+    hull::io::mapped_points<std::int32_t> points(path);
+    std::vector<point_type> target;
+    
+    // Act
+    hull::convex::compute(hull::choice::monotone_chain, points, target);
+    
+    // Assert
+    assert(target == std::vector<point_type>(std::begin(expected), std::end(expected)));
+    assert(hull::x(points[0]) == 13); // The mapping itself is untouched
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_same_hull_as_in_memory = add_test([] {
+    // Arrange
+    // Enough points to skip the small kernels, with duplicates and collinear points.
+    std::mt19937 generator(51);
+    std::uniform_int_distribution<std::int32_t> distribution(-50, 50);
+    std::vector<std::int32_t> coordinates(2 * 1000);
+    for (auto& c: coordinates) {
+        c = distribution(generator);
+    }
+    const auto path = write_temporary_point_file(coordinates);
+    using point_type = std::array<std::int32_t, 2>;
+    hull::io::mapped_points<std::int32_t> points(path);
+    auto in_memory = points.to_vector();
+    std::vector<point_type> expected(2 * in_memory.size());
+    expected.erase(hull::algorithms::monotone_chain(std::begin(in_memory), std::end(in_memory), std::begin(expected)),
+                   std::end(expected));
+    std::vector<point_type> target;
+    std::vector<point_type> chan;
+    
+    // Act
+    hull::convex::compute(hull::choice::monotone_chain, points, target);
+    hull::convex::compute(hull::choice::chan, points, chan);
+    
+    // Assert
+    assert(target == expected);
+    assert(chan.size() == expected.size());
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_graham_scan_and_chan = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<double>({
+        0., 0., 5., 5., 5., 0., -5., 0., -5., 5., -5., -5.,
+        0., -5., 0., 5., 5., -5., 2., 3., -3., 2., -5., 4.
+    });
+    hull::io::mapped_points<double> points(path);
+    std::vector<std::array<double, 2>> graham;
+    std::vector<std::array<double, 2>> chan;
+    
+    // Act
+    hull::convex::compute(hull::choice::graham_scan, points, graham);
+    hull::convex::compute(hull::choice::chan, points, chan);
+    
+    // Assert
+    assert(graham.size() == 4);
+    assert(chan.size() == 4);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_mapped_points_bounding_box = add_test([] {
+    // Arrange
+    const auto path = write_temporary_point_file<float>({
+        13.f, 5.f, -12.f, 8.f, 10.f, 3.f, 7.f, -7.f, -9.f, -6.f
+    });
+    using point_type = std::array<float, 2>;
+    const auto expected = std::array<point_type, 4>{{
+        {{-12.f, -7.f}}, {{13.f, -7.f}}, {{13.f, 8.f}}, {{-12.f, 8.f}}
+    }};
+    hull::io::mapped_points<float> points(path);
+    std::vector<point_type> target;
+    
+    // Act
+    hull::algorithms::bounding_box(std::begin(points), std::end(points), std::back_inserter(target));
+    
+    // Assert
+    assert(target == std::vector<point_type>(std::begin(expected), std::end(expected)));
+    
+    std::remove(path.c_str());
+});
@@ -0,0 +1,141 @@
+/**
+ * Unit tests for Melkman's algorithm.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "point2d.hpp"
+#include "reference_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+/**
+ * @return - a random star-shaped (hence simple) polygon, counter-clockwise.
+ *           The angular gaps are below pi, so that the origin is in its kernel,
+ *           and large enough for the rounding not to break it.
+ */
+static std::vector<point2d> star_polygon(std::mt19937& generator, std::size_t n) {
+    std::uniform_real_distribution<double> radius(1000., 5000.);
+    std::uniform_real_distribution<double> jitter(0., .5);
+    
+    std::vector<point2d> polygon;
+    for (std::size_t i{}; i < n; i++) {
+        const auto a = 2. * 3.14159265358979 * (static_cast<double>(i) + jitter(generator)) / static_cast<double>(n);
+        const auto r = radius(generator);
+        polygon.push_back({static_cast<int>(r * std::cos(a)), static_cast<int>(r * std::sin(a))});
+    }
+    return polygon;
+}
+
+static auto test_melkman = add_test([] {
+    // Arrange
+    // An L-shaped footprint, clockwise, with a collinear vertex.
+    const auto polygon = std::array<point2d, 7>{{
+        {0, 0}, {0, 10}, {4, 10}, {4, 4}, {10, 4}, {10, 0}, {5, 0}
+    }};
+    const auto expected = std::array<point2d, 5>{{
+        {0, 0}, {10, 0}, {10, 4}, {4, 10}, {0, 10}
+    }};
+    std::vector<point2d> target;
+    
+    // Act
+    hull::algorithms::melkman(std::begin(polygon), std::end(polygon), std::back_inserter(target));
+    
+    // Assert
+    assert(target.size() == expected.size());
+    assert(std::equal(std::begin(target), std::end(target), std::begin(expected)));
+});
+
+static auto test_melkman_with_a_polyline = add_test([] {
+    // Arrange
+    // An open zig-zag, whose concave vertices enter and leave the hull.
+    const auto polyline = std::list<point2d>{{
+        {0, 0}, {2, 3}, {4, 1}, {6, 5}, {8, 2}, {10, 6}, {5, 9}
+    }};
+    std::vector<point2d> target;
+    
+    // Act
+    hull::algorithms::melkman(std::begin(polyline), std::end(polyline), std::back_inserter(target));
+    
+    // Assert
+    assert(target == reference_hull(std::vector<point2d>(std::begin(polyline), std::end(polyline))));
+});
+
+static auto test_melkman_same_as_monotone_chain = add_test([] {
+    // Arrange
+    std::mt19937 generator(66);
+    std::uniform_int_distribution<std::size_t> sizes(5, 200);
+    
+    for (auto trial = 0; trial < 300; trial++) {
+        auto polygon = star_polygon(generator, sizes(generator));
+        if (trial % 2 == 1) {
+            std::reverse(std::begin(polygon), std::end(polygon));
+        }
+        std::rotate(std::begin(polygon), std::begin(polygon) + trial % polygon.size(), std::end(polygon));
+        
+        // Act
+        std::vector<point2d> target;
+        hull::convex::compute(hull::choice::simple_polygon, polygon, target);
+        
+        // Assert
+        assert(target == reference_hull(polygon));
+    }
+});
+
+static auto test_melkman_with_empty_set = add_test([] {
+    // Arrange
+    const std::vector<point2d> polygon;
+    std::vector<point2d> target;
+    
+    // Act
+    hull::convex::compute(hull::choice::simple_polygon, polygon, target);
+    
+    // Assert
+    assert(target.empty());
+});
+
+static auto test_melkman_with_1_point = add_test([] {
+    // Arrange
+    const std::vector<point2d> polygon{{3, 4}};
+    std::vector<point2d> target;
+    
+    // Act
+    hull::convex::compute(hull::choice::simple_polygon, polygon, target);
+    
+    // Assert
+    assert(target == polygon);
+});
+
+static auto test_melkman_collinear = add_test([] {
+    // Arrange
+    const std::vector<point2d> polyline{{2, 2}, {2, 2}, {4, 4}, {0, 0}, {3, 3}};
+    const std::vector<point2d> expected{{0, 0}, {4, 4}};
+    std::vector<point2d> target;
+    
+    // Act
+    hull::convex::compute(hull::choice::simple_polygon, polyline, target);
+    
+    // Assert
+    assert(target == expected);
+});
+
+static auto test_melkman_with_metrics = add_test([] {
+    // Arrange
+    const std::vector<point2d> polygon{{0, 0}, {0, 4}, {2, 2}, {4, 4}, {4, 0}};
+    std::vector<point2d> target;
+    
+    // Act
+    const auto metrics = hull::convex::compute_with_metrics(hull::choice::simple_polygon, polygon, target);
+    
+    // Assert
+    assert(target.size() == 4);
+    assert(hull::equals(metrics.area, 16.));
+    assert(hull::equals(metrics.perimeter, 16.));
+    assert(hull::equals(metrics.centroid_x, 2.) && hull::equals(metrics.centroid_y, 2.));
+});
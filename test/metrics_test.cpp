@@ -0,0 +1,106 @@
+/**
+ * Unit tests for the metrics accumulated during the hull computation.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+
+/**
+ * @return - the metrics of a polygon, computed by walking it.
+ */
+static hull::hull_metrics walk(const std::vector<std::array<double, 2>>& polygon) {
+    hull::hull_metrics metrics;
+    double area2{};
+    for (std::size_t i{}; i < polygon.size(); i++) {
+        const auto& a = polygon[i];
+        const auto& b = polygon[(i + 1) % polygon.size()];
+        const auto c = a[0] * b[1] - b[0] * a[1];
+        area2 += c;
+        metrics.perimeter += std::hypot(b[0] - a[0], b[1] - a[1]);
+        metrics.centroid_x += (a[0] + b[0]) * c;
+        metrics.centroid_y += (a[1] + b[1]) * c;
+    }
+    metrics.area = std::abs(area2) / 2.;
+    metrics.centroid_x /= 3. * area2;
+    metrics.centroid_y /= 3. * area2;
+    return metrics;
+}
+
+static bool close(double a, double b) {
+    return std::abs(a - b) <= 1e-9 * std::max(1., std::abs(b));
+}
+
+static bool close(const hull::hull_metrics& m1, const hull::hull_metrics& m2) {
+    return close(m1.area, m2.area) && close(m1.perimeter, m2.perimeter) &&
+           close(m1.centroid_x, m2.centroid_x) && close(m1.centroid_y, m2.centroid_y);
+}
+
+template <typename Policy>
+static void check_policy(Policy policy) {
+    // Arrange
+    std::mt19937 generator(51);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    std::vector<std::array<double, 2>> points(2000);
+    for (auto& p: points) {
+        p = {{100. + distribution(generator), -50. + distribution(generator)}};
+    }
+    std::vector<std::array<double, 2>> convex_hull;
+    
+    // Act
+    const auto metrics = hull::convex::compute_with_metrics(policy, points, convex_hull);
+    
+    // Assert
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(policy, points, expected);
+    assert(convex_hull == expected);
+    assert(close(metrics, walk(convex_hull)));
+}
+
+static auto test_metrics_every_policy = add_test([] {
+    check_policy(hull::choice::monotone_chain);
+    check_policy(hull::choice::graham_scan);
+    check_policy(hull::choice::jarvis_march);
+    check_policy(hull::choice::chan);
+});
+
+static auto test_metrics_square = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> points{{{0, 0}}, {{2, 0}}, {{1, 1}}, {{2, 2}}, {{0, 2}}, {{1, 0}}};
+    std::vector<std::array<int, 2>> convex_hull(2 * points.size());
+    auto input = points;
+    
+    // Act
+    const auto result = hull::compute_convex_hull_with_metrics(hull::choice::monotone_chain,
+                                                               std::begin(input), std::end(input), std::begin(convex_hull));
+    
+    // Assert
+    assert(result.last - std::begin(convex_hull) == 4);
+    assert(result.metrics.area == 4.);
+    assert(result.metrics.perimeter == 8.);
+    assert(result.metrics.centroid_x == 1.);
+    assert(result.metrics.centroid_y == 1.);
+});
+
+static auto test_metrics_degenerate = add_test([] {
+    // Arrange
+    const std::vector<std::array<double, 2>> point{{{3., 4.}}};
+    const std::vector<std::array<double, 2>> segment{{{0., 0.}}, {{1., 1.}}, {{2., 2.}}};
+    std::vector<std::array<double, 2>> convex_hull;
+    
+    // Act
+    const auto point_metrics = hull::convex::compute_with_metrics(hull::choice::monotone_chain, point, convex_hull);
+    const auto segment_metrics = hull::convex::compute_with_metrics(hull::choice::monotone_chain, segment, convex_hull);
+    
+    // Assert
+    assert(point_metrics.area == 0. && point_metrics.perimeter == 0.);
+    assert(point_metrics.centroid_x == 3. && point_metrics.centroid_y == 4.);
+    assert(segment_metrics.area == 0.);
+    assert(close(segment_metrics.perimeter, 2. * std::sqrt(8.)));
+    assert(close(segment_metrics.centroid_x, 1.) && close(segment_metrics.centroid_y, 1.));
+});
@@ -0,0 +1,139 @@
+/**
+ * Unit tests for the Pareto front.
+ */
+
+#include "test_main.hpp"
+#include "../hull/monotone_chain.hpp"
+#include "../hull/pareto.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * @return - true if p1 dominates p2.
+ */
+static bool dominates(const point& p1, const point& p2, const hull::pareto_directions& directions) {
+    const auto dx = directions.maximize_x ? p1[0] - p2[0] : p2[0] - p1[0];
+    const auto dy = directions.maximize_y ? p1[1] - p2[1] : p2[1] - p1[1];
+    return dx >= 0 && dy >= 0 && (dx > 0 || dy > 0);
+}
+
+/**
+ * @return - the Pareto front by brute force, sorted by increasing x-coordinate.
+ */
+static std::vector<point> brute_front(const std::vector<point>& points, const hull::pareto_directions& directions) {
+    std::vector<point> front;
+    for (const auto& p: points) {
+        const auto dominated = std::any_of(std::begin(points), std::end(points), [&](const point& q) {
+            return dominates(q, p, directions);
+        });
+        if (!dominated) {
+            front.push_back(p);
+        }
+    }
+    std::sort(std::begin(front), std::end(front));
+    front.erase(std::unique(std::begin(front), std::end(front)), std::end(front));
+    return front;
+}
+
+/**
+ * @return - the vertices of the convex hull on the Pareto front, by brute force.
+ */
+static std::vector<point> brute_convex_front(std::vector<point> points, const hull::pareto_directions& directions) {
+    const auto front = brute_front(points, directions);
+    std::vector<point> convex_hull(2 * points.size());
+    convex_hull.erase(hull::algorithms::monotone_chain(std::begin(points), std::end(points), std::begin(convex_hull)),
+                      std::end(convex_hull));
+    std::vector<point> convex_front;
+    for (const auto& p: convex_hull) {
+        if (std::binary_search(std::begin(front), std::end(front), p)) {
+            convex_front.push_back(p);
+        }
+    }
+    std::sort(std::begin(convex_front), std::end(convex_front));
+    return convex_front;
+}
+
+/**
+ * @return - the Pareto front, computed with the given number of threads.
+ */
+static std::vector<point> front(std::vector<point> points, const hull::pareto_directions& directions, std::size_t threads) {
+    std::vector<point> result(points.size());
+    result.erase(hull::pareto_front(std::begin(points), std::end(points), std::begin(result), directions, threads),
+                 std::end(result));
+    return result;
+}
+
+static auto test_pareto_front = add_test([] {
+    // Arrange
+    const std::vector<point> points{{1, 5}, {2, 4}, {2, 2}, {3, 4}, {4, 1}, {0, 0}, {4, 1}, {1, 5}};
+    const std::vector<point> expected_max{{1, 5}, {3, 4}, {4, 1}};
+    const std::vector<point> expected_min{{0, 0}};
+    const std::vector<point> expected_min_x{{0, 0}, {1, 5}};
+    
+    // Act
+    const auto max = front(points, {true, true}, 1);
+    const auto min = front(points, {false, false}, 1);
+    const auto min_x = front(points, {false, true}, 1);
+    
+    // Assert
+    assert(max == expected_max);
+    assert(min == expected_min);
+    assert(min_x == expected_min_x);
+});
+
+static auto test_convex_pareto_front = add_test([] {
+    // Arrange
+    // (2, 3) is on the front but inside the hull, (3, 2) is on the edge from (1, 4) to (5, 0).
+    std::vector<point> points{{0, 0}, {1, 4}, {2, 3}, {3, 2}, {5, 0}, {1, 1}};
+    std::vector<point> result(points.size());
+    const std::vector<point> expected{{1, 4}, {5, 0}};
+    
+    // Act
+    result.erase(hull::convex_pareto_front(std::begin(points), std::end(points), std::begin(result)), std::end(result));
+    
+    // Assert
+    assert(result == expected);
+});
+
+static auto test_pareto_front_same_as_brute_force = add_test([] {
+    // Arrange
+    std::mt19937 generator(72);
+    std::uniform_int_distribution<int> grid(-40, 40);
+    const std::vector<hull::pareto_directions> all_directions{{true, true}, {true, false}, {false, true}, {false, false}};
+    
+    for (const std::size_t size: {0, 1, 2, 10, 500, 20000}) {
+        std::vector<point> points(size);
+        for (auto& p: points) {
+            p = {{grid(generator), grid(generator)}};
+        }
+        for (const auto& directions: all_directions) {
+            const auto expected = brute_front(size <= 500 ? points : front(points, directions, 1), directions);
+            const auto expected_convex = brute_convex_front(points, directions);
+            for (const std::size_t threads: {1, 3}) {
+                // Act
+                const auto result = front(points, directions, threads);
+                auto sorted = points;
+                std::sort(std::begin(sorted), std::end(sorted), hull::algorithms::details::monotone::lexicographic_less{});
+                std::vector<point> presorted(size);
+                presorted.erase(hull::pareto_front(hull::presorted, std::begin(sorted), std::end(sorted), std::begin(presorted),
+                                                   directions, threads),
+                                std::end(presorted));
+                auto copy = points;
+                std::vector<point> convex(size);
+                convex.erase(hull::convex_pareto_front(std::begin(copy), std::end(copy), std::begin(convex), directions, threads),
+                             std::end(convex));
+                
+                // Assert
+                assert(result == expected);
+                assert(presorted == expected);
+                assert(convex == expected_convex);
+            }
+        }
+    }
+});
@@ -0,0 +1,176 @@
+/**
+ * Unit tests for the pipelined convex hull.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/pipeline.hpp"
+
+#include <array>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+/**
+ * Write raw bytes to a new temporary file.
+ * @param bytes - the content of the file.
+ * @return - the path to the temporary file.
+ */
+static std::string write_temporary_pipeline_file(const std::string& bytes) {
+    char path[] = "/tmp/hull_pipeline_XXXXXX";
+    const auto fd = ::mkstemp(path);
+    assert(fd >= 0);
+    
+    const auto written = ::write(fd, bytes.data(), bytes.size());
+    assert(written == static_cast<ssize_t>(bytes.size()));
+    ::close(fd);
+    
+    return path;
+}
+
+/**
+ * @return - N random points in the square [-1 ; 1] x [-1 ; 1].
+ */
+static std::vector<std::array<double, 2>> random_pipeline_points(std::size_t N) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    std::vector<std::array<double, 2>> points(N);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    return points;
+}
+
+static auto test_spsc_queue = add_test([] {
+    // Arrange
+    hull::parallel::spsc_queue<std::size_t> queue(3);
+    const std::size_t N = 10000;
+    std::size_t sum{};
+    std::size_t count{};
+    
+    // Act
+    std::thread producer([&queue] {
+        for (std::size_t i{1}; i <= N; i++) {
+            queue.push(i);
+        }
+        queue.close();
+    });
+    std::size_t value{};
+    while (queue.pop(value)) {
+        sum += value;
+        count++;
+    }
+    producer.join();
+    
+    // Assert
+    assert(count == N);
+    assert(sum == N * (N + 1) / 2);
+});
+
+static auto test_spsc_queue_cancel = add_test([] {
+    // Arrange
+    hull::parallel::spsc_queue<int> queue(1);
+    queue.push(1);
+    
+    // Act
+    queue.cancel();
+    const auto pushed = queue.push(2);
+    
+    // Assert
+    assert(!pushed);
+    assert(queue.cancelled());
+});
+
+static auto test_pipelined_convex_hull_binary = add_test([] {
+    // Arrange
+    const auto points = random_pipeline_points(20000);
+    std::string bytes(points.size() * 2 * sizeof(double), '\0');
+    auto p = reinterpret_cast<unsigned char*>(&bytes[0]);
+    for (const auto& point: points) {
+        hull::io::details::store_little_endian(point[0], p);
+        hull::io::details::store_little_endian(point[1], p + sizeof(double));
+        p += 2 * sizeof(double);
+    }
+    const auto path = write_temporary_pipeline_file(bytes);
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    
+    // A chunk size which is not a multiple of the point size.
+    hull::io::pipeline_options options;
+    options.chunk_size = 10000;
+    hull::io::pipeline_stats stats;
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::io::pipelined_convex_hull<double>(path, std::back_inserter(target), hull::choice::graham_scan, options, &stats);
+    
+    // Assert
+    assert(target == expected);
+    assert(stats.points == points.size());
+    assert(stats.chunks > 30);
+    assert(stats.survivors < points.size() / 2);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_pipelined_convex_hull_text = add_test([] {
+    // Arrange
+    const auto points = random_pipeline_points(5000);
+    std::string text = "# x,y\n";
+    for (const auto& point: points) {
+        text += std::to_string(point[0]) + "," + std::to_string(point[1]) + "\n";
+    }
+    text += "not a point\n1,1";
+    const auto path = write_temporary_pipeline_file(text);
+    
+    std::vector<std::array<double, 2>> all;
+    hull::io::parse_points(text.data(), text.data() + text.size(), all);
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, all, expected);
+    
+    hull::io::pipeline_options options;
+    options.input = hull::io::pipeline_input::text;
+    options.chunk_size = 4096;
+    options.queue_depth = 2;
+    options.prefilter = false;
+    hull::io::pipeline_stats stats;
+    std::vector<std::array<double, 2>> target;
+    
+    // Act
+    hull::io::pipelined_convex_hull<double>(path, std::back_inserter(target), hull::choice::monotone_chain, options, &stats);
+    
+    // Assert
+    assert(target == expected);
+    assert(stats.points == points.size() + 1);
+    assert(stats.malformed == 1);
+    assert(stats.survivors == stats.points);
+    
+    std::remove(path.c_str());
+});
+
+static auto test_pipelined_convex_hull_truncated = add_test([] {
+    // Arrange
+    const auto path = write_temporary_pipeline_file(std::string(2 * sizeof(double) * 100 + 3, '\0'));
+    std::vector<std::array<double, 2>> target;
+    auto thrown = false;
+    
+    // Act
+    try {
+        hull::io::pipelined_convex_hull<double>(path, std::back_inserter(target));
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+    
+    std::remove(path.c_str());
+});
@@ -0,0 +1,32 @@
+/**
+ * Unit tests for the Akl-Toussaint heuristic.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/prefilter.hpp"
+
+#include <array>
+#include <iterator>
+#include <vector>
+
+static auto test_akl_toussaint = add_test([] {
+    // Arrange
+    const auto points = std::array<std::array<int, 2>, 10>{{
+        {{13, 5}}, {{12, 8}}, {{10, 3}}, {{7, 7}},
+        {{9, 6}}, {{4, 0}}, {{7, 1}}, {{7, 4}},
+        {{3, 3}}, {{1, 1}}
+    }};
+    std::vector<std::array<int, 2>> survivors;
+    std::vector<std::array<int, 2>> expected;
+    std::vector<std::array<int, 2>> target;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    
+    // Act
+    hull::algorithms::akl_toussaint(std::begin(points), std::end(points), std::back_inserter(survivors));
+    hull::convex::compute(hull::choice::monotone_chain, survivors, target);
+    
+    // Assert
+    assert(survivors.size() < points.size());
+    assert(target == expected);
+});
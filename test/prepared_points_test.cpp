@@ -0,0 +1,139 @@
+/**
+ * Unit tests for the convex hulls of subsets of prepared points.
+ */
+
+#include "test_main.hpp"
+#include "../hull/prepared_points.hpp"
+#include "reference_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * @return - the convex hull of the selected points, by brute force.
+ */
+static std::vector<point> brute_hull(const std::vector<point>& points, const std::vector<bool>& selected) {
+    std::vector<point> subset;
+    for (std::size_t i{}; i < points.size(); i++) {
+        if (selected[i]) {
+            subset.push_back(points[i]);
+        }
+    }
+    return reference_hull(subset);
+}
+
+static auto test_prepared_points = add_test([] {
+    // Arrange
+    const std::vector<point> points{{0, 0}, {4, 0}, {2, 2}, {4, 4}, {0, 4}, {1, 1}};
+    const std::vector<int> labels{1, 2, 1, 1, 2, 1};
+    
+    // Act
+    const hull::prepared_points<point> prepared(points);
+    const auto all = prepared.hull_of([](std::size_t) { return true; });
+    const auto ones = prepared.hull_of([&labels](std::size_t i) { return labels[i] == 1; });
+    const auto none = prepared.hull_of([](std::size_t) { return false; });
+    const auto single = prepared.hull_of(std::vector<std::uint64_t>{std::uint64_t{1} << 2});
+    
+    // Assert
+    const std::vector<point> expected_all{{0, 0}, {4, 0}, {4, 4}, {0, 4}};
+    const std::vector<point> expected_ones{{0, 0}, {4, 4}};
+    const std::vector<point> expected_single{{2, 2}};
+    assert(prepared.size() == points.size());
+    assert(prepared.sorted().front() == points[0]);
+    assert(prepared.order().back() == 3);
+    assert(all == expected_all);
+    assert(ones == expected_ones);
+    assert(none.empty());
+    assert(single == expected_single);
+});
+
+static auto test_prepared_points_same_as_sorting = add_test([] {
+    // Arrange
+    std::mt19937 generator(75);
+    std::uniform_int_distribution<int> grid(-100, 100);
+    std::bernoulli_distribution coin(0.3);
+    
+    for (const std::size_t size: {0, 1, 63, 64, 65, 1000, 10000}) {
+        std::vector<point> points(size);
+        for (auto& p: points) {
+            p = {{grid(generator), grid(generator)}};
+        }
+        const hull::prepared_points<point> prepared(std::begin(points), std::end(points));
+        
+        for (int round{}; round < 10; round++) {
+            std::vector<bool> selected(size);
+            std::vector<std::uint64_t> mask((size + 63) / 64);
+            for (std::size_t i{}; i < size; i++) {
+                selected[i] = coin(generator);
+                if (selected[i]) {
+                    mask[i / 64] |= std::uint64_t{1} << (i % 64);
+                }
+            }
+            
+            // Act
+            const auto by_predicate = prepared.hull_of([&selected](std::size_t i) { return selected[i]; });
+            const auto by_mask = prepared.hull_of(mask);
+            const auto sorted_mask = prepared.permute_mask(mask);
+            const auto by_sorted_mask = prepared.hull_of_sorted(sorted_mask);
+            
+            // Assert
+            const auto expected = brute_hull(points, selected);
+            assert(by_predicate == expected);
+            assert(by_mask == expected);
+            assert(by_sorted_mask == expected);
+            for (std::size_t k{}; k < size; k++) {
+                assert(((sorted_mask[k / 64] >> (k % 64)) & 1) == selected[prepared.order()[k]]);
+            }
+        }
+    }
+});
+
+static auto test_prepared_points_short_mask = add_test([] {
+    // Arrange
+    const std::vector<point> points(65);
+    const hull::prepared_points<point> prepared(points);
+    const std::vector<std::uint64_t> mask(1);
+    
+    // Act
+    bool thrown{};
+    try {
+        prepared.hull_of(mask);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+});
+
+static auto test_prepared_points_sorted_mask = add_test([] {
+    // Arrange
+    // A sparse subset: most words of the sorted mask are zero.
+    std::vector<point> points;
+    for (int i{}; i < 1000; i++) {
+        points.push_back({{(i * 37) % 1000, (i * 91) % 1000}});
+    }
+    const hull::prepared_points<point> prepared(points);
+    std::vector<std::uint64_t> sorted_mask((points.size() + 63) / 64);
+    sorted_mask[3] = (std::uint64_t{1} << 5) | (std::uint64_t{1} << 60);
+    sorted_mask[12] = std::uint64_t{1} << 7;
+    sorted_mask.back() = ~std::uint64_t{}; // The bits past the last point are ignored.
+    std::vector<point> subset{prepared.sorted()[3 * 64 + 5], prepared.sorted()[3 * 64 + 60], prepared.sorted()[12 * 64 + 7]};
+    for (auto k = 64 * (sorted_mask.size() - 1); k < points.size(); k++) {
+        subset.push_back(prepared.sorted()[k]);
+    }
+    
+    // Act
+    const auto target = prepared.hull_of_sorted(sorted_mask);
+    
+    // Assert
+    assert(target == reference_hull(subset));
+});
@@ -0,0 +1,117 @@
+/**
+ * Unit tests for the convex hull queries over ranges of x-coordinates.
+ */
+
+#include "test_main.hpp"
+#include "../hull/monotone_chain.hpp"
+#include "../hull/range_hull.hpp"
+#include "reference_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * @return - the convex hull of the points within [x_min ; x_max], by brute force.
+ */
+static std::vector<point> brute_query(const std::vector<point>& points, int x_min, int x_max) {
+    std::vector<point> inside;
+    std::copy_if(std::begin(points), std::end(points), std::back_inserter(inside), [x_min, x_max](const point& p) {
+        return p[0] >= x_min && p[0] <= x_max;
+    });
+    return reference_hull(inside);
+}
+
+static auto test_range_hull = add_test([] {
+    // Arrange
+    const std::vector<point> points{{0, 0}, {1, 5}, {2, -3}, {3, 1}, {4, 4}, {5, 0}, {6, 7}};
+    
+    // Act
+    const hull::range_hull<point> index(points);
+    const auto all = index.query(0, 6);
+    const auto middle = index.query(1, 4);
+    const auto single = index.query(3, 3);
+    const auto none = index.query(7, 9);
+    const auto reversed = index.query(4, 1);
+    
+    // Assert
+    const std::vector<point> expected_all{{0, 0}, {2, -3}, {5, 0}, {6, 7}, {1, 5}};
+    const std::vector<point> expected_middle{{1, 5}, {2, -3}, {4, 4}};
+    const std::vector<point> expected_single{{3, 1}};
+    assert(index.size() == points.size());
+    assert(all == expected_all);
+    assert(middle == expected_middle);
+    assert(single == expected_single);
+    assert(none.empty());
+    assert(reversed.empty());
+});
+
+static auto test_range_hull_same_as_brute_force = add_test([] {
+    // Arrange
+    std::mt19937 generator(73);
+    
+    for (const std::size_t size: {0, 1, 31, 32, 33, 100, 5000}) {
+        for (const std::size_t threads: {1, 4}) {
+            std::uniform_int_distribution<int> abscissa(0, static_cast<int>(size / 2 + 1));
+            std::uniform_int_distribution<int> ordinate(-1000, 1000);
+            std::vector<point> points(size);
+            for (auto& p: points) {
+                p = {{abscissa(generator), ordinate(generator)}};
+            }
+            
+            // Act
+            const hull::range_hull<point> index(std::begin(points), std::end(points), threads);
+            
+            // Assert
+            for (int round{}; round < 50; round++) {
+                auto x_min = abscissa(generator);
+                auto x_max = abscissa(generator);
+                if (x_max < x_min) {
+                    std::swap(x_min, x_max);
+                }
+                const auto result = index.query(x_min, x_max);
+                assert(result == brute_query(points, x_min, x_max));
+            }
+        }
+    }
+});
+
+static auto test_range_hull_indices = add_test([] {
+    // Arrange
+    std::mt19937 generator(730);
+    std::uniform_real_distribution<double> distribution(-1000., 1000.);
+    std::vector<std::array<double, 2>> points(3000);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    const hull::range_hull<std::array<double, 2>> index(points);
+    std::uniform_int_distribution<std::size_t> indices(0, points.size());
+    
+    for (int round{}; round < 50; round++) {
+        auto begin = indices(generator);
+        auto end = indices(generator);
+        if (end < begin) {
+            std::swap(begin, end);
+        }
+        
+        // Act
+        const auto result = index.query_indices(begin, end);
+        
+        // Assert
+        std::vector<std::array<double, 2>> slice(std::begin(index.points()) + static_cast<std::ptrdiff_t>(begin),
+                                                 std::begin(index.points()) + static_cast<std::ptrdiff_t>(end));
+        std::vector<std::array<double, 2>> expected(2 * slice.size());
+        expected.erase(hull::algorithms::monotone_chain(std::begin(slice), std::end(slice), std::begin(expected)),
+                       std::end(expected));
+        if (end - begin >= 2) {
+            assert(result == expected);
+        }
+        else {
+            assert(result.size() == end - begin);
+        }
+    }
+});
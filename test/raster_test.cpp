@@ -0,0 +1,137 @@
+/**
+ * Unit tests for the convex hull of raster masks.
+ */
+
+#include "test_main.hpp"
+#include "../hull/raster.hpp"
+#include "reference_hull.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * Random mask, stored as a bitmap and as a list of runs.
+ */
+struct mask {
+    std::vector<std::uint64_t> words;
+    std::vector<hull::io::pixel_run> runs;
+    std::vector<point> pixels;
+    hull::io::bitmap_view view;
+};
+
+/**
+ * @param density - the probability of a pixel being set, in a blob centered on the mask.
+ * @return - a random mask, whose bits beyond the width are set as garbage.
+ */
+static mask make_mask(std::mt19937& generator, std::size_t width, std::size_t height, double density) {
+    mask m;
+    const auto stride = (width + 63) / 64 + 1;
+    m.words.assign(stride * height, 0);
+    std::bernoulli_distribution set(density);
+    for (std::size_t y{}; y < height; y++) {
+        for (std::size_t x{}; x < 64 * stride; x++) {
+            const auto dx = static_cast<double>(x) - width / 2.;
+            const auto dy = static_cast<double>(y) - height / 2.;
+            const auto inside = x < width && 4 * (dx * dx + dy * dy) < static_cast<double>(width * height);
+            if ((x >= width || inside) && set(generator)) {
+                m.words[y * stride + x / 64] |= std::uint64_t{1} << (x % 64);
+                if (x < width) {
+                    m.pixels.push_back({{static_cast<int>(x), static_cast<int>(y)}});
+                }
+            }
+        }
+        for (std::size_t x{}; x < width;) {
+            if (!(m.words[y * stride + x / 64] >> (x % 64) & 1)) {
+                x++;
+                continue;
+            }
+            auto end = x;
+            for (; end < width && (m.words[y * stride + end / 64] >> (end % 64) & 1); end++) {}
+            m.runs.push_back({y, x, end - x});
+            x = end;
+        }
+    }
+    m.view = {m.words.data(), width, height, stride};
+    return m;
+}
+
+static auto test_bitmap_convex_hull = add_test([] {
+    // Arrange
+    std::mt19937 generator(67);
+    const std::array<std::size_t, 6> widths{{1, 5, 63, 64, 65, 200}};
+    
+    for (const auto width: widths) {
+        for (const auto density: {.005, .1, .9}) {
+            auto m = make_mask(generator, width, 37, density);
+            
+            // Act
+            std::vector<point> target;
+            hull::io::bitmap_convex_hull<point>(m.view, std::back_inserter(target));
+            
+            // Assert
+            assert(target == reference_hull(m.pixels));
+        }
+    }
+});
+
+static auto test_rle_convex_hull = add_test([] {
+    // Arrange
+    std::mt19937 generator(670);
+    
+    for (auto trial = 0; trial < 20; trial++) {
+        auto m = make_mask(generator, 150, 80, trial % 2 == 0 ? .3 : .02);
+        
+        // Act
+        std::vector<point> target;
+        hull::io::rle_convex_hull<point>(std::begin(m.runs), std::end(m.runs), std::back_inserter(target));
+        
+        // Assert
+        assert(target == reference_hull(m.pixels));
+    }
+});
+
+static auto test_bitmap_convex_hull_degenerate = add_test([] {
+    // Arrange
+    const std::vector<std::uint64_t> empty(4, 0);
+    const std::vector<std::uint64_t> one{0, std::uint64_t{1} << 5, 0, 0};
+    const std::vector<std::uint64_t> column{1, 1, 1, 1};
+    const std::vector<point> expected_one{{{69, 0}}};
+    const std::vector<point> expected_column{{{0, 0}}, {{0, 3}}};
+    
+    // Act
+    std::vector<point> target_empty;
+    std::vector<point> target_one;
+    std::vector<point> target_column;
+    hull::io::bitmap_convex_hull<point>({empty.data(), 128, 2, 2}, std::back_inserter(target_empty));
+    hull::io::bitmap_convex_hull<point>({one.data(), 128, 2, 2}, std::back_inserter(target_one));
+    hull::io::bitmap_convex_hull<point>({column.data(), 10, 4, 1}, std::back_inserter(target_column));
+    
+    // Assert
+    assert(target_empty.empty());
+    assert(target_one == expected_one);
+    assert(target_column == expected_column);
+});
+
+static auto test_rle_convex_hull_unsorted = add_test([] {
+    // Arrange
+    const std::vector<hull::io::pixel_run> runs{{3, 0, 2}, {1, 4, 1}};
+    std::vector<point> target;
+    
+    // Act
+    bool thrown{};
+    try {
+        hull::io::rle_convex_hull<point>(std::begin(runs), std::end(runs), std::back_inserter(target));
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+});
@@ -0,0 +1,37 @@
+/**
+ * Reference convex hull shared by the unit tests of the structures built
+ * on Monotone Chain: the plain monotone_chain over a copy of the points,
+ * without any of the sorting, merging or streaming of the code under test.
+ */
+
+#ifndef reference_hull_h
+#define reference_hull_h
+
+#include "../hull/monotone_chain.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+/**
+ * @param points - the points, in any order, possibly repeated.
+ * @return - the convex hull of the points, in the same order as monotone_chain
+ *           (a single vertex if all the points are the same).
+ */
+template <typename TPoint>
+std::vector<TPoint> reference_hull(std::vector<TPoint> points) {
+    // Repeated points would be repeated on a degenerate hull.
+    std::sort(std::begin(points), std::end(points), [](const TPoint& p1, const TPoint& p2) {
+        return hull::x(p1) < hull::x(p2) || (hull::x(p1) == hull::x(p2) && hull::y(p1) < hull::y(p2));
+    });
+    points.erase(std::unique(std::begin(points), std::end(points), [](const TPoint& p1, const TPoint& p2) {
+        return hull::x(p1) == hull::x(p2) && hull::y(p1) == hull::y(p2);
+    }), std::end(points));
+    
+    std::vector<TPoint> convex_hull(2 * points.size());
+    convex_hull.erase(hull::algorithms::monotone_chain(std::begin(points), std::end(points), std::begin(convex_hull)),
+                      std::end(convex_hull));
+    return convex_hull;
+}
+
+#endif
@@ -0,0 +1,343 @@
+/**
+ * Unit tests for the convex hull service.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/service.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @return - a socket path unique to this process.
+ */
+static std::string temporary_socket_path() {
+    return "/tmp/hull_service_" + std::to_string(::getpid()) + ".sock";
+}
+
+/**
+ * @return - a socket connected to the server, to write raw messages.
+ */
+static int raw_connect(const std::string& path) {
+    const auto address = hull::service::details::socket_address(path);
+    const auto fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    [[maybe_unused]] const auto connected = ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    assert(connected == 0);
+    return fd;
+}
+
+/**
+ * Read a response header from a raw socket.
+ * @return - false at the end of the stream.
+ */
+static bool raw_read_header(int fd, std::uint32_t& id, std::uint8_t& status, std::uint32_t& count) {
+    unsigned char header[hull::service::details::header_size];
+    std::size_t size{};
+    while (size < sizeof(header)) {
+        const auto n = ::read(fd, header + size, sizeof(header) - size);
+        if (n <= 0) {
+            return false;
+        }
+        size += static_cast<std::size_t>(n);
+    }
+    id = hull::service::details::get_u32(header);
+    status = header[4];
+    count = hull::service::details::get_u32(header + 8);
+    return true;
+}
+
+/**
+ * Skip the body of a response from a raw socket.
+ */
+static void raw_skip(int fd, std::size_t size) {
+    unsigned char buffer[256];
+    while (size != 0) {
+        const auto n = ::read(fd, buffer, std::min(size, sizeof(buffer)));
+        assert(n > 0);
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+static auto test_service_round_trip = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    options.threads = 2;
+    hull::service::server server(options);
+    std::thread loop([&server] { server.run(); });
+    
+    std::mt19937 generator(8);
+    std::uniform_real_distribution<double> distribution(-10., 10.);
+    std::vector<std::array<double, 2>> points(500);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    std::vector<std::array<double, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    std::vector<std::array<double, 2>> target;
+    std::vector<std::array<double, 2>> target_chan;
+    
+    // Act
+    {
+        hull::service::client client(options.path);
+        client.compute(hull::choice::monotone_chain, points, target);
+        client.compute(hull::choice::chan, points, target_chan);
+    }
+    server.stop();
+    loop.join();
+    const auto stats = server.stats();
+    
+    // Assert
+    assert(target == expected);
+    assert(target_chan.size() == expected.size());
+    assert(stats.connections == 1);
+    assert(stats[hull::service::policy_code::monotone_chain].requests == 1);
+    assert(stats[hull::service::policy_code::monotone_chain].points_in == points.size());
+    assert(stats[hull::service::policy_code::monotone_chain].points_out == expected.size());
+    assert(stats[hull::service::policy_code::chan].requests == 1);
+});
+
+static auto test_service_batching = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    options.threads = 3;
+    options.parallel_threshold = 2;
+    hull::service::server server(options);
+    std::thread loop([&server] { server.run(); });
+    
+    const std::vector<std::array<int, 2>> square{{{0, 0}}, {{4, 0}}, {{2, 2}}, {{4, 4}}, {{0, 4}}};
+    const std::vector<std::array<int, 2>> expected{{{0, 0}}, {{4, 0}}, {{4, 4}}, {{0, 4}}};
+    const std::size_t N = 50;
+    std::vector<std::vector<std::array<int, 2>>> targets(N);
+    hull::service::server_stats stats;
+    
+    // Act
+    {
+        // Pipelined requests: they reach the server together
+        // and are coalesced into batches.
+        hull::service::client client(options.path);
+        for (std::size_t i{}; i < N; i++) {
+            client.send(hull::choice::monotone_chain, square);
+        }
+        for (std::size_t i{}; i < N; i++) {
+            const auto id = client.receive(targets[i]);
+            assert(id == i);
+        }
+        stats = client.stats();
+    }
+    server.stop();
+    loop.join();
+    
+    // Assert
+    for (const auto& target: targets) {
+        assert(target == expected);
+    }
+    assert(stats.batched_requests == N);
+    assert(stats.batches < N);
+    assert(stats[hull::service::policy_code::monotone_chain].requests == N);
+    assert(stats[hull::service::policy_code::monotone_chain].max_latency_ns > 0);
+});
+
+static auto test_service_ordered_responses = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    hull::service::server server(options);
+    std::thread loop([&server] { server.run(); });
+    
+    const std::vector<std::array<int, 2>> square{{{0, 0}}, {{4, 0}}, {{2, 2}}, {{4, 4}}, {{0, 4}}};
+    std::vector<unsigned char> message;
+    hull::service::details::put_header(message, 7, static_cast<std::uint8_t>(hull::service::policy_code::monotone_chain),
+                                       static_cast<std::uint32_t>(square.size()));
+    hull::service::details::put_points(message, std::begin(square), std::end(square));
+    hull::service::details::put_header(message, 8, hull::service::stats_request, 0);
+    
+    // Act
+    // Both requests in a single write, then the end of the stream: the
+    // stats are ready at once while the hull waits for its batch.
+    const auto fd = raw_connect(options.path);
+    [[maybe_unused]] const auto written = ::write(fd, message.data(), message.size());
+    ::shutdown(fd, SHUT_WR);
+    std::vector<std::uint32_t> ids;
+    std::vector<std::uint32_t> counts;
+    std::uint32_t id{};
+    std::uint8_t status{};
+    std::uint32_t count{};
+    while (raw_read_header(fd, id, status, count)) {
+        ids.push_back(id);
+        counts.push_back(count);
+        raw_skip(fd, count * (id == 7 ? hull::service::details::point_size : sizeof(std::uint64_t)));
+    }
+    ::close(fd);
+    server.stop();
+    loop.join();
+    
+    // Assert
+    const std::vector<std::uint32_t> expected_ids{7, 8};
+    assert(written == static_cast<ssize_t>(message.size()));
+    assert(ids == expected_ids);
+    assert(counts.front() == 4);
+});
+
+static auto test_service_half_closed = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    options.threads = 2;
+    options.parallel_threshold = 2;
+    hull::service::server server(options);
+    std::thread loop([&server] { server.run(); });
+    
+    const std::vector<std::array<int, 2>> square{{{0, 0}}, {{4, 0}}, {{2, 2}}, {{4, 4}}, {{0, 4}}};
+    std::vector<unsigned char> message;
+    const std::uint32_t N = 20;
+    for (std::uint32_t i{}; i < N; i++) {
+        hull::service::details::put_header(message, i, static_cast<std::uint8_t>(hull::service::policy_code::monotone_chain),
+                                           static_cast<std::uint32_t>(square.size()));
+        hull::service::details::put_points(message, std::begin(square), std::end(square));
+    }
+    
+    // Act
+    const auto fd = raw_connect(options.path);
+    [[maybe_unused]] const auto written = ::write(fd, message.data(), message.size());
+    ::shutdown(fd, SHUT_WR);
+    std::vector<std::uint32_t> ids;
+    std::uint32_t id{};
+    std::uint8_t status{};
+    std::uint32_t count{};
+    while (raw_read_header(fd, id, status, count)) {
+        assert(status == static_cast<std::uint8_t>(hull::service::status_code::ok));
+        ids.push_back(id);
+        raw_skip(fd, count * hull::service::details::point_size);
+    }
+    ::close(fd);
+    server.stop();
+    loop.join();
+    
+    // Assert
+    std::vector<std::uint32_t> expected_ids(N);
+    std::iota(std::begin(expected_ids), std::end(expected_ids), std::uint32_t{});
+    assert(written == static_cast<ssize_t>(message.size()));
+    assert(ids == expected_ids);
+});
+
+static auto test_service_too_many_points = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    options.max_points = 10;
+    hull::service::server server(options);
+    std::thread loop([&server] { server.run(); });
+    
+    std::vector<unsigned char> message;
+    hull::service::details::put_header(message, 3, hull::service::stats_request, 0);
+    hull::service::details::put_header(message, 4, static_cast<std::uint8_t>(hull::service::policy_code::monotone_chain), 11);
+    
+    // Act
+    const auto fd = raw_connect(options.path);
+    [[maybe_unused]] const auto written = ::write(fd, message.data(), message.size());
+    std::vector<std::uint32_t> ids;
+    std::vector<std::uint8_t> statuses;
+    std::uint32_t id{};
+    std::uint8_t status{};
+    std::uint32_t count{};
+    // The connection is closed by the server after the response.
+    while (raw_read_header(fd, id, status, count)) {
+        ids.push_back(id);
+        statuses.push_back(status);
+        raw_skip(fd, count * sizeof(std::uint64_t));
+    }
+    ::close(fd);
+    server.stop();
+    loop.join();
+    
+    // Assert
+    const std::vector<std::uint32_t> expected_ids{3, 4};
+    const std::vector<std::uint8_t> expected_statuses{static_cast<std::uint8_t>(hull::service::status_code::ok),
+                                                      static_cast<std::uint8_t>(hull::service::status_code::bad_request)};
+    assert(written == static_cast<ssize_t>(message.size()));
+    assert(ids == expected_ids);
+    assert(statuses == expected_statuses);
+});
+
+static auto test_service_keeps_a_regular_file = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    std::FILE* file = std::fopen(options.path.c_str(), "w");
+    assert(file != nullptr);
+    std::fclose(file);
+    auto thrown = false;
+    
+    // Act
+    try {
+        hull::service::server server(options);
+    }
+    catch (const std::system_error&) {
+        thrown = true;
+    }
+    struct stat status{};
+    const auto kept = ::lstat(options.path.c_str(), &status) == 0 && S_ISREG(status.st_mode);
+    std::remove(options.path.c_str());
+    
+    // Assert
+    assert(thrown);
+    assert(kept);
+});
+
+static auto test_service_keeps_a_live_server = add_test([] {
+    // Arrange
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    hull::service::server server(options);
+    auto thrown = false;
+    
+    // Act
+    try {
+        hull::service::server second(options);
+    }
+    catch (const std::system_error&) {
+        thrown = true;
+    }
+    // The first server still owns the socket.
+    const auto fd = raw_connect(options.path);
+    ::close(fd);
+    
+    // Assert
+    assert(thrown);
+});
+
+static auto test_service_replaces_a_stale_socket = add_test([] {
+    // Arrange
+    // A socket left behind by a server which did not exit cleanly.
+    hull::service::server_options options;
+    options.path = temporary_socket_path();
+    const auto address = hull::service::details::socket_address(options.path);
+    const auto stale = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    [[maybe_unused]] const auto bound = ::bind(stale, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    ::close(stale);
+    
+    // Act
+    hull::service::server server(options);
+    const auto fd = raw_connect(options.path);
+    ::close(fd);
+    
+    // Assert
+    assert(bound == 0);
+});
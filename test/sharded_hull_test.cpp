@@ -0,0 +1,73 @@
+/**
+ * Unit tests for the multi-process convex hull.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/sharded_hull.hpp"
+
+#include <array>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+static auto test_sharded_convex_hull = add_test([] {
+    // Arrange
+    std::mt19937 generator(99);
+    std::uniform_int_distribution<std::int32_t> distribution(-10000, 10000);
+    std::vector<std::array<std::int32_t, 2>> points(30000);
+    std::vector<unsigned char> bytes(points.size() * 2 * sizeof(std::int32_t));
+    for (std::size_t i{}; i < points.size(); i++) {
+        points[i] = {{distribution(generator), distribution(generator)}};
+        hull::io::details::store_little_endian(points[i][0], bytes.data() + 2 * i * sizeof(std::int32_t));
+        hull::io::details::store_little_endian(points[i][1], bytes.data() + (2 * i + 1) * sizeof(std::int32_t));
+    }
+    char path[] = "/tmp/hull_sharded_XXXXXX";
+    const auto fd = ::mkstemp(path);
+    assert(fd >= 0);
+    const auto written = ::write(fd, bytes.data(), bytes.size());
+    assert(written == static_cast<ssize_t>(bytes.size()));
+    ::close(fd);
+    
+    std::vector<std::array<std::int32_t, 2>> expected;
+    hull::convex::compute(hull::choice::monotone_chain, points, expected);
+    hull::io::shard_options options;
+    options.processes = 4;
+    hull::io::shard_stats stats;
+    std::vector<std::array<std::int32_t, 2>> target;
+    
+    // Act
+    hull::io::sharded_convex_hull<std::int32_t>(path, std::back_inserter(target), hull::choice::graham_scan,
+                                                options, &stats);
+    
+    // Assert
+    assert(target == expected);
+    assert(stats.processes == 4);
+    assert(stats.points == points.size());
+    assert(stats.partial_points >= expected.size());
+    
+    std::remove(path);
+});
+
+static auto test_partial_hull_message = add_test([] {
+    // Arrange
+    const std::vector<std::array<float, 2>> partial{{{1.f, 2.f}}, {{3.5f, -4.f}}, {{0.f, 7.25f}}};
+    int fds[2];
+    const auto piped = ::pipe(fds);
+    assert(piped == 0);
+    
+    // Act
+    const auto message = hull::io::details::sharded::encode<float>(partial);
+    hull::io::details::sharded::write_all(fds[1], message.data(), message.size());
+    ::close(fds[1]);
+    const auto target = hull::io::details::sharded::receive<float, std::array<float, 2>>(fds[0]);
+    ::close(fds[0]);
+    
+    // Assert
+    assert(message.size() == 8 + 3 * 2 * sizeof(float));
+    assert(target == partial);
+});
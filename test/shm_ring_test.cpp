@@ -0,0 +1,148 @@
+/**
+ * Unit tests for the shared-memory point ring and the running hull.
+ */
+
+#include "test_main.hpp"
+#include "../hull/algorithms.hpp"
+#include "../hull/running_hull.hpp"
+#include "../hull/shm_ring.hpp"
+
+#include <array>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+static std::string segment_name(const char* suffix) {
+    return "/hull_test_" + std::to_string(::getpid()) + "_" + suffix;
+}
+
+static auto test_running_hull = add_test([] {
+    // Arrange
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> distribution(-10000, 10000);
+    std::vector<std::array<int, 2>> points(20000);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    std::vector<std::array<int, 2>> expected(points.size());
+    expected.erase(hull::algorithms::monotone_chain(std::begin(points), std::end(points), std::begin(expected)), std::end(expected));
+    hull::algorithms::running_hull<std::array<int, 2>> running;
+    
+    // Act
+    auto changes = 0;
+    for (std::size_t i{}; i < points.size(); i += 1000) {
+        changes += running.add(std::begin(points) + i, std::begin(points) + i + 1000);
+    }
+    const auto unchanged = running.add(std::begin(points), std::begin(points) + 1000);
+    
+    // Assert
+    assert(running.hull() == expected);
+    assert(running.points() == points.size() + 1000);
+    assert(changes > 0);
+    assert(!unchanged);
+});
+
+static auto test_ring_feeds_published_hull = add_test([] {
+    // Arrange
+    const auto ring_name = segment_name("ring");
+    const auto hull_name = segment_name("hull");
+    std::mt19937 generator(12);
+    std::uniform_real_distribution<float> distribution(-1000.f, 1000.f);
+    std::vector<std::array<float, 2>> points(50000);
+    for (auto& p: points) {
+        p = {{distribution(generator), distribution(generator)}};
+    }
+    std::vector<std::array<float, 2>> expected(points.size());
+    expected.erase(hull::algorithms::monotone_chain(std::begin(points), std::end(points), std::begin(expected)), std::end(expected));
+    
+    auto producer = hull::io::point_ring_producer<float>::create(ring_name, 4, 777);
+    auto consumer = hull::io::point_ring_consumer<float>::open(ring_name);
+    auto publisher = hull::io::hull_publisher<float>::create(hull_name, 1024);
+    hull::io::hull_subscriber<float> subscriber(hull_name);
+    
+    // Act
+    std::thread feeder([&] {
+        producer.push(std::begin(points), std::end(points));
+        producer.close();
+    });
+    const auto convex_hull = hull::io::follow_ring(consumer, publisher);
+    feeder.join();
+    std::vector<std::array<float, 2>> published;
+    const auto version = subscriber.read(published);
+    
+    // Assert
+    assert(convex_hull == expected);
+    assert(published == expected);
+    assert(version > 0);
+    assert(version == subscriber.version());
+});
+
+static auto test_ring_zero_copy_batches = add_test([] {
+    // Arrange
+    const auto ring_name = segment_name("batches");
+    auto producer = hull::io::point_ring_producer<double>::create(ring_name, 2, 3);
+    auto consumer = hull::io::point_ring_consumer<double>::open(ring_name);
+    hull::io::point_batch<double> batch;
+    
+    // Act
+    const auto empty = !consumer.try_peek(batch);
+    auto slot = producer.acquire();
+    slot[0] = {{1., 2.}};
+    slot[1] = {{3., 4.}};
+    producer.commit(2);
+    const auto peeked = consumer.try_peek(batch);
+    const auto first = batch.first[0];
+    const auto size = batch.size();
+    consumer.release();
+    producer.close();
+    const auto drained = !consumer.peek(batch);
+    
+    // Assert
+    assert(empty);
+    assert(peeked);
+    assert(size == 2);
+    assert((first == std::array<double, 2>{{1., 2.}}));
+    assert(drained);
+});
+
+static auto test_publisher_capacity = add_test([] {
+    // Arrange
+    const auto hull_name = segment_name("capacity");
+    auto publisher = hull::io::hull_publisher<int>::create(hull_name, 2);
+    const std::vector<std::array<int, 2>> triangle{{{0, 0}}, {{1, 0}}, {{0, 1}}};
+    
+    // Act
+    auto thrown = false;
+    try {
+        publisher.publish(std::begin(triangle), std::end(triangle));
+    }
+    catch (const std::length_error&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+});
+
+static auto test_open_wrong_segment = add_test([] {
+    // Arrange
+    const auto ring_name = segment_name("wrong");
+    auto producer = hull::io::point_ring_producer<float>::create(ring_name, 2, 8);
+    
+    // Act
+    auto thrown = false;
+    try {
+        hull::io::point_ring_consumer<double>::open(ring_name);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    
+    // Assert
+    assert(thrown);
+});
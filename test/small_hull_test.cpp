@@ -0,0 +1,101 @@
+/**
+ * Unit tests for the fixed-size kernels of Monotone Chain.
+ */
+
+#include "test_main.hpp"
+#include "../hull/monotone_chain.hpp"
+#include "../hull/small_hull.hpp"
+
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+/**
+ * @return - the convex hull of the points with the generic Monotone Chain.
+ */
+template <typename TPoint>
+static std::vector<TPoint> generic_hull(std::vector<TPoint> points) {
+    std::vector<TPoint> convex_hull(2 * points.size());
+    convex_hull.erase(hull::algorithms::details::monotone_chain_impl(std::begin(points), std::end(points), std::begin(convex_hull)),
+                      std::end(convex_hull));
+    return convex_hull;
+}
+
+/**
+ * @return - the convex hull of the points with the fixed-size kernels.
+ */
+template <typename TPoint>
+static std::vector<TPoint> small_hull(const std::vector<TPoint>& points) {
+    std::vector<TPoint> convex_hull(2 * points.size());
+    convex_hull.erase(hull::algorithms::details::small::small_hull(std::begin(points), std::end(points), std::begin(convex_hull)),
+                      std::end(convex_hull));
+    return convex_hull;
+}
+
+static auto test_small_hull_every_size = add_test([] {
+    // Arrange
+    // A small grid gives many duplicate and collinear points.
+    std::mt19937 generator(41);
+    std::uniform_int_distribution<int> grid(0, 4);
+    std::uniform_int_distribution<int> wide(-1000, 1000);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    
+    for (std::size_t n{2}; n <= hull::algorithms::details::small::max_size; n++) {
+        for (auto trial = 0; trial < 200; trial++) {
+            std::vector<std::array<int, 2>> points(n);
+            for (auto& p: points) {
+                p = {{grid(generator), grid(generator)}};
+            }
+            // Products of short coordinates need the promoted type.
+            std::vector<std::array<short, 2>> short_points(n);
+            for (auto& p: short_points) {
+                p = {{static_cast<short>(wide(generator)), static_cast<short>(wide(generator))}};
+            }
+            std::vector<std::array<double, 2>> real_points(n);
+            for (auto& p: real_points) {
+                p = {{distribution(generator), distribution(generator)}};
+            }
+            
+            // Act
+            const auto target = small_hull(points);
+            const auto short_target = small_hull(short_points);
+            const auto real_target = small_hull(real_points);
+            
+            // Assert
+            assert(target == generic_hull(points));
+            assert(short_target == generic_hull(short_points));
+            assert(real_target == generic_hull(real_points));
+        }
+    }
+});
+
+static auto test_small_hull_degenerate = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> same{{{3, 3}}, {{3, 3}}, {{3, 3}}};
+    const std::vector<std::array<int, 2>> collinear{{{0, 0}}, {{2, 2}}, {{1, 1}}, {{3, 3}}};
+    const std::vector<std::array<int, 2>> expected_collinear{{{0, 0}}, {{3, 3}}};
+    
+    // Act
+    const auto target_same = small_hull(same);
+    const auto target_collinear = small_hull(collinear);
+    
+    // Assert
+    assert(target_same == generic_hull(same));
+    assert(target_collinear == expected_collinear);
+});
+
+static auto test_monotone_chain_keeps_small_input = add_test([] {
+    // Arrange
+    const std::vector<std::array<int, 2>> input{{{4, 4}}, {{0, 0}}, {{4, 0}}, {{2, 1}}, {{0, 4}}};
+    auto points = input;
+    std::vector<std::array<int, 2>> target(2 * points.size());
+    const std::vector<std::array<int, 2>> expected{{{0, 0}}, {{4, 0}}, {{4, 4}}, {{0, 4}}};
+    
+    // Act
+    target.erase(hull::algorithms::monotone_chain(std::begin(points), std::end(points), std::begin(target)), std::end(target));
+    
+    // Assert
+    assert(target == expected);
+    assert(points == input);
+});
@@ -0,0 +1,137 @@
+/**
+ * Unit tests for the convex hull of a soup of objects.
+ */
+
+#include "test_main.hpp"
+#include "../hull/soup_hull.hpp"
+#include "reference_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+/**
+ * @return - the convex hull of all the vertices, flattened.
+ */
+template <typename TObjects>
+static std::vector<point> flat_hull(const TObjects& objects) {
+    std::vector<point> points;
+    for (const auto& object: objects) {
+        points.insert(std::end(points), std::begin(object), std::end(object));
+    }
+    return reference_hull(points);
+}
+
+/**
+ * @return - random objects: blobs of random size and position.
+ */
+static std::vector<std::vector<point>> make_soup(std::mt19937& generator, std::size_t objects) {
+    std::uniform_int_distribution<int> center(-5000, 5000);
+    std::uniform_int_distribution<std::size_t> sizes(0, 300);
+    std::uniform_real_distribution<double> radius(1., 400.);
+    std::uniform_real_distribution<double> angle(0., 2. * 3.14159265358979);
+    
+    std::vector<std::vector<point>> soup(objects);
+    for (auto& object: soup) {
+        const auto cx = center(generator);
+        const auto cy = center(generator);
+        const auto n = sizes(generator);
+        for (std::size_t i{}; i < n; i++) {
+            const auto r = radius(generator);
+            const auto a = angle(generator);
+            object.push_back({{cx + static_cast<int>(r * std::cos(a)), cy + static_cast<int>(r * std::sin(a))}});
+        }
+    }
+    return soup;
+}
+
+static auto test_soup_convex_hull = add_test([] {
+    // Arrange
+    std::mt19937 generator(68);
+    
+    for (const std::size_t threads: {1, 3}) {
+        for (const std::size_t objects: {1, 2, 5, 400}) {
+            const auto soup = make_soup(generator, objects);
+            const auto expected = flat_hull(soup);
+            
+            // Act
+            hull::algorithms::soup_stats stats;
+            const auto target = hull::algorithms::soup_convex_hull(soup, {threads, false}, &stats);
+            
+            // Assert
+            assert(target == expected);
+            assert(stats.objects == objects);
+        }
+    }
+});
+
+static auto test_soup_convex_hull_culls_inner_objects = add_test([] {
+    // Arrange
+    // A large frame around many small objects.
+    std::mt19937 generator(680);
+    auto soup = make_soup(generator, 300);
+    soup.push_back({{{-8000, -8000}}, {{8000, -8000}}, {{8000, 8000}}, {{-8000, 8000}}});
+    
+    // Act
+    hull::algorithms::soup_stats stats;
+    const auto target = hull::algorithms::soup_convex_hull(soup, {2, false}, &stats);
+    
+    // Assert
+    const auto empty = static_cast<std::size_t>(std::count_if(std::begin(soup), std::end(soup), [](const auto& object) {
+        return object.empty();
+    }));
+    assert(target == flat_hull(soup));
+    assert(stats.culled == 300 - empty);
+});
+
+static auto test_soup_convex_hull_of_convex_objects = add_test([] {
+    // Arrange
+    // The objects are given by their hulls, clockwise.
+    std::mt19937 generator(681);
+    auto soup = make_soup(generator, 200);
+    for (auto& object: soup) {
+        object = flat_hull(std::vector<std::vector<point>>{object});
+        std::reverse(std::begin(object), std::end(object));
+    }
+    
+    // Act
+    const auto target = hull::algorithms::soup_convex_hull(soup, {2, true});
+    
+    // Assert
+    assert(target == flat_hull(soup));
+});
+
+static auto test_soup_convex_hull_of_segments = add_test([] {
+    // Arrange
+    const std::list<std::vector<point>> segments{
+        {{{0, 0}}, {{10, 0}}},
+        {},
+        {{{2, 1}}, {{3, 2}}},
+        {{{5, -4}}, {{5, 6}}},
+        {{{7, 7}}}
+    };
+    const std::vector<point> expected{{{0, 0}}, {{5, -4}}, {{10, 0}}, {{7, 7}}, {{5, 6}}};
+    
+    // Act
+    const auto target = hull::algorithms::soup_convex_hull(std::begin(segments), std::end(segments));
+    
+    // Assert
+    assert(target == expected);
+});
+
+static auto test_soup_convex_hull_empty = add_test([] {
+    // Arrange
+    const std::vector<std::vector<point>> soup(3);
+    
+    // Act
+    const auto target = hull::algorithms::soup_convex_hull(soup);
+    
+    // Assert
+    assert(target.empty());
+});
@@ -0,0 +1,96 @@
+/**
+ * Unit tests for the compile-time convex hull.
+ */
+
+#include "test_main.hpp"
+#include "point2d.hpp"
+#include "../hull/angle.hpp"
+#include "../hull/monotone_chain.hpp"
+#include "../hull/static_hull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using point = std::array<int, 2>;
+
+// The predicates are usable in constant expressions.
+static_assert(hull::cross(point{{0, 0}}, point{{1, 0}}, point{{0, 1}}) == 1);
+static_assert(hull::compare_angles(point{{1, 1}}, point{{-1, 1}}));
+static_assert(hull::equals(hull::operator-(point{{2, 3}}, point{{1, 1}}), point{{1, 2}}));
+static_assert(hull::square_norm(point2d{3, 4}) == 25);
+
+// A square with inner, duplicate and collinear points.
+constexpr std::array<point, 8> square{{
+    {{2, 1}}, {{0, 0}}, {{4, 4}}, {{2, 0}}, {{4, 0}}, {{0, 4}}, {{4, 0}}, {{1, 3}}
+}};
+constexpr auto square_hull = hull::static_hull(square);
+static_assert(square_hull.size == 4);
+static_assert(hull::equals(square_hull[0], point{{0, 0}}));
+static_assert(hull::equals(square_hull[1], point{{4, 0}}));
+static_assert(hull::equals(square_hull[2], point{{4, 4}}));
+static_assert(hull::equals(square_hull[3], point{{0, 4}}));
+
+// Points with x and y data members.
+constexpr std::array<point2d, 4> triangle{{{0, 0}, {6, 0}, {3, 1}, {0, 6}}};
+constexpr auto triangle_hull = hull::static_hull(triangle);
+static_assert(triangle_hull.size == 3);
+static_assert(hull::equals(triangle_hull[2], point2d{0, 6}));
+
+// Degenerate inputs.
+static_assert(hull::static_hull(std::array<point, 0>{}).size == 0);
+static_assert(hull::static_hull(std::array<point, 1>{{{{5, 5}}}}).size == 1);
+
+/**
+ * @return - the convex hull of the points with monotone_chain.
+ */
+template <typename TPoint, std::size_t N>
+static std::vector<TPoint> dynamic_hull(const std::array<TPoint, N>& points) {
+    std::vector<TPoint> input(std::begin(points), std::end(points));
+    std::vector<TPoint> convex_hull(2 * N);
+    convex_hull.erase(hull::algorithms::monotone_chain(std::begin(input), std::end(input), std::begin(convex_hull)),
+                      std::end(convex_hull));
+    return convex_hull;
+}
+
+static auto test_static_hull_at_compile_time = add_test([] {
+    // Arrange
+    const std::vector<point> expected = dynamic_hull(square);
+    
+    // Act
+    const std::vector<point> target(std::begin(square_hull), std::end(square_hull));
+    
+    // Assert
+    assert(target == expected);
+});
+
+static auto test_static_hull_same_as_monotone_chain = add_test([] {
+    // Arrange
+    // A small grid gives many duplicate and collinear points.
+    std::mt19937 generator(65);
+    std::uniform_int_distribution<int> grid(0, 5);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    
+    for (auto trial = 0; trial < 500; trial++) {
+        std::array<point, 24> points{};
+        for (auto& p: points) {
+            p = {{grid(generator), grid(generator)}};
+        }
+        std::array<std::array<double, 2>, 24> real_points{};
+        for (auto& p: real_points) {
+            p = {{distribution(generator), distribution(generator)}};
+        }
+        
+        // Act
+        const auto target = hull::static_hull(points);
+        const auto real_target = hull::static_hull(real_points);
+        
+        // Assert
+        const std::vector<point> convex_hull(std::begin(target), std::end(target));
+        const std::vector<std::array<double, 2>> real_convex_hull(std::begin(real_target), std::end(real_target));
+        assert(convex_hull == dynamic_hull(points));
+        assert(real_convex_hull == dynamic_hull(real_points));
+    }
+});
@@ -0,0 +1,148 @@
+/**
+ * Unit tests for the parallel text parser.
+ */
+
+#include "test_main.hpp"
+#include "../hull/text_parser.hpp"
+#include "point2d.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+static auto test_parse_points = add_test([] {
+    // Arrange
+    const std::string text = "13,5\n12, 8\n  10 3\n7;7\r\n+9,-6\n";
+    const auto expected = std::array<point2d, 5>{{
+        {13, 5}, {12, 8}, {10, 3}, {7, 7}, {9, -6}
+    }};
+    std::vector<point2d> points;
+    
+    // Act
+    const auto report = hull::io::parse_points(text.data(), text.data() + text.size(), points);
+    
+    // Assert
+    assert(report.ok());
+    assert(report.points == expected.size());
+    assert(report.lines == 5);
+    assert(std::equal(std::begin(points), std::end(points), std::begin(expected), std::end(expected)));
+});
+
+static auto test_parse_points_reports_malformed_lines = add_test([] {
+    // Arrange
+    const std::string text = "x,y\n1,2\n\n# comment\n3,oops\n4,5\n6\n7 8 9\n10,11";
+    const auto expected = std::array<point2d, 3>{{
+        {1, 2}, {4, 5}, {10, 11}
+    }};
+    std::vector<point2d> points;
+    
+    // Act
+    const auto report = hull::io::parse_points(text.data(), text.data() + text.size(), points);
+    
+    // Assert
+    assert(!report.ok());
+    assert(report.malformed == 4);
+    assert(report.lines == 9);
+    assert(report.errors.size() == 4);
+    assert(report.errors[0].line == 1 && report.errors[0].offset == 0);
+    assert(report.errors[1].line == 5);
+    assert(report.errors[2].line == 7);
+    assert(report.errors[3].line == 8);
+    assert(std::equal(std::begin(points), std::end(points), std::begin(expected), std::end(expected)));
+});
+
+static auto test_parse_points_rejects_non_finite_coordinates = add_test([] {
+    // Arrange
+    const std::string text = "nan,0\n0,0\n1,inf\n-infinity 2\n1,0\n+nan;3\n0,1\n";
+    const auto expected = std::array<std::array<double, 2>, 3>{{
+        {{0., 0.}}, {{1., 0.}}, {{0., 1.}}
+    }};
+    std::vector<std::array<double, 2>> points;
+    
+    // Act
+    const auto report = hull::io::parse_points(text.data(), text.data() + text.size(), points);
+    
+    // Assert
+    assert(report.malformed == 4);
+    assert(report.errors[0].line == 1);
+    assert(report.errors[1].line == 3);
+    assert(report.errors[2].line == 4);
+    assert(report.errors[3].line == 6);
+    assert(std::equal(std::begin(points), std::end(points), std::begin(expected), std::end(expected)));
+});
+
+static auto test_parse_points_appends_to_destination = add_test([] {
+    // Arrange
+    const std::string text = "3,4\n";
+    std::vector<point2d> points{{1, 2}};
+    
+    // Act
+    hull::io::parse_points(text.data(), text.data() + text.size(), points);
+    
+    // Assert
+    assert(points.size() == 2);
+    assert(points[0] == (point2d{1, 2}));
+    assert(points[1] == (point2d{3, 4}));
+});
+
+static auto test_parse_points_in_parallel = add_test([] {
+    // Arrange
+    std::string text;
+    std::vector<point2d> expected;
+    for (int i{}; i < 20000; i++) {
+        if (i % 997 == 0) {
+            text += "malformed\n";
+        }
+        else {
+            text += std::to_string(i) + "," + std::to_string(-i) + "\n";
+            expected.push_back({i, -i});
+        }
+    }
+    hull::io::parse_options options;
+    options.threads = 7;
+    options.min_chunk_size = 1000;
+    options.max_errors = 3;
+    std::vector<point2d> points;
+    
+    // Act
+    const auto report = hull::io::parse_points(text.data(), text.data() + text.size(), points, options);
+    
+    // Assert
+    assert(report.malformed == 21);
+    assert(report.errors.size() == 3);
+    assert(report.errors[1].line == 998);
+    assert(points == expected);
+});
+
+static auto test_parse_points_structure_of_arrays = add_test([] {
+    // Arrange
+    const std::string text = "1.5,2.25\nbad\n-3e2 4\n";
+    std::vector<double> xs;
+    std::vector<double> ys;
+    hull::io::parse_options options;
+    options.threads = 2;
+    options.min_chunk_size = 1;
+    
+    // Act
+    const auto report = hull::io::parse_points(text.data(), text.data() + text.size(), xs, ys, options);
+    
+    // Assert
+    assert(report.malformed == 1);
+    assert(report.errors[0].line == 2);
+    assert((xs == std::vector<double>{1.5, -300.}));
+    assert((ys == std::vector<double>{2.25, 4.}));
+});
+
+static auto test_parse_points_empty_buffer = add_test([] {
+    // Arrange
+    const std::string text;
+    std::vector<point2d> points;
+    
+    // Act
+    const auto report = hull::io::parse_points(text.data(), text.data(), points);
+    
+    // Assert
+    assert(report.ok());
+    assert(report.lines == 0);
+    assert(points.empty());
+});
@@ -0,0 +1,64 @@
+/**
+ * Unit tests for the WKT output.
+ */
+
+#include "test_main.hpp"
+#include "../hull/wkt.hpp"
+#include "point2d.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @return - the WKT of the given hull.
+ */
+static std::string to_wkt(const std::vector<point2d>& convex_hull) {
+    std::ostringstream out;
+    hull::io::write_wkt(out, std::begin(convex_hull), std::end(convex_hull));
+    return out.str();
+}
+
+static auto test_write_wkt_polygon = add_test([] {
+    // Arrange
+    const std::vector<point2d> convex_hull{{0, 0}, {4, 0}, {4, 3}, {0, 3}};
+    
+    // Act
+    const auto target = to_wkt(convex_hull);
+    
+    // Assert
+    assert(target == "POLYGON((0 0, 4 0, 4 3, 0 3, 0 0))\n");
+});
+
+static auto test_write_wkt_empty = add_test([] {
+    // Arrange
+    const std::vector<point2d> convex_hull;
+    
+    // Act
+    const auto target = to_wkt(convex_hull);
+    
+    // Assert
+    assert(target == "POLYGON EMPTY\n");
+});
+
+static auto test_write_wkt_point = add_test([] {
+    // Arrange
+    const std::vector<point2d> convex_hull{{1, 2}};
+    
+    // Act
+    const auto target = to_wkt(convex_hull);
+    
+    // Assert
+    assert(target == "POINT(1 2)\n");
+});
+
+static auto test_write_wkt_segment = add_test([] {
+    // Arrange
+    const std::vector<point2d> convex_hull{{0, 0}, {1, 1}};
+    
+    // Act
+    const auto target = to_wkt(convex_hull);
+    
+    // Assert
+    assert(target == "LINESTRING(0 0, 1 1)\n");
+});